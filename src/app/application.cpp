@@ -1289,8 +1289,8 @@ void Application::cleanup()
     Utils::Fs::removeDirRecursively(Utils::Fs::tempPath());
 
     LogMsg(tr("qBittorrent is now ready to exit"));
-    Logger::freeInstance();
     delete m_fileLogger;
+    Logger::freeInstance();
 
 #ifndef DISABLE_GUI
     if (m_window)
@@ -28,49 +28,99 @@
 
 #include "filelogger.h"
 
+#include <algorithm>
 #include <chrono>
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QDir>
-#include <QTextStream>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
 #include <QVector>
 
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/utils/fs.h"
+#include "base/utils/gzip.h"
 
 namespace
 {
     const std::chrono::seconds FLUSH_INTERVAL {2};
+    const int WRITE_BUFFER_SIZE = 64 * 1024;
+    const QString BACKUP_SUFFIX = u".bak"_s;
+    const QString COMPRESSED_SUFFIX = u".gz"_s;
+    // line endings are written explicitly (instead of using text mode) so the size of written data is known
+#ifdef Q_OS_WIN
+    const QByteArray LINE_END = QByteArrayLiteral("\r\n");
+#else
+    const QByteArray LINE_END = QByteArrayLiteral("\n");
+#endif
+
+    QByteArray typePrefix(const Log::MsgType type)
+    {
+        switch (type)
+        {
+        case Log::INFO:
+            return QByteArrayLiteral("(I) ");
+        case Log::WARNING:
+            return QByteArrayLiteral("(W) ");
+        case Log::CRITICAL:
+            return QByteArrayLiteral("(C) ");
+        default:
+            return QByteArrayLiteral("(N) ");
+        }
+    }
 }
 
-FileLogger::FileLogger(const Path &path, const bool backup
-                       , const int maxSize, const bool deleteOld, const int age
-                       , const FileLogAgeType ageType)
-    : m_backup(backup)
-    , m_maxSize(maxSize)
+class FileLogger::Worker final : public QObject
 {
-    m_flusher.setInterval(FLUSH_INTERVAL);
-    m_flusher.setSingleShot(true);
-    connect(&m_flusher, &QTimer::timeout, this, &FileLogger::flushLog);
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(Worker)
 
-    changePath(path);
-    if (deleteOld)
-        this->deleteOld(age, ageType);
+public:
+    Worker(bool backup, int maxSize);
 
-    const Logger *const logger = Logger::instance();
-    for (const Log::Msg &msg : asConst(logger->getMessages()))
-        addLogMessage(msg);
+    void changePath(const Path &newPath);
+    void deleteOld(int age, FileLogAgeType ageType);
+    void setBackup(bool value);
+    void setMaxSize(int value);
+    void addLogMessages(const QVector<Log::Msg> &messages);
+    void closeLogFile();
 
-    connect(logger, &Logger::newLogMessage, this, &FileLogger::addLogMessage);
-}
+private:
+    void openLogFile();
+    void writeBuffer();
+    void rotateLogFile();
+    void compressBackup(const Path &path);
 
-FileLogger::~FileLogger()
+    Path m_path;
+    bool m_backup;
+    qint64 m_maxSize;
+    QFile m_logFile;
+    qint64 m_logFileSize = 0;
+    QByteArray m_buffer;
+    QTimer *m_flushTimer = nullptr;
+    int m_lastBackupNumber = 0;
+
+    // a lot of messages are logged within the same second
+    qint64 m_lastTimestamp = -1;
+    QByteArray m_lastTimestampText;
+};
+
+FileLogger::Worker::Worker(const bool backup, const int maxSize)
+    : m_backup {backup}
+    , m_maxSize {maxSize}
+    , m_flushTimer {new QTimer(this)}
 {
-    closeLogFile();
+    m_flushTimer->setInterval(FLUSH_INTERVAL);
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &Worker::writeBuffer);
 }
 
-void FileLogger::changePath(const Path &newPath)
+void FileLogger::Worker::changePath(const Path &newPath)
 {
     // compare paths as strings to perform case sensitive comparison on all the platforms
     if (newPath.data() == m_path.parentPath().data())
@@ -81,11 +131,22 @@ void FileLogger::changePath(const Path &newPath)
     m_path = newPath / Path(u"qbittorrent.log"_s);
     m_logFile.setFileName(m_path.data());
 
+    // Existing backups are looked up only once, then new ones are numbered sequentially
+    m_lastBackupNumber = 0;
+    const QRegularExpression backupNumberRegex {u"^qbittorrent\\.log\\.bak(\\d*)(?:\\.gz)?$"_s};
+    const QStringList backupNames = QDir(newPath.data()).entryList({u"qbittorrent.log.bak*"_s}, QDir::Files);
+    for (const QString &backupName : backupNames)
+    {
+        const QRegularExpressionMatch match = backupNumberRegex.match(backupName);
+        if (match.hasMatch())
+            m_lastBackupNumber = std::max(m_lastBackupNumber, match.capturedView(1).toInt());
+    }
+
     Utils::Fs::mkpath(newPath);
     openLogFile();
 }
 
-void FileLogger::deleteOld(const int age, const FileLogAgeType ageType)
+void FileLogger::Worker::deleteOld(const int age, const FileLogAgeType ageType)
 {
     const QDateTime date = QDateTime::currentDateTime();
     const QDir dir {m_path.parentPath().data()};
@@ -112,79 +173,168 @@ void FileLogger::deleteOld(const int age, const FileLogAgeType ageType)
     }
 }
 
-void FileLogger::setBackup(const bool value)
+void FileLogger::Worker::setBackup(const bool value)
 {
     m_backup = value;
 }
 
-void FileLogger::setMaxSize(const int value)
+void FileLogger::Worker::setMaxSize(const int value)
 {
     m_maxSize = value;
 }
 
-void FileLogger::addLogMessage(const Log::Msg &msg)
+void FileLogger::Worker::addLogMessages(const QVector<Log::Msg> &messages)
 {
-    if (!m_logFile.isOpen()) return;
-
-    QTextStream stream(&m_logFile);
-
-    switch (msg.type)
-    {
-    case Log::INFO:
-        stream << QStringView(u"(I) ");
-        break;
-    case Log::WARNING:
-        stream << QStringView(u"(W) ");
-        break;
-    case Log::CRITICAL:
-        stream << QStringView(u"(C) ");
-        break;
-    default:
-        stream << QStringView(u"(N) ");
-    }
-
-    stream << QDateTime::fromSecsSinceEpoch(msg.timestamp).toString(Qt::ISODate) << QStringView(u" - ") << msg.message << QChar(u'\n');
+    if (!m_logFile.isOpen())
+        return;
 
-    if (m_backup && (m_logFile.size() >= m_maxSize))
+    for (const Log::Msg &msg : messages)
     {
-        closeLogFile();
-        int counter = 0;
-        Path backupLogFilename = m_path + u".bak";
-
-        while (backupLogFilename.exists())
+        if (msg.timestamp != m_lastTimestamp)
         {
-            ++counter;
-            backupLogFilename = m_path + u".bak" + QString::number(counter);
+            m_lastTimestamp = msg.timestamp;
+            m_lastTimestampText = QDateTime::fromSecsSinceEpoch(msg.timestamp).toString(Qt::ISODate).toLatin1();
         }
 
-        Utils::Fs::renameFile(m_path, backupLogFilename);
-        openLogFile();
+        m_buffer += typePrefix(msg.type);
+        m_buffer += m_lastTimestampText;
+        m_buffer += " - ";
+        m_buffer += msg.message.toUtf8();
+        m_buffer += LINE_END;
+    }
+
+    if ((m_buffer.size() >= WRITE_BUFFER_SIZE)
+        || (m_backup && ((m_logFileSize + m_buffer.size()) >= m_maxSize)))
+    {
+        writeBuffer();
     }
-    else
+    else if (!m_flushTimer->isActive())
     {
-        if (!m_flusher.isActive())
-            m_flusher.start();
+        m_flushTimer->start();
     }
 }
 
-void FileLogger::flushLog()
+void FileLogger::Worker::writeBuffer()
 {
-    if (m_logFile.isOpen())
+    m_flushTimer->stop();
+
+    if (!m_buffer.isEmpty() && m_logFile.isOpen())
+    {
+        m_logFile.write(m_buffer);
         m_logFile.flush();
+        m_logFileSize += m_buffer.size();
+    }
+    m_buffer.clear();
+
+    if (m_backup && m_logFile.isOpen() && (m_logFileSize >= m_maxSize))
+        rotateLogFile();
+}
+
+void FileLogger::Worker::rotateLogFile()
+{
+    m_logFile.close();
+
+    const Path backupPath = m_path + BACKUP_SUFFIX + QString::number(++m_lastBackupNumber);
+    const bool isRenamed = Utils::Fs::renameFile(m_path, backupPath);
+    openLogFile();
+
+    if (isRenamed)
+        compressBackup(backupPath);
+}
+
+void FileLogger::Worker::compressBackup(const Path &path)
+{
+    // the backup is compressed chunk by chunk, so it isn't loaded into memory as a whole
+    QFile backupFile {path.data()};
+    if (!backupFile.open(QIODevice::ReadOnly))
+        return;
+
+    QSaveFile compressedFile {(path + COMPRESSED_SUFFIX).data()};
+    if (!compressedFile.open(QIODevice::WriteOnly))
+        return;
+
+    if (Utils::Gzip::compress(backupFile, compressedFile) && compressedFile.commit())
+    {
+        backupFile.close();
+        Utils::Fs::removeFile(path);
+    }
 }
 
-void FileLogger::openLogFile()
+void FileLogger::Worker::openLogFile()
 {
-    if (!m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)
+    if (!m_logFile.open(QIODevice::WriteOnly | QIODevice::Append)
         || !m_logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner))
     {
         m_logFile.close();
-        LogMsg(tr("An error occurred while trying to open the log file. Logging to file is disabled."), Log::CRITICAL);
+        LogMsg(FileLogger::tr("An error occurred while trying to open the log file. Logging to file is disabled."), Log::CRITICAL);
+        return;
     }
+
+    m_logFileSize = m_logFile.size();
 }
 
-void FileLogger::closeLogFile()
+void FileLogger::Worker::closeLogFile()
 {
-    m_flusher.stop();
+    writeBuffer();
     m_logFile.close();
 }
+
+FileLogger::FileLogger(const Path &path, const bool backup
+                       , const int maxSize, const bool deleteOld, const int age
+                       , const FileLogAgeType ageType)
+    : m_ioThread {new QThread}
+    , m_worker {new Worker(backup, maxSize)}
+{
+    m_worker->moveToThread(m_ioThread.get());
+    m_ioThread->start();
+
+    changePath(path);
+    if (deleteOld)
+        this->deleteOld(age, ageType);
+
+    addNewLogMessages();
+    connect(Logger::instance(), &Logger::newLogMessages, this, &FileLogger::addNewLogMessages);
+}
+
+FileLogger::~FileLogger()
+{
+    // the messages added right before exit could be not reported yet
+    addNewLogMessages();
+    // all the messages queued before are written at this point
+    QMetaObject::invokeMethod(m_worker, &Worker::closeLogFile, Qt::BlockingQueuedConnection);
+
+    m_ioThread.reset();
+    delete m_worker;
+}
+
+void FileLogger::changePath(const Path &newPath)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, newPath] { worker->changePath(newPath); });
+}
+
+void FileLogger::deleteOld(const int age, const FileLogAgeType ageType)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, age, ageType] { worker->deleteOld(age, ageType); });
+}
+
+void FileLogger::setBackup(const bool value)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, value] { worker->setBackup(value); });
+}
+
+void FileLogger::setMaxSize(const int value)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, value] { worker->setMaxSize(value); });
+}
+
+void FileLogger::addNewLogMessages()
+{
+    const QVector<Log::Msg> messages = Logger::instance()->getMessages(m_lastMessageId);
+    if (messages.isEmpty())
+        return;
+
+    m_lastMessageId = messages.last().id;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, messages] { worker->addLogMessages(messages); });
+}
+
+#include "filelogger.moc"
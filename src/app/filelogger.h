@@ -28,16 +28,10 @@
 
 #pragma once
 
-#include <QFile>
 #include <QObject>
-#include <QTimer>
 
 #include "base/path.h"
-
-namespace Log
-{
-    struct Msg;
-}
+#include "base/utils/thread.h"
 
 class FileLogger : public QObject
 {
@@ -61,16 +55,13 @@ public:
     void setMaxSize(int value);
 
 private slots:
-    void addLogMessage(const Log::Msg &msg);
-    void flushLog();
+    void addNewLogMessages();
 
 private:
-    void openLogFile();
-    void closeLogFile();
+    // Log file is written in separate thread, so slow disk doesn't block the event loop
+    class Worker;
 
-    Path m_path;
-    bool m_backup;
-    int m_maxSize;
-    QFile m_logFile;
-    QTimer m_flusher;
+    Utils::Thread::UniquePtr m_ioThread;
+    Worker *m_worker = nullptr;
+    int m_lastMessageId = -1;
 };
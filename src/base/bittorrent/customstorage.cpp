@@ -28,36 +28,187 @@
 
 #include "customstorage.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
 #include <libtorrent/download_priority.hpp>
 
+#include <QCoreApplication>
+
+#include "base/logger.h"
 #include "base/utils/fs.h"
 #include "common.h"
 
+namespace
+{
+#ifdef Q_OS_LINUX
+    const bool FILE_CLONING_SUPPORTED = true;
+#else
+    const bool FILE_CLONING_SUPPORTED = false;
+#endif
+
+    bool canCloneFiles(const Path &savePath, const Path &newSavePath)
+    {
+        // Files can be cloned only within the same filesystem. However, the files still
+        // may not be renamable there, e.g. if the paths belong to different btrfs subvolumes.
+        return FILE_CLONING_SUPPORTED
+                && (Utils::Fs::storageDevice(savePath) == Utils::Fs::storageDevice(newSavePath));
+    }
+
+    enum class FileMoveResult
+    {
+        Failed,
+        Renamed,
+        Reflinked,
+        CopiedInKernel
+    };
+
+    // Moves the file if it can be done without passing its data through user space
+    FileMoveResult moveFileWithoutCopying(const Path &sourcePath, const Path &targetPath)
+    {
+        if (!Utils::Fs::mkpath(targetPath.parentPath()))
+            return FileMoveResult::Failed;
+
+        // QFile::rename() isn't used since it silently falls back to copying
+        std::error_code ec;
+        std::filesystem::rename(sourcePath.toStdFsPath(), targetPath.toStdFsPath(), ec);
+        if (!ec)
+            return FileMoveResult::Renamed;
+
+        switch (Utils::Fs::cloneFile(sourcePath, targetPath))
+        {
+        case Utils::Fs::CloneMethod::Reflink:
+            Utils::Fs::removeFile(sourcePath);
+            return FileMoveResult::Reflinked;
+        case Utils::Fs::CloneMethod::CopyFileRange:
+            Utils::Fs::removeFile(sourcePath);
+            return FileMoveResult::CopiedInKernel;
+        case Utils::Fs::CloneMethod::None:
+            break;
+        }
+
+        return FileMoveResult::Failed;
+    }
+
+    // Moves the files that can be renamed or cloned to the new location. The rest of files
+    // are left in place, so libtorrent moves them as usual (it ignores already missing files).
+    // Returns the files that are moved, so they can be moved back if libtorrent fails to move the rest.
+    PathList moveFilesWithoutCopying(const lt::file_storage &fileStorage, const Path &savePath
+            , const Path &newSavePath, const lt::move_flags_t flags)
+    {
+        PathList filePaths;
+        for (const lt::file_index_t fileIndex : fileStorage.file_range())
+        {
+            // ignore pad files and the files libtorrent doesn't move
+            if (!fileStorage.pad_file_at(fileIndex) && !fileStorage.file_absolute_path(fileIndex))
+                filePaths.append(Path(fileStorage.file_path(fileIndex)));
+        }
+
+        // Unless libtorrent may replace the existing files in the new location, it either fails
+        // or keeps them and rechecks the torrent. It would see the files moved here as existing ones,
+        // so nothing is moved here if there are any other files (see nativeMoveFlags()).
+        if (flags != lt::move_flags_t::always_replace_files)
+        {
+            const bool hasExistingFiles = std::any_of(filePaths.cbegin(), filePaths.cend()
+                    , [&newSavePath](const Path &filePath) { return (newSavePath / filePath).exists(); });
+            if (hasExistingFiles)
+                return {};
+        }
+
+        PathList movedFiles;
+        int reflinkedFilesCount = 0;
+        int copiedFilesCount = 0;
+        int remainingFilesCount = 0;
+        for (const Path &filePath : asConst(filePaths))
+        {
+            const Path sourcePath = savePath / filePath;
+            const Path targetPath = newSavePath / filePath;
+            // existing target files are handled by libtorrent according to the move flags
+            if (!Utils::Fs::isRegularFile(sourcePath) || targetPath.exists())
+                continue;
+
+            switch (moveFileWithoutCopying(sourcePath, targetPath))
+            {
+            case FileMoveResult::Failed:
+                ++remainingFilesCount;
+                continue;
+            case FileMoveResult::Reflinked:
+                ++reflinkedFilesCount;
+                break;
+            case FileMoveResult::CopiedInKernel:
+                ++copiedFilesCount;
+                break;
+            case FileMoveResult::Renamed:
+                break;
+            }
+
+            movedFiles.append(filePath);
+        }
+
+        if ((reflinkedFilesCount > 0) || (copiedFilesCount > 0))
+        {
+            LogMsg(QCoreApplication::translate("CustomStorage", "Moved files by cloning them. Destination: \"%1\". Reflinked: %2. Copied using copy_file_range(): %3. Left to be copied: %4")
+                .arg(newSavePath.toString(), QString::number(reflinkedFilesCount), QString::number(copiedFilesCount), QString::number(remainingFilesCount)));
+        }
+
+        return movedFiles;
+    }
+
+    lt::move_flags_t nativeMoveFlags(const lt::move_flags_t flags, const PathList &movedFiles)
+    {
+        // Only the files moved by qBittorrent exist in the new location. libtorrent would fail or
+        // recheck the torrent because of them, while it skips them when it may replace the existing
+        // files, since their source files are missing.
+        return (movedFiles.isEmpty() ? flags : lt::move_flags_t::always_replace_files);
+    }
+
+    // Moves the files back if libtorrent has failed to move the storage,
+    // so the files aren't left split between both locations
+    void restoreMovedFiles(const PathList &movedFiles, const Path &savePath, const Path &newSavePath)
+    {
+        for (const Path &filePath : movedFiles)
+        {
+            const Path sourcePath = newSavePath / filePath;
+            const Path targetPath = savePath / filePath;
+            if (targetPath.exists() || (moveFileWithoutCopying(sourcePath, targetPath) == FileMoveResult::Failed))
+            {
+                LogMsg(QCoreApplication::translate("CustomStorage", "Failed to move file back after failed storage move. Source: \"%1\". Destination: \"%2\"")
+                    .arg(sourcePath.toString(), targetPath.toString()), Log::WARNING);
+            }
+        }
+    }
+}
+
 #ifdef QBT_USES_LIBTORRENT2
 #include <libtorrent/mmap_disk_io.hpp>
 #include <libtorrent/posix_disk_io.hpp>
 #include <libtorrent/session.hpp>
 
+#include <boost/asio/post.hpp>
+
 std::unique_ptr<lt::disk_interface> customDiskIOConstructor(
         lt::io_context &ioContext, const lt::settings_interface &settings, lt::counters &counters)
 {
-    return std::make_unique<CustomDiskIOThread>(lt::default_disk_io_constructor(ioContext, settings, counters));
+    return std::make_unique<CustomDiskIOThread>(ioContext, lt::default_disk_io_constructor(ioContext, settings, counters));
 }
 
 std::unique_ptr<lt::disk_interface> customPosixDiskIOConstructor(
         lt::io_context &ioContext, const lt::settings_interface &settings, lt::counters &counters)
 {
-    return std::make_unique<CustomDiskIOThread>(lt::posix_disk_io_constructor(ioContext, settings, counters));
+    return std::make_unique<CustomDiskIOThread>(ioContext, lt::posix_disk_io_constructor(ioContext, settings, counters));
 }
 
 std::unique_ptr<lt::disk_interface> customMMapDiskIOConstructor(
         lt::io_context &ioContext, const lt::settings_interface &settings, lt::counters &counters)
 {
-    return std::make_unique<CustomDiskIOThread>(lt::mmap_disk_io_constructor(ioContext, settings, counters));
+    return std::make_unique<CustomDiskIOThread>(ioContext, lt::mmap_disk_io_constructor(ioContext, settings, counters));
 }
 
-CustomDiskIOThread::CustomDiskIOThread(std::unique_ptr<libtorrent::disk_interface> nativeDiskIOThread)
-    : m_nativeDiskIO {std::move(nativeDiskIOThread)}
+CustomDiskIOThread::CustomDiskIOThread(lt::io_context &ioContext, std::unique_ptr<libtorrent::disk_interface> nativeDiskIOThread)
+    : m_ioContext {ioContext}
+    , m_nativeDiskIO {std::move(nativeDiskIOThread)}
 {
 }
 
@@ -66,11 +217,14 @@ lt::storage_holder CustomDiskIOThread::new_torrent(const lt::storage_params &sto
     lt::storage_holder storageHolder = m_nativeDiskIO->new_torrent(storageParams, torrent);
 
     const Path savePath {storageParams.path};
+    const BitTorrent::TorrentID torrentID {storageParams.info_hash};
     m_storageData[storageHolder] =
     {
         savePath,
         storageParams.mapped_files ? *storageParams.mapped_files : storageParams.files,
-        storageParams.priorities
+        storageParams.priorities,
+        torrentID,
+        BitTorrent::DiskIOStats::instance()->addTorrent(torrentID)
     };
 
     return storageHolder;
@@ -78,6 +232,12 @@ lt::storage_holder CustomDiskIOThread::new_torrent(const lt::storage_params &sto
 
 void CustomDiskIOThread::remove_torrent(lt::storage_index_t storage)
 {
+    if (postponeJob(storage, [=, this] { remove_torrent(storage); }))
+        return;
+
+    const StorageData &storageData = m_storageData[storage];
+    BitTorrent::DiskIOStats::instance()->removeTorrent(storageData.torrentID, storageData.ioStats);
+
     m_nativeDiskIO->remove_torrent(storage);
 }
 
@@ -85,47 +245,178 @@ void CustomDiskIOThread::async_read(lt::storage_index_t storage, const lt::peer_
                                     , std::function<void (lt::disk_buffer_holder, const lt::storage_error &)> handler
                                     , lt::disk_job_flags_t flags)
 {
-    m_nativeDiskIO->async_read(storage, peerRequest, std::move(handler), flags);
+    if (postponeJob(storage, [=, this] { async_read(storage, peerRequest, handler, flags); }))
+        return;
+
+    const auto issueTime = std::chrono::steady_clock::now();
+    m_nativeDiskIO->async_read(storage, peerRequest
+            , [ioStats = m_storageData[storage].ioStats, issueTime, length = peerRequest.length, handler = std::move(handler)]
+                    (lt::disk_buffer_holder buffer, const lt::storage_error &error)
+    {
+        if (ioStats && !error)
+            ioStats->recordRead(length, (std::chrono::steady_clock::now() - issueTime));
+        handler(std::move(buffer), error);
+    }, flags);
 }
 
 bool CustomDiskIOThread::async_write(lt::storage_index_t storage, const lt::peer_request &peerRequest
                                      , const char *buf, std::shared_ptr<lt::disk_observer> diskObserver
                                      , std::function<void (const lt::storage_error &)> handler, lt::disk_job_flags_t flags)
 {
-    return m_nativeDiskIO->async_write(storage, peerRequest, buf, std::move(diskObserver), std::move(handler), flags);
+    // The buffer is only valid during the call, so the postponed job needs its own copy of data.
+    // The caller is told to stop issuing writes until the postponed ones are issued, otherwise
+    // the copies would keep piling up while the files are being moved.
+    if (postponeJob(storage, [=, this, data = std::vector<char>(buf, (buf + peerRequest.length))]
+            {
+                // if the write queue is full, libtorrent notifies the observer by itself
+                const bool exceeded = async_write(storage, peerRequest, data.data(), diskObserver, handler, flags);
+                if (!exceeded && diskObserver)
+                    diskObserver->on_disk();
+            }))
+    {
+        return true;
+    }
+
+    const auto issueTime = std::chrono::steady_clock::now();
+    return m_nativeDiskIO->async_write(storage, peerRequest, buf, std::move(diskObserver)
+            , [ioStats = m_storageData[storage].ioStats, issueTime, length = peerRequest.length, handler = std::move(handler)]
+                    (const lt::storage_error &error)
+    {
+        if (ioStats && !error)
+            ioStats->recordWrite(length, (std::chrono::steady_clock::now() - issueTime));
+        handler(error);
+    }, flags);
 }
 
 void CustomDiskIOThread::async_hash(lt::storage_index_t storage, lt::piece_index_t piece
                                     , lt::span<lt::sha256_hash> hash, lt::disk_job_flags_t flags
                                     , std::function<void (lt::piece_index_t, const lt::sha1_hash &, const lt::storage_error &)> handler)
 {
-    m_nativeDiskIO->async_hash(storage, piece, hash, flags, std::move(handler));
+    if (postponeJob(storage, [=, this] { async_hash(storage, piece, hash, flags, handler); }))
+        return;
+
+    const auto issueTime = std::chrono::steady_clock::now();
+    m_nativeDiskIO->async_hash(storage, piece, hash, flags
+            , [ioStats = m_storageData[storage].ioStats, issueTime, handler = std::move(handler)]
+                    (lt::piece_index_t piece, const lt::sha1_hash &hash, const lt::storage_error &error)
+    {
+        if (ioStats && !error)
+            ioStats->recordHash(std::chrono::steady_clock::now() - issueTime);
+        handler(piece, hash, error);
+    });
 }
 
 void CustomDiskIOThread::async_hash2(lt::storage_index_t storage, lt::piece_index_t piece
                                      , int offset, lt::disk_job_flags_t flags
                                      , std::function<void (lt::piece_index_t, const lt::sha256_hash &, const lt::storage_error &)> handler)
 {
-    m_nativeDiskIO->async_hash2(storage, piece, offset, flags, std::move(handler));
+    if (postponeJob(storage, [=, this] { async_hash2(storage, piece, offset, flags, handler); }))
+        return;
+
+    const auto issueTime = std::chrono::steady_clock::now();
+    m_nativeDiskIO->async_hash2(storage, piece, offset, flags
+            , [ioStats = m_storageData[storage].ioStats, issueTime, handler = std::move(handler)]
+                    (lt::piece_index_t piece, const lt::sha256_hash &hash, const lt::storage_error &error)
+    {
+        if (ioStats && !error)
+            ioStats->recordHash(std::chrono::steady_clock::now() - issueTime);
+        handler(piece, hash, error);
+    });
 }
 
 void CustomDiskIOThread::async_move_storage(lt::storage_index_t storage, std::string path, lt::move_flags_t flags
                                             , std::function<void (lt::status_t, const std::string &, const lt::storage_error &)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_move_storage(storage, path, flags, handler); }))
+        return;
+
     const Path newSavePath {path};
 
     if (flags == lt::move_flags_t::dont_replace)
         handleCompleteFiles(storage, newSavePath);
 
+    if (!FILE_CLONING_SUPPORTED)
+    {
+        moveStorage(storage, path, flags, std::move(handler));
+        return;
+    }
+
+    // libtorrent falls back to copying file data through user space when it can't rename the files,
+    // even if they could be cloned almost instantly. So qBittorrent moves such files by itself
+    // and libtorrent moves only the rest of them. No other jobs of the torrent can be performed
+    // until it is decided how the files are moved and while they are being moved,
+    // so they are postponed until it is done.
+    m_postponedJobs[storage] = {};
+    // looking up the devices may be slow, so it isn't done in the network thread
+    m_fileMovingPool.start([=, this, savePath = m_storageData[storage].savePath]
+    {
+        const bool canClone = canCloneFiles(savePath, newSavePath);
+
+        boost::asio::post(m_ioContext, [=, this]
+        {
+            if (!canClone)
+            {
+                moveStorage(storage, path, flags, handler);
+                resumePostponedJobs(storage);
+                m_nativeDiskIO->submit_jobs();
+                return;
+            }
+
+            m_nativeDiskIO->async_release_files(storage, [=, this]
+            {
+                m_fileMovingPool.start([=, this, files = m_storageData[storage].files]
+                {
+                    const PathList movedFiles = moveFilesWithoutCopying(files, savePath, newSavePath, flags);
+
+                    boost::asio::post(m_ioContext, [=, this]
+                    {
+                        moveStorage(storage, path, nativeMoveFlags(flags, movedFiles), handler, movedFiles);
+                        resumePostponedJobs(storage);
+                        m_nativeDiskIO->submit_jobs();
+                    });
+                });
+            });
+            m_nativeDiskIO->submit_jobs();
+        });
+    });
+}
+
+void CustomDiskIOThread::moveStorage(lt::storage_index_t storage, const std::string &path, lt::move_flags_t flags
+                                     , std::function<void (lt::status_t, const std::string &, const lt::storage_error &)> handler
+                                     , const PathList &movedFiles)
+{
+    const Path newSavePath {path};
+
     m_nativeDiskIO->async_move_storage(storage, path, flags
             , [=, this, handler = std::move(handler)](lt::status_t status, const std::string &path, const lt::storage_error &error)
     {
 #if LIBTORRENT_VERSION_NUM < 20100
-        if ((status != lt::status_t::fatal_disk_error) && (status != lt::status_t::file_exist))
+        const bool isMoved = (status != lt::status_t::fatal_disk_error) && (status != lt::status_t::file_exist);
 #else
-        if ((status != lt::disk_status::fatal_disk_error) && (status != lt::disk_status::file_exist))
+        const bool isMoved = (status != lt::disk_status::fatal_disk_error) && (status != lt::disk_status::file_exist);
 #endif
+        if (isMoved)
+        {
             m_storageData[storage].savePath = newSavePath;
+        }
+        else if (!movedFiles.isEmpty())
+        {
+            // The files moved by qBittorrent are moved back, so the torrent isn't left split
+            // between both locations. Its jobs are postponed until they are in place again.
+            m_postponedJobs[storage] = {};
+            m_fileMovingPool.start([=, this, savePath = m_storageData[storage].savePath]
+            {
+                restoreMovedFiles(movedFiles, savePath, newSavePath);
+
+                boost::asio::post(m_ioContext, [=, this]
+                {
+                    handler(status, path, error);
+                    resumePostponedJobs(storage);
+                    m_nativeDiskIO->submit_jobs();
+                });
+            });
+            return;
+        }
 
         handler(status, path, error);
     });
@@ -133,6 +424,9 @@ void CustomDiskIOThread::async_move_storage(lt::storage_index_t storage, std::st
 
 void CustomDiskIOThread::async_release_files(lt::storage_index_t storage, std::function<void ()> handler)
 {
+    if (postponeJob(storage, [=, this] { async_release_files(storage, handler); }))
+        return;
+
     m_nativeDiskIO->async_release_files(storage, std::move(handler));
 }
 
@@ -140,18 +434,27 @@ void CustomDiskIOThread::async_check_files(lt::storage_index_t storage, const lt
                                            , lt::aux::vector<std::string, lt::file_index_t> links
                                            , std::function<void (lt::status_t, const lt::storage_error &)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_check_files(storage, resume_data, links, handler); }))
+        return;
+
     handleCompleteFiles(storage, m_storageData[storage].savePath);
     m_nativeDiskIO->async_check_files(storage, resume_data, std::move(links), std::move(handler));
 }
 
 void CustomDiskIOThread::async_stop_torrent(lt::storage_index_t storage, std::function<void ()> handler)
 {
+    if (postponeJob(storage, [=, this] { async_stop_torrent(storage, handler); }))
+        return;
+
     m_nativeDiskIO->async_stop_torrent(storage, std::move(handler));
 }
 
 void CustomDiskIOThread::async_rename_file(lt::storage_index_t storage, lt::file_index_t index, std::string name
                                            , std::function<void (const std::string &, lt::file_index_t, const lt::storage_error &)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_rename_file(storage, index, name, handler); }))
+        return;
+
     m_nativeDiskIO->async_rename_file(storage, index, name
             , [=, this, handler = std::move(handler)](const std::string &name, lt::file_index_t index, const lt::storage_error &error)
     {
@@ -164,12 +467,18 @@ void CustomDiskIOThread::async_rename_file(lt::storage_index_t storage, lt::file
 void CustomDiskIOThread::async_delete_files(lt::storage_index_t storage, lt::remove_flags_t options
                                             , std::function<void (const lt::storage_error &)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_delete_files(storage, options, handler); }))
+        return;
+
     m_nativeDiskIO->async_delete_files(storage, options, std::move(handler));
 }
 
 void CustomDiskIOThread::async_set_file_priority(lt::storage_index_t storage, lt::aux::vector<lt::download_priority_t, lt::file_index_t> priorities
                                                  , std::function<void (const lt::storage_error &, lt::aux::vector<lt::download_priority_t, lt::file_index_t>)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_set_file_priority(storage, priorities, handler); }))
+        return;
+
     m_nativeDiskIO->async_set_file_priority(storage, std::move(priorities)
             , [=, this, handler = std::move(handler)](const lt::storage_error &error, const lt::aux::vector<lt::download_priority_t, lt::file_index_t> &priorities)
     {
@@ -181,6 +490,9 @@ void CustomDiskIOThread::async_set_file_priority(lt::storage_index_t storage, lt
 void CustomDiskIOThread::async_clear_piece(lt::storage_index_t storage, lt::piece_index_t index
                                            , std::function<void (lt::piece_index_t)> handler)
 {
+    if (postponeJob(storage, [=, this] { async_clear_piece(storage, index, handler); }))
+        return;
+
     m_nativeDiskIO->async_clear_piece(storage, index, std::move(handler));
 }
 
@@ -196,6 +508,9 @@ std::vector<lt::open_file_state> CustomDiskIOThread::get_status(lt::storage_inde
 
 void CustomDiskIOThread::abort(bool wait)
 {
+    if (wait)
+        m_fileMovingPool.waitForDone();
+
     m_nativeDiskIO->abort(wait);
 }
 
@@ -209,6 +524,25 @@ void CustomDiskIOThread::settings_updated()
     m_nativeDiskIO->settings_updated();
 }
 
+bool CustomDiskIOThread::postponeJob(lt::storage_index_t storage, std::function<void ()> job)
+{
+    const auto iter = m_postponedJobs.find(storage);
+    if (iter == m_postponedJobs.end())
+        return false;
+
+    iter->append(std::move(job));
+    return true;
+}
+
+void CustomDiskIOThread::resumePostponedJobs(lt::storage_index_t storage)
+{
+    // the jobs are performed in the order they were requested, so some of them
+    // (e.g. the next move) may cause the rest to be postponed again
+    const QList<std::function<void ()>> jobs = m_postponedJobs.take(storage);
+    for (const std::function<void ()> &job : jobs)
+        job();
+}
+
 void CustomDiskIOThread::handleCompleteFiles(lt::storage_index_t storage, const Path &savePath)
 {
     const StorageData storageData = m_storageData[storage];
@@ -246,9 +580,16 @@ lt::storage_interface *customStorageConstructor(const lt::storage_params &params
 CustomStorage::CustomStorage(const lt::storage_params &params, lt::file_pool &filePool)
     : lt::default_storage {params, filePool}
     , m_savePath {params.path}
+    , m_torrentID {params.info_hash}
+    , m_ioStats {BitTorrent::DiskIOStats::instance()->addTorrent(m_torrentID)}
 {
 }
 
+CustomStorage::~CustomStorage()
+{
+    BitTorrent::DiskIOStats::instance()->removeTorrent(m_torrentID, m_ioStats);
+}
+
 bool CustomStorage::verify_resume_data(const lt::add_torrent_params &rd, const lt::aux::vector<std::string, lt::file_index_t> &links, lt::storage_error &ec)
 {
     handleCompleteFiles(m_savePath);
@@ -268,9 +609,40 @@ lt::status_t CustomStorage::move_storage(const std::string &savePath, lt::move_f
     if (flags == lt::move_flags_t::dont_replace)
         handleCompleteFiles(newSavePath);
 
-    const lt::status_t ret = lt::default_storage::move_storage(savePath, flags, ec);
+    // libtorrent falls back to copying file data through user space when it can't rename
+    // the files, even if they could be cloned almost instantly. So such files are moved here.
+    const PathList movedFiles = canCloneFiles(m_savePath, newSavePath)
+            ? moveFilesWithoutCopying(files(), m_savePath, newSavePath, flags) : PathList();
+
+    const lt::status_t ret = lt::default_storage::move_storage(savePath, nativeMoveFlags(flags, movedFiles), ec);
     if ((ret != lt::status_t::fatal_disk_error) && (ret != lt::status_t::file_exist))
         m_savePath = newSavePath;
+    else
+        restoreMovedFiles(movedFiles, m_savePath, newSavePath);
+
+    return ret;
+}
+
+int CustomStorage::readv(const lt::span<const lt::iovec_t> bufs, const lt::piece_index_t piece
+                         , const int offset, const lt::open_mode_t flags, lt::storage_error &ec)
+{
+    // libtorrent 1.2 performs the jobs synchronously in the disk threads,
+    // so the latency doesn't include the time spent in the queue
+    const auto startTime = std::chrono::steady_clock::now();
+    const int ret = lt::default_storage::readv(bufs, piece, offset, flags, ec);
+    if (ret > 0)
+        m_ioStats->recordRead(ret, (std::chrono::steady_clock::now() - startTime));
+
+    return ret;
+}
+
+int CustomStorage::writev(const lt::span<const lt::iovec_t> bufs, const lt::piece_index_t piece
+                          , const int offset, const lt::open_mode_t flags, lt::storage_error &ec)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const int ret = lt::default_storage::writev(bufs, piece, offset, flags, ec);
+    if (ret > 0)
+        m_ioStats->recordWrite(ret, (std::chrono::steady_clock::now() - startTime));
 
     return ret;
 }
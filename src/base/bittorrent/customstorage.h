@@ -34,6 +34,7 @@
 #include <QString>
 
 #include "base/path.h"
+#include "diskiostats.h"
 
 #ifdef QBT_USES_LIBTORRENT2
 #include <libtorrent/disk_interface.hpp>
@@ -41,6 +42,8 @@
 #include <libtorrent/io_context.hpp>
 
 #include <QHash>
+#include <QList>
+#include <QThreadPool>
 #else
 #include <libtorrent/storage.hpp>
 #endif
@@ -56,7 +59,7 @@ std::unique_ptr<lt::disk_interface> customMMapDiskIOConstructor(
 class CustomDiskIOThread final : public lt::disk_interface
 {
 public:
-    explicit CustomDiskIOThread(std::unique_ptr<libtorrent::disk_interface> nativeDiskIOThread);
+    CustomDiskIOThread(lt::io_context &ioContext, std::unique_ptr<libtorrent::disk_interface> nativeDiskIOThread);
 
     lt::storage_holder new_torrent(const lt::storage_params &storageParams, const std::shared_ptr<void> &torrent) override;
     void remove_torrent(lt::storage_index_t storageIndex) override;
@@ -91,7 +94,13 @@ public:
 
 private:
     void handleCompleteFiles(libtorrent::storage_index_t storage, const Path &savePath);
+    void moveStorage(lt::storage_index_t storage, const std::string &path, lt::move_flags_t flags
+                     , std::function<void (lt::status_t, const std::string &, const lt::storage_error &)> handler
+                     , const PathList &movedFiles = {});
+    bool postponeJob(lt::storage_index_t storage, std::function<void ()> job);
+    void resumePostponedJobs(lt::storage_index_t storage);
 
+    lt::io_context &m_ioContext;
     std::unique_ptr<lt::disk_interface> m_nativeDiskIO;
 
     struct StorageData
@@ -99,8 +108,13 @@ private:
         Path savePath;
         lt::file_storage files;
         lt::aux::vector<lt::download_priority_t, lt::file_index_t> filePriorities;
+        BitTorrent::TorrentID torrentID;
+        std::shared_ptr<BitTorrent::DiskIOStats::TorrentStats> ioStats;
     };
     QHash<lt::storage_index_t, StorageData> m_storageData;
+    // Jobs of the torrents whose files are being moved by qBittorrent itself
+    QHash<lt::storage_index_t, QList<std::function<void ()>>> m_postponedJobs;
+    QThreadPool m_fileMovingPool;
 };
 
 #else
@@ -111,15 +125,20 @@ class CustomStorage final : public lt::default_storage
 {
 public:
     explicit CustomStorage(const lt::storage_params &params, lt::file_pool &filePool);
+    ~CustomStorage() override;
 
     bool verify_resume_data(const lt::add_torrent_params &rd, const lt::aux::vector<std::string, lt::file_index_t> &links, lt::storage_error &ec) override;
     void set_file_priority(lt::aux::vector<lt::download_priority_t, lt::file_index_t> &priorities, lt::storage_error &ec) override;
     lt::status_t move_storage(const std::string &savePath, lt::move_flags_t flags, lt::storage_error &ec) override;
+    int readv(lt::span<const lt::iovec_t> bufs, lt::piece_index_t piece, int offset, lt::open_mode_t flags, lt::storage_error &ec) override;
+    int writev(lt::span<const lt::iovec_t> bufs, lt::piece_index_t piece, int offset, lt::open_mode_t flags, lt::storage_error &ec) override;
 
 private:
     void handleCompleteFiles(const Path &savePath);
 
     lt::aux::vector<lt::download_priority_t, lt::file_index_t> m_filePriorities;
     Path m_savePath;
+    BitTorrent::TorrentID m_torrentID;
+    std::shared_ptr<BitTorrent::DiskIOStats::TorrentStats> m_ioStats;
 };
 #endif
@@ -0,0 +1,111 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "diskiostats.h"
+
+#include <algorithm>
+#include <bit>
+
+void BitTorrent::DiskIOStats::TorrentStats::recordRead(const qint64 bytes, const Duration latency)
+{
+    m_bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+    record(m_readLatency, latency);
+}
+
+void BitTorrent::DiskIOStats::TorrentStats::recordWrite(const qint64 bytes, const Duration latency)
+{
+    m_bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    record(m_writeLatency, latency);
+}
+
+void BitTorrent::DiskIOStats::TorrentStats::recordHash(const Duration latency)
+{
+    record(m_hashLatency, latency);
+}
+
+BitTorrent::DiskIOStatus BitTorrent::DiskIOStats::TorrentStats::status() const
+{
+    DiskIOStatus status;
+    status.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    status.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    status.readLatency = load(m_readLatency);
+    status.writeLatency = load(m_writeLatency);
+    status.hashLatency = load(m_hashLatency);
+    return status;
+}
+
+void BitTorrent::DiskIOStats::TorrentStats::record(AtomicHistogram &histogram, const Duration latency)
+{
+    const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    const auto bucket = std::bit_width(static_cast<quint64>(std::max<qint64>(microseconds, 0) / LATENCY_BUCKET_BASE));
+    histogram[std::min<int>(bucket, (LATENCY_BUCKET_COUNT - 1))].fetch_add(1, std::memory_order_relaxed);
+}
+
+BitTorrent::LatencyHistogram BitTorrent::DiskIOStats::TorrentStats::load(const AtomicHistogram &histogram)
+{
+    LatencyHistogram result;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; ++i)
+        result[i] = histogram[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+BitTorrent::DiskIOStats *BitTorrent::DiskIOStats::instance()
+{
+    // libtorrent threads may still record the statistics while the session is
+    // being destroyed, so it is kept alive until the application exits
+    static DiskIOStats diskIOStats;
+    return &diskIOStats;
+}
+
+std::shared_ptr<BitTorrent::DiskIOStats::TorrentStats> BitTorrent::DiskIOStats::addTorrent(const TorrentID &id)
+{
+    const auto stats = std::make_shared<TorrentStats>();
+
+    const QWriteLocker locker(&m_lock);
+    m_torrents.insert(id, stats);
+    return stats;
+}
+
+void BitTorrent::DiskIOStats::removeTorrent(const TorrentID &id, const std::shared_ptr<TorrentStats> &stats)
+{
+    const QWriteLocker locker(&m_lock);
+    // the torrent could already be re-added
+    if (m_torrents.value(id) == stats)
+        m_torrents.remove(id);
+}
+
+BitTorrent::DiskIOStatus BitTorrent::DiskIOStats::torrentStatus(const TorrentID &id) const
+{
+    std::shared_ptr<TorrentStats> stats;
+    {
+        const QReadLocker locker(&m_lock);
+        stats = m_torrents.value(id);
+    }
+
+    return (stats ? stats->status() : DiskIOStatus());
+}
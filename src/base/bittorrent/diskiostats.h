@@ -0,0 +1,93 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include <QHash>
+#include <QReadWriteLock>
+
+#include "diskiostatus.h"
+#include "infohash.h"
+
+namespace BitTorrent
+{
+    // Collects the disk I/O statistics of the torrents. It is shared by
+    // the disk I/O threads of libtorrent and the rest of the application.
+    class DiskIOStats
+    {
+        Q_DISABLE_COPY_MOVE(DiskIOStats)
+
+    public:
+        using Duration = std::chrono::steady_clock::duration;
+
+        // The statistics are recorded without locking,
+        // so the same torrent can be accessed from several threads
+        class TorrentStats
+        {
+            Q_DISABLE_COPY_MOVE(TorrentStats)
+
+        public:
+            TorrentStats() = default;
+
+            void recordRead(qint64 bytes, Duration latency);
+            void recordWrite(qint64 bytes, Duration latency);
+            void recordHash(Duration latency);
+
+            DiskIOStatus status() const;
+
+        private:
+            using AtomicHistogram = std::array<std::atomic<qint64>, LATENCY_BUCKET_COUNT>;
+
+            static void record(AtomicHistogram &histogram, Duration latency);
+            static LatencyHistogram load(const AtomicHistogram &histogram);
+
+            std::atomic<qint64> m_bytesRead {0};
+            std::atomic<qint64> m_bytesWritten {0};
+            AtomicHistogram m_readLatency {};
+            AtomicHistogram m_writeLatency {};
+            AtomicHistogram m_hashLatency {};
+        };
+
+        static DiskIOStats *instance();
+
+        std::shared_ptr<TorrentStats> addTorrent(const TorrentID &id);
+        void removeTorrent(const TorrentID &id, const std::shared_ptr<TorrentStats> &stats);
+        DiskIOStatus torrentStatus(const TorrentID &id) const;
+
+    private:
+        DiskIOStats() = default;
+
+        mutable QReadWriteLock m_lock;
+        QHash<TorrentID, std::shared_ptr<TorrentStats>> m_torrents;
+    };
+}
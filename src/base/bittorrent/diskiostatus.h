@@ -0,0 +1,77 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <array>
+
+#include <QtTypes>
+
+namespace BitTorrent
+{
+    // Histogram of disk job latencies. The bucket N counts the jobs completed in less than
+    // (LATENCY_BUCKET_BASE << N) microseconds, except of the last bucket that counts the rest of them.
+    inline constexpr int LATENCY_BUCKET_COUNT = 16;
+    inline constexpr qint64 LATENCY_BUCKET_BASE = 32;
+
+    using LatencyHistogram = std::array<qint64, LATENCY_BUCKET_COUNT>;
+
+    // Returns the upper bound of the latency (in microseconds) of the given
+    // percent of the jobs or 0 if there were no jobs.
+    inline qint64 latencyPercentile(const LatencyHistogram &histogram, const int percent)
+    {
+        qint64 total = 0;
+        for (const qint64 count : histogram)
+            total += count;
+        if (total == 0)
+            return 0;
+
+        const qint64 threshold = ((total * percent) + 99) / 100;
+        qint64 accumulated = 0;
+        for (int i = 0; i < (LATENCY_BUCKET_COUNT - 1); ++i)
+        {
+            accumulated += histogram[i];
+            if (accumulated >= threshold)
+                return (LATENCY_BUCKET_BASE << i);
+        }
+
+        return (LATENCY_BUCKET_BASE << (LATENCY_BUCKET_COUNT - 1));
+    }
+
+    // Disk I/O performed by libtorrent on behalf of the torrent during the current session.
+    // With libtorrent 2 latency is measured from the moment the job is issued until it is completed,
+    // so it includes the time the job spends in the disk queue. Hashing isn't recorded with libtorrent 1.2.
+    struct DiskIOStatus
+    {
+        qint64 bytesRead = 0;
+        qint64 bytesWritten = 0;
+        LatencyHistogram readLatency {};
+        LatencyHistogram writeLatency {};
+        LatencyHistogram hashLatency {};
+    };
+}
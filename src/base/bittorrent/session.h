@@ -57,6 +57,8 @@ enum DeleteOption
 
 namespace BitTorrent
 {
+    enum class TorrentStateFlag;
+
     class InfoHash;
     class Torrent;
     class TorrentDescriptor;
@@ -165,6 +167,8 @@ namespace BitTorrent
         virtual bool addCategory(const QString &name, const CategoryOptions &options = {}) = 0;
         virtual bool editCategory(const QString &name, const CategoryOptions &options) = 0;
         virtual bool removeCategory(const QString &name) = 0;
+        // Returns the torrents having exactly this category (empty category means uncategorized torrents)
+        virtual QVector<Torrent *> categoryTorrents(const QString &categoryName) const = 0;
         virtual bool isSubcategoriesEnabled() const = 0;
         virtual void setSubcategoriesEnabled(bool value) = 0;
         virtual bool useCategoryPathsInManualMode() const = 0;
@@ -178,6 +182,8 @@ namespace BitTorrent
         virtual bool hasTag(const QString &tag) const = 0;
         virtual bool addTag(const QString &tag) = 0;
         virtual bool removeTag(const QString &tag) = 0;
+        // Returns the torrents having this tag (empty tag means untagged torrents)
+        virtual QVector<Torrent *> taggedTorrents(const QString &tag) const = 0;
 
         // Torrent Management Mode subsystem (TMM)
         //
@@ -430,8 +436,18 @@ namespace BitTorrent
         virtual Torrent *findTorrent(const InfoHash &infoHash) const = 0;
         virtual QVector<Torrent *> torrents() const = 0;
         virtual qsizetype torrentsCount() const = 0;
+        // Returns the torrents having the state flag (see Torrent::stateFlags())
+        virtual QVector<Torrent *> stateTorrents(TorrentStateFlag flag) const = 0;
+        virtual qsizetype stateTorrentsCount(TorrentStateFlag flag) const = 0;
+        virtual QString trackerHost(const QString &trackerURL) const = 0;
+        // Returns the torrents having some tracker with the host (empty host means trackerless torrents)
+        virtual QVector<Torrent *> trackerHostTorrents(const QString &trackerHost) const = 0;
+        virtual qsizetype trackerHostTorrentsCount(const QString &trackerHost) const = 0;
+        virtual QVector<Torrent *> trackerURLTorrents(const QString &trackerURL) const = 0;
         virtual const SessionStatus &status() const = 0;
         virtual const CacheStatus &cacheStatus() const = 0;
+        // Approximate amount of memory used by the strings shared between torrents (tracker URLs, categories etc.)
+        virtual qint64 internedStringsMemoryUsage() const = 0;
         virtual bool isListening() const = 0;
 
         virtual MaxRatioAction maxRatioAction() const = 0;
@@ -114,12 +114,27 @@ using namespace BitTorrent;
 const Path CATEGORIES_FILE_NAME {u"categories.json"_s};
 const int MAX_PROCESSING_RESUMEDATA_COUNT = 50;
 const int STATISTICS_SAVE_INTERVAL = std::chrono::milliseconds(15min).count();
+// Only the optional fields of torrent status that are actually used are requested
+const lt::status_flags_t TORRENT_STATUS_FLAGS = lt::torrent_handle::query_distributed_copies
+        | lt::torrent_handle::query_accurate_download_counters
+        | lt::torrent_handle::query_last_seen_complete
+        | lt::torrent_handle::query_pieces
+        | lt::torrent_handle::query_torrent_file;
 
 namespace
 {
     const char PEER_ID[] = "qB";
     const auto USER_AGENT = QStringLiteral("qBittorrent/" QBT_VERSION_2);
 
+    QStringList trackerURLs(const QVector<BitTorrent::TrackerEntry> &trackers)
+    {
+        QStringList urls;
+        urls.reserve(trackers.size());
+        for (const BitTorrent::TrackerEntry &tracker : trackers)
+            urls.append(tracker.url);
+        return urls;
+    }
+
     void torrentQueuePositionUp(const lt::torrent_handle &handle)
     {
         try
@@ -298,6 +313,10 @@ namespace
     }
 #endif
 
+    // Maximum number of storage move jobs copying the data at the same time
+    // (to different devices, since only one such job per destination device is allowed)
+    const int MAX_ACTIVE_MOVE_STORAGE_JOBS = 4;
+
     constexpr lt::move_flags_t toNative(const MoveStorageMode mode)
     {
         switch (mode)
@@ -544,8 +563,8 @@ SessionImpl::SessionImpl(QObject *parent)
         m_categories = expandCategories(m_categories);
     }
 
-    const QStringList storedTags = m_storedTags.get();
-    m_tags = {storedTags.cbegin(), storedTags.cend()};
+    for (const QString &tag : asConst(m_storedTags.get()))
+        m_tags.add(tag);
 
     updateSeedingLimitTimer();
     populateAdditionalTrackers();
@@ -845,12 +864,17 @@ bool SessionImpl::editCategory(const QString &name, const CategoryOptions &optio
 
 bool SessionImpl::removeCategory(const QString &name)
 {
-    for (TorrentImpl *const torrent : asConst(m_torrents))
+    QVector<Torrent *> torrents;
+    for (auto it = m_categoryTorrents.cbegin(); it != m_categoryTorrents.cend(); ++it)
     {
-        if (torrent->belongsToCategory(name))
-            torrent->setCategory(u""_s);
+        const QString &category = it.key();
+        if ((category == name) || (isSubcategoriesEnabled() && category.startsWith(name + u'/')))
+            torrents.append(QVector<Torrent *>(it.value().cbegin(), it.value().cend()));
     }
 
+    for (Torrent *const torrent : asConst(torrents))
+        torrent->setCategory(u""_s);
+
     // remove stored category and its subcategories if exist
     bool result = false;
     if (isSubcategoriesEnabled())
@@ -881,6 +905,12 @@ bool SessionImpl::removeCategory(const QString &name)
     return result;
 }
 
+QVector<Torrent *> SessionImpl::categoryTorrents(const QString &categoryName) const
+{
+    const QSet<Torrent *> torrents = m_categoryTorrents.value(categoryName);
+    return {torrents.cbegin(), torrents.cend()};
+}
+
 bool SessionImpl::isSubcategoriesEnabled() const
 {
     return m_isSubcategoriesEnabled;
@@ -934,7 +964,7 @@ Path SessionImpl::suggestedDownloadPath(const QString &categoryName, std::option
 
 QSet<QString> SessionImpl::tags() const
 {
-    return m_tags;
+    return m_tags.tags();
 }
 
 bool SessionImpl::hasTag(const QString &tag) const
@@ -947,23 +977,30 @@ bool SessionImpl::addTag(const QString &tag)
     if (!isValidTag(tag) || hasTag(tag))
         return false;
 
-    m_tags.insert(tag);
-    m_storedTags = m_tags.values();
+    m_tags.add(tag);
+    m_storedTags = m_tags.tags().values();
     emit tagAdded(tag);
     return true;
 }
 
 bool SessionImpl::removeTag(const QString &tag)
 {
-    if (m_tags.remove(tag))
-    {
-        for (TorrentImpl *const torrent : asConst(m_torrents))
-            torrent->removeTag(tag);
-        m_storedTags = m_tags.values();
-        emit tagRemoved(tag);
-        return true;
-    }
-    return false;
+    if (!hasTag(tag))
+        return false;
+
+    const QSet<Torrent *> torrents = m_tags.torrents(tag);
+    for (Torrent *const torrent : torrents)
+        torrent->removeTag(tag);
+    m_tags.remove(tag);
+    m_storedTags = m_tags.tags().values();
+    emit tagRemoved(tag);
+    return true;
+}
+
+QVector<Torrent *> SessionImpl::taggedTorrents(const QString &tag) const
+{
+    const QSet<Torrent *> torrents = m_tags.torrents(tag);
+    return {torrents.cbegin(), torrents.cend()};
 }
 
 bool SessionImpl::isAutoTMMDisabledByDefault() const
@@ -1197,7 +1234,7 @@ void SessionImpl::prepareStartup()
 
         if (!m_refreshEnqueued)
         {
-            m_nativeSession->post_torrent_updates();
+            m_nativeSession->post_torrent_updates(TORRENT_STATUS_FLAGS);
             m_refreshEnqueued = true;
         }
 
@@ -2360,6 +2397,19 @@ bool SessionImpl::deleteTorrent(const TorrentID &id, const DeleteOption deleteOp
     if (!torrent) return false;
 
     qDebug("Deleting torrent with ID: %s", qUtf8Printable(torrent->id().toString()));
+
+    // The torrent is removed from the indexes first, so the counters
+    // are already up to date when the torrent removal is reported
+    if (const auto iter = m_categoryTorrents.find(torrent->category()); iter != m_categoryTorrents.end())
+    {
+        iter->remove(torrent);
+        if (iter->isEmpty())
+            m_categoryTorrents.erase(iter);
+    }
+    m_tags.removeTorrent(torrent, torrent->tagIDs());
+    updateStateIndex(torrent, torrent->stateFlags(), {});
+    m_trackerIndex.removeTorrent(torrent, trackerURLs(torrent->trackers()));
+
     emit torrentAboutToBeRemoved(torrent);
 
     if (const InfoHash infoHash = torrent->infoHash(); infoHash.isHybrid())
@@ -2392,18 +2442,12 @@ bool SessionImpl::deleteTorrent(const TorrentID &id, const DeleteOption deleteOp
     {
         m_removingTorrents[torrent->id()] = {torrent->name(), torrent->rootPath(), deleteOption};
 
-        if (m_moveStorageQueue.size() > 1)
+        // Delete "move storage job" for the deleted torrent
+        // (note: we shouldn't delete active job)
+        m_moveStorageQueue.removeIf([torrent](const MoveStorageJob &job)
         {
-            // Delete "move storage job" for the deleted torrent
-            // (note: we shouldn't delete active job)
-            const auto iter = std::find_if((m_moveStorageQueue.begin() + 1), m_moveStorageQueue.end()
-                                     , [torrent](const MoveStorageJob &job)
-            {
-                return job.torrentHandle == torrent->nativeHandle();
-            });
-            if (iter != m_moveStorageQueue.end())
-                m_moveStorageQueue.erase(iter);
-        }
+            return !job.isActive && (job.torrentHandle == torrent->nativeHandle());
+        });
 
         m_nativeSession->remove_torrent(torrent->nativeHandle(), lt::session::delete_files);
     }
@@ -2547,6 +2591,21 @@ void SessionImpl::bottomTorrentsQueuePos(const QVector<TorrentID> &ids)
     m_torrentsQueueChanged = true;
 }
 
+QString SessionImpl::internString(const QString &str)
+{
+    return m_stringPool.intern(str);
+}
+
+TagID SessionImpl::tagID(const QString &tag) const
+{
+    return m_tags.id(tag);
+}
+
+QString SessionImpl::tagName(const TagID id) const
+{
+    return m_tags.tag(id);
+}
+
 void SessionImpl::handleTorrentNeedSaveResumeData(const TorrentImpl *torrent)
 {
     if (m_needSaveResumeDataTorrents.empty())
@@ -2593,6 +2652,39 @@ qsizetype SessionImpl::torrentsCount() const
     return m_torrents.size();
 }
 
+QVector<Torrent *> SessionImpl::stateTorrents(const TorrentStateFlag flag) const
+{
+    const QSet<Torrent *> torrents = m_stateTorrents.value(flag);
+    return {torrents.cbegin(), torrents.cend()};
+}
+
+qsizetype SessionImpl::stateTorrentsCount(const TorrentStateFlag flag) const
+{
+    return m_stateTorrents.value(flag).size();
+}
+
+QString SessionImpl::trackerHost(const QString &trackerURL) const
+{
+    return m_trackerIndex.host(trackerURL);
+}
+
+QVector<Torrent *> SessionImpl::trackerHostTorrents(const QString &trackerHost) const
+{
+    const QSet<Torrent *> torrents = m_trackerIndex.hostTorrents(trackerHost);
+    return {torrents.cbegin(), torrents.cend()};
+}
+
+qsizetype SessionImpl::trackerHostTorrentsCount(const QString &trackerHost) const
+{
+    return m_trackerIndex.hostTorrentsCount(trackerHost);
+}
+
+QVector<Torrent *> SessionImpl::trackerURLTorrents(const QString &trackerURL) const
+{
+    const QSet<Torrent *> torrents = m_trackerIndex.torrents(trackerURL);
+    return {torrents.cbegin(), torrents.cend()};
+}
+
 bool SessionImpl::addTorrent(const QString &source, const AddTorrentParams &params)
 {
     // `source`: .torrent file path/url or magnet uri
@@ -3106,9 +3198,8 @@ void SessionImpl::saveResumeData()
         torrent->nativeHandle().save_resume_data(lt::torrent_handle::only_if_modified);
     m_numResumeData += m_torrents.size();
 
-    // clear queued storage move jobs except the current ongoing one
-    if (m_moveStorageQueue.size() > 1)
-        m_moveStorageQueue.resize(1);
+    // clear queued storage move jobs except the current ongoing ones
+    m_moveStorageQueue.removeIf([](const MoveStorageJob &job) { return !job.isActive; });
 
     QElapsedTimer timer;
     timer.start();
@@ -4865,19 +4956,35 @@ void SessionImpl::handleTorrentSavePathChanged(TorrentImpl *const torrent)
 
 void SessionImpl::handleTorrentCategoryChanged(TorrentImpl *const torrent, const QString &oldCategory)
 {
+    if (const auto iter = m_categoryTorrents.find(oldCategory); iter != m_categoryTorrents.end())
+    {
+        iter->remove(torrent);
+        if (iter->isEmpty())
+            m_categoryTorrents.erase(iter);
+    }
+    m_categoryTorrents[torrent->category()].insert(torrent);
+
     emit torrentCategoryChanged(torrent, oldCategory);
 }
 
 void SessionImpl::handleTorrentTagAdded(TorrentImpl *const torrent, const QString &tag)
 {
+    m_tags.addTorrentTag(torrent, m_tags.id(tag));
     emit torrentTagAdded(torrent, tag);
 }
 
 void SessionImpl::handleTorrentTagRemoved(TorrentImpl *const torrent, const QString &tag)
 {
+    m_tags.removeTorrentTag(torrent, m_tags.id(tag), !torrent->tagIDs().isEmpty());
     emit torrentTagRemoved(torrent, tag);
 }
 
+void SessionImpl::handleTorrentStateFlagsChanged(TorrentImpl *const torrent, const TorrentStateFlags prevFlags)
+{
+    // It is also called when the torrent is being constructed, so it is indexed before it is added
+    updateStateIndex(torrent, prevFlags, torrent->stateFlags());
+}
+
 void SessionImpl::handleTorrentSavingModeChanged(TorrentImpl *const torrent)
 {
     emit torrentSavingModeChanged(torrent);
@@ -4885,6 +4992,8 @@ void SessionImpl::handleTorrentSavingModeChanged(TorrentImpl *const torrent)
 
 void SessionImpl::handleTorrentTrackersAdded(TorrentImpl *const torrent, const QVector<TrackerEntry> &newTrackers)
 {
+    m_trackerIndex.addTrackers(torrent, trackerURLs(newTrackers));
+
     for (const TrackerEntry &newTracker : newTrackers)
         LogMsg(tr("Added tracker to torrent. Torrent: \"%1\". Tracker: \"%2\"").arg(torrent->name(), newTracker.url));
     emit trackersAdded(torrent, newTrackers);
@@ -4895,6 +5004,8 @@ void SessionImpl::handleTorrentTrackersAdded(TorrentImpl *const torrent, const Q
 
 void SessionImpl::handleTorrentTrackersRemoved(TorrentImpl *const torrent, const QStringList &deletedTrackers)
 {
+    m_trackerIndex.removeTrackers(torrent, deletedTrackers, !torrent->trackers().isEmpty());
+
     for (const QString &deletedTracker : deletedTrackers)
         LogMsg(tr("Removed tracker from torrent. Torrent: \"%1\". Tracker: \"%2\"").arg(torrent->name(), deletedTracker));
     emit trackersRemoved(torrent, deletedTrackers);
@@ -4903,8 +5014,44 @@ void SessionImpl::handleTorrentTrackersRemoved(TorrentImpl *const torrent, const
     emit trackersChanged(torrent);
 }
 
-void SessionImpl::handleTorrentTrackersChanged(TorrentImpl *const torrent)
+void SessionImpl::handleTorrentTrackersChanged(TorrentImpl *const torrent, const QVector<TrackerEntry> &prevTrackers)
 {
+    // Report the difference as separate additions and removals,
+    // so the tracker related data can be updated incrementally
+    const QVector<TrackerEntry> trackers = torrent->trackers();
+    const QStringList prevTrackerURLList = trackerURLs(prevTrackers);
+    const QStringList currentTrackerURLList = trackerURLs(trackers);
+    const QSet<QString> prevTrackerURLs {prevTrackerURLList.cbegin(), prevTrackerURLList.cend()};
+    const QSet<QString> currentTrackerURLs {currentTrackerURLList.cbegin(), currentTrackerURLList.cend()};
+
+    QStringList deletedTrackers;
+    for (const QString &prevTrackerURL : prevTrackerURLList)
+    {
+        if (!currentTrackerURLs.contains(prevTrackerURL))
+            deletedTrackers.append(prevTrackerURL);
+    }
+
+    QVector<TrackerEntry> newTrackers;
+    for (const TrackerEntry &tracker : trackers)
+    {
+        if (!prevTrackerURLs.contains(tracker.url))
+            newTrackers.append(tracker);
+    }
+
+    if (!deletedTrackers.isEmpty())
+    {
+        m_trackerIndex.removeTrackers(torrent, deletedTrackers, !trackers.isEmpty());
+        emit trackersRemoved(torrent, deletedTrackers);
+    }
+
+    if (!newTrackers.isEmpty())
+    {
+        m_trackerIndex.addTrackers(torrent, trackerURLs(newTrackers));
+        emit trackersAdded(torrent, newTrackers);
+    }
+
+    if (prevTrackers.isEmpty() != trackers.isEmpty())
+        emit trackerlessStateChanged(torrent, trackers.isEmpty());
     emit trackersChanged(torrent);
 }
 
@@ -5010,30 +5157,29 @@ bool SessionImpl::addMoveTorrentStorageJob(TorrentImpl *torrent, const Path &new
 
     const lt::torrent_handle torrentHandle = torrent->nativeHandle();
     const Path currentLocation = torrent->actualStorageLocation();
-    const bool torrentHasActiveJob = !m_moveStorageQueue.isEmpty() && (m_moveStorageQueue.first().torrentHandle == torrentHandle);
+    const auto activeJobIter = findActiveMoveTorrentStorageJob(torrentHandle);
+    const bool torrentHasActiveJob = (activeJobIter != m_moveStorageQueue.end());
+    const Path activeJobPath = torrentHasActiveJob ? activeJobIter->path : Path();
 
-    if (m_moveStorageQueue.size() > 1)
+    const auto iter = std::find_if(m_moveStorageQueue.begin(), m_moveStorageQueue.end()
+            , [&torrentHandle](const MoveStorageJob &job)
     {
-        auto iter = std::find_if((m_moveStorageQueue.begin() + 1), m_moveStorageQueue.end()
-                , [&torrentHandle](const MoveStorageJob &job)
-        {
-            return job.torrentHandle == torrentHandle;
-        });
+        return !job.isActive && (job.torrentHandle == torrentHandle);
+    });
 
-        if (iter != m_moveStorageQueue.end())
-        {
-            // remove existing inactive job
-            torrent->handleMoveStorageJobFinished(currentLocation, iter->context, torrentHasActiveJob);
-            LogMsg(tr("Torrent move canceled. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), iter->path.toString()));
-            m_moveStorageQueue.erase(iter);
-        }
+    if (iter != m_moveStorageQueue.end())
+    {
+        // remove existing inactive job
+        torrent->handleMoveStorageJobFinished(currentLocation, iter->context, torrentHasActiveJob);
+        LogMsg(tr("Torrent move canceled. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), iter->path.toString()));
+        m_moveStorageQueue.erase(iter);
     }
 
     if (torrentHasActiveJob)
     {
         // if there is active job for this torrent prevent creating meaningless
         // job that will move torrent to the same location as current one
-        if (m_moveStorageQueue.first().path == newPath)
+        if (activeJobPath == newPath)
         {
             LogMsg(tr("Failed to enqueue torrent move. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\". Reason: torrent is currently moving to the destination")
                    .arg(torrent->name(), currentLocation.toString(), newPath.toString()));
@@ -5050,16 +5196,104 @@ bool SessionImpl::addMoveTorrentStorageJob(TorrentImpl *torrent, const Path &new
         }
     }
 
-    const MoveStorageJob moveStorageJob {torrentHandle, newPath, mode, context};
+    MoveStorageJob moveStorageJob {torrentHandle, newPath, mode, context};
+    moveStorageJob.id = ++m_lastMoveStorageJobID;
+    moveStorageJob.size = torrent->completedSize();
     m_moveStorageQueue << moveStorageJob;
     LogMsg(tr("Enqueued torrent move. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), newPath.toString()));
 
-    if (m_moveStorageQueue.size() == 1)
-        moveTorrentStorage(moveStorageJob);
+    // Looking up the device of a path can be slow (e.g. it may wait for network filesystem),
+    // so it is done in the worker thread. The data will be moved from the destination of the active job, if any.
+    const Path sourcePath = torrentHasActiveJob ? activeJobPath : currentLocation;
+    invokeAsync([this, jobID = moveStorageJob.id, sourcePath, newPath]
+    {
+        const QByteArray sourceDevice = Utils::Fs::storageDevice(sourcePath);
+        const QByteArray destinationDevice = Utils::Fs::storageDevice(newPath);
+        const Path sourceMountPoint = Utils::Fs::mountPoint(sourcePath);
+        const Path destinationMountPoint = Utils::Fs::mountPoint(newPath);
+        QMetaObject::invokeMethod(this, [this, jobID, sourceDevice, destinationDevice, sourceMountPoint, destinationMountPoint]
+        {
+            handleMoveTorrentStorageJobDevicesResolved(jobID, sourceDevice, destinationDevice, sourceMountPoint, destinationMountPoint);
+        }, Qt::QueuedConnection);
+    });
 
     return true;
 }
 
+void SessionImpl::handleMoveTorrentStorageJobDevicesResolved(const quint64 jobID
+        , const QByteArray &sourceDevice, const QByteArray &destinationDevice
+        , const Path &sourceMountPoint, const Path &destinationMountPoint)
+{
+    const auto iter = std::find_if(m_moveStorageQueue.begin(), m_moveStorageQueue.end()
+            , [jobID](const MoveStorageJob &job) { return (job.id == jobID); });
+    // the job could be canceled in the meantime
+    if (iter == m_moveStorageQueue.end())
+        return;
+
+    iter->sourceDevice = sourceDevice;
+    iter->destinationDevice = destinationDevice;
+    iter->sourceMountPoint = sourceMountPoint;
+    iter->destinationMountPoint = destinationMountPoint;
+    iter->isDeviceResolved = true;
+
+    startMoveTorrentStorageJobs();
+}
+
+void SessionImpl::startMoveTorrentStorageJobs()
+{
+    // The jobs copying the data between different devices are run in parallel,
+    // while the ones reading from or writing to the same device are run one by one.
+    // The jobs within the same mount of the same device are just renaming, so they aren't limited.
+    // The jobs of the same torrent are run in order they were added.
+    const auto isDeviceBusy = [this](const QByteArray &device)
+    {
+        return !device.isEmpty() && m_moveStorageBusyDevices.contains(device);
+    };
+
+    QVector<lt::torrent_handle> busyTorrents;
+    int activeCrossDeviceJobsCount = 0;
+    for (const MoveStorageJob &job : asConst(m_moveStorageQueue))
+    {
+        if (!job.isActive)
+            continue;
+
+        busyTorrents.append(job.torrentHandle);
+        if (job.isCrossDevice())
+            ++activeCrossDeviceJobsCount;
+    }
+
+    for (MoveStorageJob &job : m_moveStorageQueue)
+    {
+        if (job.isActive || busyTorrents.contains(job.torrentHandle))
+            continue;
+
+        busyTorrents.append(job.torrentHandle);
+
+        if (!job.isDeviceResolved)
+            continue;
+
+        if (job.isCrossDevice())
+        {
+            if ((activeCrossDeviceJobsCount >= MAX_ACTIVE_MOVE_STORAGE_JOBS)
+                    || isDeviceBusy(job.sourceDevice) || isDeviceBusy(job.destinationDevice))
+            {
+                continue;
+            }
+
+            // unknown device (i.e. empty) can't be reserved
+            if (!job.sourceDevice.isEmpty())
+                m_moveStorageBusyDevices.insert(job.sourceDevice);
+            if (!job.destinationDevice.isEmpty())
+                m_moveStorageBusyDevices.insert(job.destinationDevice);
+            ++activeCrossDeviceJobsCount;
+        }
+
+        job.isActive = true;
+        job.elapsedTimer.start();
+        moveTorrentStorage(job);
+    }
+}
+
 void SessionImpl::moveTorrentStorage(const MoveStorageJob &job) const
 {
 #ifdef QBT_USES_LIBTORRENT2
@@ -5074,11 +5308,31 @@ void SessionImpl::moveTorrentStorage(const MoveStorageJob &job) const
     job.torrentHandle.move_storage(job.path.toString().toStdString(), toNative(job.mode));
 }
 
-void SessionImpl::handleMoveTorrentStorageJobFinished(const Path &newPath)
+QList<SessionImpl::MoveStorageJob>::iterator SessionImpl::findActiveMoveTorrentStorageJob(const lt::torrent_handle &torrentHandle)
+{
+    return std::find_if(m_moveStorageQueue.begin(), m_moveStorageQueue.end()
+            , [&torrentHandle](const MoveStorageJob &job)
+    {
+        return job.isActive && (job.torrentHandle == torrentHandle);
+    });
+}
+
+void SessionImpl::handleMoveTorrentStorageJobFinished(const lt::torrent_handle &torrentHandle, const Path &newPath)
 {
-    const MoveStorageJob finishedJob = m_moveStorageQueue.takeFirst();
-    if (!m_moveStorageQueue.isEmpty())
-        moveTorrentStorage(m_moveStorageQueue.first());
+    const auto finishedJobIter = findActiveMoveTorrentStorageJob(torrentHandle);
+    Q_ASSERT(finishedJobIter != m_moveStorageQueue.end());
+    if (finishedJobIter == m_moveStorageQueue.end()) [[unlikely]]
+        return;
+
+    const MoveStorageJob finishedJob = *finishedJobIter;
+    m_moveStorageQueue.erase(finishedJobIter);
+    if (finishedJob.isCrossDevice())
+    {
+        m_moveStorageBusyDevices.remove(finishedJob.sourceDevice);
+        m_moveStorageBusyDevices.remove(finishedJob.destinationDevice);
+    }
+
+    startMoveTorrentStorageJobs();
 
     const auto iter = std::find_if(m_moveStorageQueue.cbegin(), m_moveStorageQueue.cend()
             , [&finishedJob](const MoveStorageJob &job)
@@ -5296,13 +5550,18 @@ const CacheStatus &SessionImpl::cacheStatus() const
     return m_cacheStatus;
 }
 
+qint64 SessionImpl::internedStringsMemoryUsage() const
+{
+    return m_stringPool.memoryUsage();
+}
+
 void SessionImpl::enqueueRefresh()
 {
     Q_ASSERT(!m_refreshEnqueued);
 
     QTimer::singleShot(refreshInterval(), Qt::CoarseTimer, this, [this]
     {
-        m_nativeSession->post_torrent_updates();
+        m_nativeSession->post_torrent_updates(TORRENT_STATUS_FLAGS);
         m_nativeSession->post_session_stats();
 
         if (m_torrentsQueueChanged)
@@ -5583,6 +5842,9 @@ TorrentImpl *SessionImpl::createTorrent(const lt::torrent_handle &nativeHandle,
 {
     auto *const torrent = new TorrentImpl(this, m_nativeSession, nativeHandle, params);
     m_torrents.insert(torrent->id(), torrent);
+    m_categoryTorrents[torrent->category()].insert(torrent);
+    m_tags.addTorrent(torrent, torrent->tagIDs());
+    m_trackerIndex.addTorrent(torrent, trackerURLs(torrent->trackers()));
     if (const InfoHash infoHash = torrent->infoHash(); infoHash.isHybrid())
         m_hybridTorrentsByAltID.insert(TorrentID::fromSHA1Hash(infoHash.v1()), torrent);
 
@@ -5624,6 +5886,22 @@ TorrentImpl *SessionImpl::createTorrent(const lt::torrent_handle &nativeHandle,
     return torrent;
 }
 
+void SessionImpl::updateStateIndex(Torrent *torrent, const TorrentStateFlags prevFlags, const TorrentStateFlags flags)
+{
+    const auto changedFlags = (prevFlags ^ flags).toInt();
+    for (int flagValue = 1; flagValue <= changedFlags; flagValue <<= 1)
+    {
+        if (!(changedFlags & flagValue))
+            continue;
+
+        const auto flag = static_cast<TorrentStateFlag>(flagValue);
+        if (flags.testFlag(flag))
+            m_stateTorrents[flag].insert(torrent);
+        else
+            m_stateTorrents[flag].remove(torrent);
+    }
+}
+
 void SessionImpl::handleTorrentRemovedAlert(const lt::torrent_removed_alert *p)
 {
 #ifdef QBT_USES_LIBTORRENT2
@@ -5949,10 +6227,12 @@ void SessionImpl::handleAlertsDroppedAlert(const lt::alerts_dropped_alert *p) co
 
 void SessionImpl::handleStorageMovedAlert(const lt::storage_moved_alert *p)
 {
-    Q_ASSERT(!m_moveStorageQueue.isEmpty());
+    const auto currentJobIter = findActiveMoveTorrentStorageJob(p->handle);
+    Q_ASSERT(currentJobIter != m_moveStorageQueue.end());
+    if (currentJobIter == m_moveStorageQueue.end()) [[unlikely]]
+        return;
 
-    const MoveStorageJob &currentJob = m_moveStorageQueue.first();
-    Q_ASSERT(currentJob.torrentHandle == p->handle);
+    const MoveStorageJob &currentJob = *currentJobIter;
 
     const Path newPath {QString::fromUtf8(p->storage_path())};
     Q_ASSERT(newPath == currentJob.path);
@@ -5965,17 +6245,22 @@ void SessionImpl::handleStorageMovedAlert(const lt::storage_moved_alert *p)
 
     TorrentImpl *torrent = m_torrents.value(id);
     const QString torrentName = (torrent ? torrent->name() : id.toString());
-    LogMsg(tr("Moved torrent successfully. Torrent: \"%1\". Destination: \"%2\"").arg(torrentName, newPath.toString()));
+    const qint64 elapsedMSecs = std::max<qint64>(currentJob.elapsedTimer.elapsed(), 1);
+    LogMsg(tr("Moved torrent successfully. Torrent: \"%1\". Destination: \"%2\". Elapsed time: %3 s. Average speed: %4")
+           .arg(torrentName, newPath.toString(), QString::number((elapsedMSecs / 1000.0), 'f', 1)
+                , Utils::Misc::friendlyUnit((currentJob.size * 1000 / elapsedMSecs), true)));
 
-    handleMoveTorrentStorageJobFinished(newPath);
+    handleMoveTorrentStorageJobFinished(p->handle, newPath);
 }
 
 void SessionImpl::handleStorageMovedFailedAlert(const lt::storage_moved_failed_alert *p)
 {
-    Q_ASSERT(!m_moveStorageQueue.isEmpty());
+    const auto currentJobIter = findActiveMoveTorrentStorageJob(p->handle);
+    Q_ASSERT(currentJobIter != m_moveStorageQueue.end());
+    if (currentJobIter == m_moveStorageQueue.end()) [[unlikely]]
+        return;
 
-    const MoveStorageJob &currentJob = m_moveStorageQueue.first();
-    Q_ASSERT(currentJob.torrentHandle == p->handle);
+    const MoveStorageJob &currentJob = *currentJobIter;
 
 #ifdef QBT_USES_LIBTORRENT2
     const auto id = TorrentID::fromInfoHash(currentJob.torrentHandle.info_hashes());
@@ -5991,7 +6276,7 @@ void SessionImpl::handleStorageMovedFailedAlert(const lt::storage_moved_failed_a
     LogMsg(tr("Failed to move torrent. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\". Reason: \"%4\"")
            .arg(torrentName, currentLocation.toString(), currentJob.path.toString(), errorMessage), Log::WARNING);
 
-    handleMoveTorrentStorageJobFinished(currentLocation);
+    handleMoveTorrentStorageJobFinished(p->handle, currentLocation);
 }
 
 void SessionImpl::handleStateUpdateAlert(const lt::state_update_alert *p)
@@ -46,6 +46,7 @@
 
 #include "base/path.h"
 #include "base/settingvalue.h"
+#include "base/stringpool.h"
 #include "base/types.h"
 #include "base/utils/thread.h"
 #include "addtorrentparams.h"
@@ -53,6 +54,9 @@
 #include "categoryoptions.h"
 #include "session.h"
 #include "sessionstatus.h"
+#include "tagregistry.h"
+#include "trackerindex.h"
+#include "torrent.h"
 #include "torrentinfo.h"
 #include "trackerentry.h"
 
@@ -151,6 +155,7 @@ namespace BitTorrent
         bool addCategory(const QString &name, const CategoryOptions &options = {}) override;
         bool editCategory(const QString &name, const CategoryOptions &options) override;
         bool removeCategory(const QString &name) override;
+        QVector<Torrent *> categoryTorrents(const QString &categoryName) const override;
         bool isSubcategoriesEnabled() const override;
         void setSubcategoriesEnabled(bool value) override;
         bool useCategoryPathsInManualMode() const override;
@@ -163,6 +168,7 @@ namespace BitTorrent
         bool hasTag(const QString &tag) const override;
         bool addTag(const QString &tag) override;
         bool removeTag(const QString &tag) override;
+        QVector<Torrent *> taggedTorrents(const QString &tag) const override;
 
         bool isAutoTMMDisabledByDefault() const override;
         void setAutoTMMDisabledByDefault(bool value) override;
@@ -404,8 +410,15 @@ namespace BitTorrent
         Torrent *findTorrent(const InfoHash &infoHash) const override;
         QVector<Torrent *> torrents() const override;
         qsizetype torrentsCount() const override;
+        QVector<Torrent *> stateTorrents(TorrentStateFlag flag) const override;
+        qsizetype stateTorrentsCount(TorrentStateFlag flag) const override;
+        QString trackerHost(const QString &trackerURL) const override;
+        QVector<Torrent *> trackerHostTorrents(const QString &trackerHost) const override;
+        qsizetype trackerHostTorrentsCount(const QString &trackerHost) const override;
+        QVector<Torrent *> trackerURLTorrents(const QString &trackerURL) const override;
         const SessionStatus &status() const override;
         const CacheStatus &cacheStatus() const override;
+        qint64 internedStringsMemoryUsage() const override;
         bool isListening() const override;
 
         MaxRatioAction maxRatioAction() const override;
@@ -427,6 +440,9 @@ namespace BitTorrent
         void bottomTorrentsQueuePos(const QVector<TorrentID> &ids) override;
 
         // Torrent interface
+        QString internString(const QString &str);
+        TagID tagID(const QString &tag) const;
+        QString tagName(TagID id) const;
         void handleTorrentNeedSaveResumeData(const TorrentImpl *torrent);
         void handleTorrentSaveResumeDataRequested(const TorrentImpl *torrent);
         void handleTorrentSaveResumeDataFailed(const TorrentImpl *torrent);
@@ -436,6 +452,7 @@ namespace BitTorrent
         void handleTorrentCategoryChanged(TorrentImpl *torrent, const QString &oldCategory);
         void handleTorrentTagAdded(TorrentImpl *torrent, const QString &tag);
         void handleTorrentTagRemoved(TorrentImpl *torrent, const QString &tag);
+        void handleTorrentStateFlagsChanged(TorrentImpl *torrent, TorrentStateFlags prevFlags);
         void handleTorrentSavingModeChanged(TorrentImpl *torrent);
         void handleTorrentMetadataReceived(TorrentImpl *torrent);
         void handleTorrentPaused(TorrentImpl *torrent);
@@ -444,7 +461,7 @@ namespace BitTorrent
         void handleTorrentFinished(TorrentImpl *torrent);
         void handleTorrentTrackersAdded(TorrentImpl *torrent, const QVector<TrackerEntry> &newTrackers);
         void handleTorrentTrackersRemoved(TorrentImpl *torrent, const QStringList &deletedTrackers);
-        void handleTorrentTrackersChanged(TorrentImpl *torrent);
+        void handleTorrentTrackersChanged(TorrentImpl *torrent, const QVector<TrackerEntry> &prevTrackers);
         void handleTorrentUrlSeedsAdded(TorrentImpl *torrent, const QVector<QUrl> &newUrlSeeds);
         void handleTorrentUrlSeedsRemoved(TorrentImpl *torrent, const QVector<QUrl> &urlSeeds);
         void handleTorrentResumeDataReady(TorrentImpl *torrent, const LoadTorrentParams &data);
@@ -489,6 +506,24 @@ namespace BitTorrent
             Path path;
             MoveStorageMode mode {};
             MoveStorageContext context {};
+            quint64 id = 0;
+            // devices are looked up asynchronously, the job can't be started until they're known
+            bool isDeviceResolved = false;
+            QByteArray sourceDevice;
+            QByteArray destinationDevice;
+            Path sourceMountPoint;
+            Path destinationMountPoint;
+            qint64 size = 0;
+            bool isActive = false;
+            QElapsedTimer elapsedTimer;
+
+            // The data isn't copied when it is moved within the same mount of the same device (filesystem).
+            // Otherwise the files can't be renamed, e.g. between bind mounts or btrfs subvolumes of the same device.
+            bool isCrossDevice() const
+            {
+                return (sourceDevice.isEmpty() || (sourceDevice != destinationDevice)
+                        || sourceMountPoint.isEmpty() || (sourceMountPoint != destinationMountPoint));
+            }
         };
 
         struct RemovingTorrentData
@@ -563,6 +598,7 @@ namespace BitTorrent
 #endif
 
         TorrentImpl *createTorrent(const lt::torrent_handle &nativeHandle, const LoadTorrentParams &params);
+        void updateStateIndex(Torrent *torrent, TorrentStateFlags prevFlags, TorrentStateFlags flags);
 
         void saveResumeData();
         void saveTorrentsQueue();
@@ -570,8 +606,12 @@ namespace BitTorrent
 
         std::vector<lt::alert *> getPendingAlerts(lt::time_duration time = lt::time_duration::zero()) const;
 
+        void handleMoveTorrentStorageJobDevicesResolved(quint64 jobID, const QByteArray &sourceDevice, const QByteArray &destinationDevice
+                , const Path &sourceMountPoint, const Path &destinationMountPoint);
+        void startMoveTorrentStorageJobs();
         void moveTorrentStorage(const MoveStorageJob &job) const;
-        void handleMoveTorrentStorageJobFinished(const Path &newPath);
+        QList<MoveStorageJob>::iterator findActiveMoveTorrentStorageJob(const lt::torrent_handle &torrentHandle);
+        void handleMoveTorrentStorageJobFinished(const lt::torrent_handle &torrentHandle, const Path &newPath);
 
         void loadCategories();
         void storeCategories() const;
@@ -751,7 +791,14 @@ namespace BitTorrent
         QSet<TorrentID> m_needSaveResumeDataTorrents;
         QHash<TorrentID, TorrentID> m_changedTorrentIDs;
         QMap<QString, CategoryOptions> m_categories;
-        QSet<QString> m_tags;
+        // Torrents are indexed by their categories and tags,
+        // so the ones having some category or tag can be found quickly
+        QHash<QString, QSet<Torrent *>> m_categoryTorrents;
+        TagRegistry m_tags;
+        QHash<TorrentStateFlag, QSet<Torrent *>> m_stateTorrents;
+        TrackerIndex m_trackerIndex;
+        // Strings that are repeated in many torrents (e.g. tracker URLs)
+        StringPool m_stringPool;
 
         // This field holds amounts of peers reported by trackers in their responses to announces
         // (torrent.tracker_name.tracker_local_endpoint.num_peers)
@@ -767,7 +814,9 @@ namespace BitTorrent
         SessionStatus m_status;
         CacheStatus m_cacheStatus;
 
-        QList<MoveStorageJob> m_moveStorageQueue;
+        QList<MoveStorageJob> m_moveStorageQueue;  // both active and pending jobs in order they were added
+        QSet<QByteArray> m_moveStorageBusyDevices;  // source and destination devices of active cross-device jobs
+        quint64 m_lastMoveStorageJobID = 0;
 
         QString m_lastExternalIP;
 
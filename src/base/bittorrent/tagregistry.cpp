@@ -0,0 +1,138 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "tagregistry.h"
+
+bool BitTorrent::TagRegistry::contains(const QString &tag) const
+{
+    return m_ids.contains(tag);
+}
+
+BitTorrent::TagID BitTorrent::TagRegistry::id(const QString &tag) const
+{
+    return m_ids.value(tag, -1);
+}
+
+QString BitTorrent::TagRegistry::tag(const TagID id) const
+{
+    if ((id < 0) || (id >= m_entries.size()))
+        return {};
+
+    return m_entries[id].tag;
+}
+
+QSet<QString> BitTorrent::TagRegistry::tags() const
+{
+    return {m_ids.keyBegin(), m_ids.keyEnd()};
+}
+
+bool BitTorrent::TagRegistry::add(const QString &tag)
+{
+    if (tag.isEmpty() || m_ids.contains(tag))
+        return false;
+
+    TagID id = -1;
+    if (m_freeIDs.isEmpty())
+    {
+        id = m_entries.size();
+        m_entries.append({tag, {}});
+    }
+    else
+    {
+        id = m_freeIDs.takeLast();
+        m_entries[id].tag = tag;
+    }
+
+    m_ids.insert(tag, id);
+    return true;
+}
+
+bool BitTorrent::TagRegistry::remove(const QString &tag)
+{
+    const auto iter = m_ids.constFind(tag);
+    if (iter == m_ids.cend())
+        return false;
+
+    const TagID id = iter.value();
+    m_ids.erase(iter);
+
+    Entry &entry = m_entries[id];
+    Q_ASSERT(entry.torrents.isEmpty());
+    entry = {};
+    m_freeIDs.append(id);
+    return true;
+}
+
+QSet<BitTorrent::Torrent *> BitTorrent::TagRegistry::torrents(const QString &tag) const
+{
+    if (tag.isEmpty())
+        return m_untaggedTorrents;
+
+    const TagID id = this->id(tag);
+    if (id < 0)
+        return {};
+
+    return m_entries[id].torrents;
+}
+
+void BitTorrent::TagRegistry::addTorrent(Torrent *torrent, const TagIDList &tagIDs)
+{
+    if (tagIDs.isEmpty())
+    {
+        m_untaggedTorrents.insert(torrent);
+        return;
+    }
+
+    for (const TagID id : tagIDs)
+        m_entries[id].torrents.insert(torrent);
+}
+
+void BitTorrent::TagRegistry::removeTorrent(Torrent *torrent, const TagIDList &tagIDs)
+{
+    if (tagIDs.isEmpty())
+    {
+        m_untaggedTorrents.remove(torrent);
+        return;
+    }
+
+    for (const TagID id : tagIDs)
+        m_entries[id].torrents.remove(torrent);
+}
+
+void BitTorrent::TagRegistry::addTorrentTag(Torrent *torrent, const TagID tagID)
+{
+    m_untaggedTorrents.remove(torrent);
+    m_entries[tagID].torrents.insert(torrent);
+}
+
+void BitTorrent::TagRegistry::removeTorrentTag(Torrent *torrent, const TagID tagID, const bool hasOtherTags)
+{
+    m_entries[tagID].torrents.remove(torrent);
+    if (!hasOtherTags)
+        m_untaggedTorrents.insert(torrent);
+}
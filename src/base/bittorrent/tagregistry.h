@@ -0,0 +1,85 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+namespace BitTorrent
+{
+    class Torrent;
+
+    using TagID = int;
+    // Tag IDs of a torrent are kept sorted, so they can be found using binary search
+    using TagIDList = QList<TagID>;
+
+    // Assigns small integer IDs to the session tags, so the torrents can store
+    // compact lists of tag IDs instead of the tag strings. It also keeps the torrents
+    // having each of the tags, so they can be found without checking all the torrents.
+    class TagRegistry
+    {
+        Q_DISABLE_COPY_MOVE(TagRegistry)
+
+    public:
+        TagRegistry() = default;
+
+        bool contains(const QString &tag) const;
+        // Returns -1 if the tag isn't registered
+        TagID id(const QString &tag) const;
+        QString tag(TagID id) const;
+        QSet<QString> tags() const;
+
+        bool add(const QString &tag);
+        // The tag should be removed from its torrents before
+        bool remove(const QString &tag);
+
+        // Empty tag means untagged torrents
+        QSet<Torrent *> torrents(const QString &tag) const;
+
+        void addTorrent(Torrent *torrent, const TagIDList &tagIDs);
+        void removeTorrent(Torrent *torrent, const TagIDList &tagIDs);
+        void addTorrentTag(Torrent *torrent, TagID tagID);
+        void removeTorrentTag(Torrent *torrent, TagID tagID, bool hasOtherTags);
+
+    private:
+        struct Entry
+        {
+            QString tag;
+            QSet<Torrent *> torrents;
+        };
+
+        QHash<QString, TagID> m_ids;
+        QList<Entry> m_entries;  // indexed by tag ID
+        QList<TagID> m_freeIDs;  // IDs of removed tags that can be reused
+        QSet<Torrent *> m_untaggedTorrents;
+    };
+}
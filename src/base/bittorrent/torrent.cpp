@@ -40,6 +40,11 @@ namespace BitTorrent
         return ::qHash(static_cast<std::underlying_type_t<TorrentState>>(key), seed);
     }
 
+    std::size_t qHash(const TorrentStateFlag key, const std::size_t seed)
+    {
+        return ::qHash(static_cast<std::underlying_type_t<TorrentStateFlag>>(key), seed);
+    }
+
     // Torrent
 
     const qreal Torrent::USE_GLOBAL_RATIO = -2;
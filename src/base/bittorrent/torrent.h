@@ -31,12 +31,14 @@
 
 #include <QtContainerFwd>
 #include <QtTypes>
+#include <QFlags>
 #include <QMetaType>
 #include <QString>
 
 #include "base/3rdparty/expected.hpp"
 #include "base/pathfwd.h"
 #include "base/tagset.h"
+#include "tagregistry.h"
 #include "torrentcontenthandler.h"
 
 class QBitArray;
@@ -51,7 +53,9 @@ namespace BitTorrent
     class PeerInfo;
     class TorrentID;
     class TorrentInfo;
+    struct DiskIOStatus;
     struct PeerAddress;
+    struct TorrentMemoryUsage;
     struct TrackerEntry;
 
     // Using `Q_ENUM_NS()` without a wrapper namespace in our case is not advised
@@ -102,6 +106,27 @@ namespace BitTorrent
 
     std::size_t qHash(TorrentState key, std::size_t seed = 0);
 
+    // Properties of torrent state that torrents are filtered by.
+    // They are evaluated once when torrent state is updated, so they are cheap to check.
+    enum class TorrentStateFlag
+    {
+        Downloading = 1 << 0,
+        Seeding = 1 << 1,
+        Completed = 1 << 2,
+        Resumed = 1 << 3,
+        Paused = 1 << 4,
+        Active = 1 << 5,
+        Inactive = 1 << 6,
+        StalledUploading = 1 << 7,
+        StalledDownloading = 1 << 8,
+        Checking = 1 << 9,
+        Moving = 1 << 10,
+        Errored = 1 << 11
+    };
+    Q_DECLARE_FLAGS(TorrentStateFlags, TorrentStateFlag)
+
+    std::size_t qHash(TorrentStateFlag key, std::size_t seed = 0);
+
     class Torrent : public TorrentContentHandler
     {
         Q_OBJECT
@@ -198,7 +223,9 @@ namespace BitTorrent
         virtual bool belongsToCategory(const QString &category) const = 0;
         virtual bool setCategory(const QString &category) = 0;
 
-        virtual TagSet tags() const = 0;
+        virtual const TagSet &tags() const = 0;
+        // Cheaper than tags() when only the number of tags matters
+        virtual const TagIDList &tagIDs() const = 0;
         virtual bool hasTag(const QString &tag) const = 0;
         virtual bool addTag(const QString &tag) = 0;
         virtual bool removeTag(const QString &tag) = 0;
@@ -230,6 +257,7 @@ namespace BitTorrent
         virtual bool isSequentialDownload() const = 0;
         virtual bool hasFirstLastPiecePriority() const = 0;
         virtual TorrentState state() const = 0;
+        virtual TorrentStateFlags stateFlags() const = 0;
         virtual bool hasMissingFiles() const = 0;
         virtual bool hasError() const = 0;
         virtual int queuePosition() const = 0;
@@ -308,6 +336,9 @@ namespace BitTorrent
         virtual nonstd::expected<QByteArray, QString> exportToBuffer() const = 0;
         virtual nonstd::expected<void, QString> exportToFile(const Path &path) const = 0;
 
+        virtual TorrentMemoryUsage memoryUsage() const = 0;
+        virtual DiskIOStatus diskIOStatus() const = 0;
+
         virtual void fetchPeerInfo(std::function<void (QVector<PeerInfo>)> resultHandler) const = 0;
         virtual void fetchURLSeeds(std::function<void (QVector<QUrl>)> resultHandler) const = 0;
         virtual void fetchPieceAvailability(std::function<void (QVector<int>)> resultHandler) const = 0;
@@ -323,3 +354,4 @@ namespace BitTorrent
 }
 
 Q_DECLARE_METATYPE(BitTorrent::TorrentState)
+Q_DECLARE_OPERATORS_FOR_FLAGS(BitTorrent::TorrentStateFlags)
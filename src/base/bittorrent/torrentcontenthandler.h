@@ -38,6 +38,8 @@ namespace BitTorrent
 {
     class TorrentContentHandler : public QObject, public AbstractFileStorage
     {
+        Q_OBJECT
+
     public:
         using QObject::QObject;
 
@@ -46,6 +48,7 @@ namespace BitTorrent
         virtual Path actualFilePath(int fileIndex) const = 0;
         virtual QVector<DownloadPriority> filePriorities() const = 0;
         virtual QVector<qreal> filesProgress() const = 0;
+        virtual void fetchFilesProgress(std::function<void (QVector<qreal>)> resultHandler) const = 0;
         /**
          * @brief fraction of file pieces that are available at least from one peer
          *
@@ -57,5 +60,10 @@ namespace BitTorrent
 
         virtual void prioritizeFiles(const QVector<DownloadPriority> &priorities) = 0;
         virtual void flushCache() const = 0;
+
+    signals:
+        // Asynchronous renaming of the file has been finished
+        void fileRenamed(int fileIndex);
+        void fileRenameFailed(int fileIndex);
     };
 }
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <libtorrent/address.hpp>
 #include <libtorrent/alert_types.hpp>
@@ -43,12 +44,14 @@
 #include <libtorrent/info_hash.hpp>
 #endif
 
+#include <QAnyStringView>
 #include <QByteArray>
 #include <QDebug>
 #include <QPointer>
 #include <QSet>
 #include <QStringList>
 #include <QUrl>
+#include <QUtf8StringView>
 
 #include "base/global.h"
 #include "base/logger.h"
@@ -57,6 +60,7 @@
 #include "base/utils/io.h"
 #include "base/utils/string.h"
 #include "common.h"
+#include "diskiostats.h"
 #include "downloadpriority.h"
 #include "extensiondata.h"
 #include "loadtorrentparams.h"
@@ -65,11 +69,67 @@
 #include "peeraddress.h"
 #include "peerinfo.h"
 #include "sessionimpl.h"
+#include "torrentmemoryusage.h"
 
 using namespace BitTorrent;
 
 namespace
 {
+    // Approximate size of the node of binary tree based containers
+    const qint64 TREE_NODE_OVERHEAD = 4 * sizeof(void *);
+
+    // Only the data that isn't shared with other objects is taken into account
+    qint64 heapSize(const QString &str)
+    {
+        return str.isDetached() ? (str.capacity() * sizeof(QChar)) : 0;
+    }
+
+    qint64 heapSize(const Path &path)
+    {
+        return path.data().capacity() * sizeof(QChar);
+    }
+
+    TorrentStatusSnapshot makeStatusSnapshot(const lt::torrent_status &nativeStatus)
+    {
+        TorrentStatusSnapshot status;
+        status.state = nativeStatus.state;
+        status.flags = nativeStatus.flags;
+        status.errc = nativeStatus.errc;
+        status.queuePosition = nativeStatus.queue_position;
+        status.totalDone = nativeStatus.total_done;
+        status.totalWanted = nativeStatus.total_wanted;
+        status.totalWantedDone = nativeStatus.total_wanted_done;
+        status.totalFailedBytes = nativeStatus.total_failed_bytes;
+        status.totalRedundantBytes = nativeStatus.total_redundant_bytes;
+        status.totalPayloadDownload = nativeStatus.total_payload_download;
+        status.totalPayloadUpload = nativeStatus.total_payload_upload;
+        status.allTimeDownload = nativeStatus.all_time_download;
+        status.allTimeUpload = nativeStatus.all_time_upload;
+        status.downloadPayloadRate = nativeStatus.download_payload_rate;
+        status.uploadPayloadRate = nativeStatus.upload_payload_rate;
+        status.numSeeds = nativeStatus.num_seeds;
+        status.numPeers = nativeStatus.num_peers;
+        status.numComplete = nativeStatus.num_complete;
+        status.numIncomplete = nativeStatus.num_incomplete;
+        status.listSeeds = nativeStatus.list_seeds;
+        status.listPeers = nativeStatus.list_peers;
+        status.numConnections = nativeStatus.num_connections;
+        status.connectionsLimit = nativeStatus.connections_limit;
+        status.numPieces = nativeStatus.num_pieces;
+        status.progress = nativeStatus.progress;
+        status.distributedCopies = nativeStatus.distributed_copies;
+        status.addedTime = nativeStatus.added_time;
+        status.completedTime = nativeStatus.completed_time;
+        status.lastSeenComplete = nativeStatus.last_seen_complete;
+        status.lastUpload = nativeStatus.last_upload;
+        status.lastDownload = nativeStatus.last_download;
+        status.activeDuration = nativeStatus.active_duration;
+        status.finishedDuration = nativeStatus.finished_duration;
+        status.nextAnnounce = nativeStatus.next_announce;
+        status.needSaveResume = nativeStatus.need_save_resume;
+        return status;
+    }
+
     lt::announce_entry makeNativeAnnounceEntry(const QString &url, const int tier)
     {
         lt::announce_entry entry {url.toStdString()};
@@ -221,6 +281,24 @@ namespace
         return outVector;
     }
 
+    QVector<qreal> calculateFilesProgress(const TorrentInfo &torrentInfo, const QVector<std::int64_t> &filesProgress)
+    {
+        const int count = filesProgress.size();
+        QVector<qreal> result;
+        result.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            const std::int64_t progress = filesProgress.at(i);
+            const std::int64_t size = torrentInfo.fileSize(i);
+            if ((size <= 0) || (progress == size))
+                result << 1;
+            else
+                result << (progress / static_cast<qreal>(size));
+        }
+
+        return result;
+    }
+
     // This is an imitation of limit normalization performed by libtorrent itself.
     // We need perform it to keep cached values in line with the ones used by libtorrent.
     int cleanLimitValue(const int value)
@@ -245,8 +323,7 @@ TorrentImpl::TorrentImpl(SessionImpl *session, lt::session *nativeSession
     , m_name(params.name)
     , m_savePath(params.savePath)
     , m_downloadPath(params.downloadPath)
-    , m_category(params.category)
-    , m_tags(params.tags)
+    , m_category(session->internString(params.category))
     , m_ratioLimit(params.ratioLimit)
     , m_seedingTimeLimit(params.seedingTimeLimit)
     , m_inactiveSeedingTimeLimit(params.inactiveSeedingTimeLimit)
@@ -267,10 +344,9 @@ TorrentImpl::TorrentImpl(SessionImpl *session, lt::session *nativeSession
         m_torrentInfo = TorrentInfo(*m_ltAddTorrentParams.ti);
 
         Q_ASSERT(m_filePaths.isEmpty());
-        Q_ASSERT(m_indexMap.isEmpty());
         const int filesCount = m_torrentInfo.filesCount();
-        m_filePaths.reserve(filesCount);
-        m_indexMap.reserve(filesCount);
+        PathList filePaths;
+        filePaths.reserve(filesCount);
         m_filePriorities.reserve(filesCount);
         const std::vector<lt::download_priority_t> filePriorities =
                 resized(m_ltAddTorrentParams.file_priorities, m_ltAddTorrentParams.ti->num_files()
@@ -282,31 +358,39 @@ TorrentImpl::TorrentImpl(SessionImpl *session, lt::session *nativeSession
         for (int i = 0; i < filesCount; ++i)
         {
             const lt::file_index_t nativeIndex = m_torrentInfo.nativeIndexes().at(i);
-            m_indexMap[nativeIndex] = i;
 
             const auto fileIter = m_ltAddTorrentParams.renamed_files.find(nativeIndex);
             const Path filePath = ((fileIter != m_ltAddTorrentParams.renamed_files.end())
                         ? Path(fileIter->second).removedExtension(QB_EXT) : m_torrentInfo.filePath(i));
-            m_filePaths.append(filePath);
+            filePaths.append(filePath);
 
             const auto priority = LT::fromNative(filePriorities[LT::toUnderlyingType(nativeIndex)]);
             m_filePriorities.append(priority);
         }
+
+        setFilePaths(filePaths);
+    }
+
+    for (const QString &tag : params.tags)
+    {
+        if (const TagID tagID = m_session->tagID(tag); tagID >= 0)
+            m_tagIDs.append(tagID);
     }
+    std::sort(m_tagIDs.begin(), m_tagIDs.end());
 
     setStopCondition(params.stopCondition);
 
     const auto *extensionData = static_cast<ExtensionData *>(m_ltAddTorrentParams.userdata);
     m_trackerEntries.reserve(static_cast<decltype(m_trackerEntries)::size_type>(extensionData->trackers.size()));
     for (const lt::announce_entry &announceEntry : extensionData->trackers)
-        m_trackerEntries.append({QString::fromStdString(announceEntry.url), announceEntry.tier});
+        m_trackerEntries.append({m_session->internString(QString::fromStdString(announceEntry.url)), announceEntry.tier});
     m_urlSeeds.reserve(static_cast<decltype(m_urlSeeds)::size_type>(extensionData->urlSeeds.size()));
     for (const std::string &urlSeed : extensionData->urlSeeds)
         m_urlSeeds.append(QString::fromStdString(urlSeed));
-    m_nativeStatus = extensionData->status;
+    resetStatus(extensionData->status);
 
     if (hasMetadata())
-        updateProgress();
+        updateProgress(extensionData->status.pieces);
 
     updateState();
 
@@ -356,7 +440,7 @@ QString TorrentImpl::name() const
     if (hasMetadata())
         return m_torrentInfo.name();
 
-    const QString name = QString::fromStdString(m_nativeStatus.name);
+    const QString name = QString::fromStdString(m_ltAddTorrentParams.name);
     if (!name.isEmpty())
         return name;
 
@@ -391,12 +475,12 @@ qlonglong TorrentImpl::totalSize() const
 // size without the "don't download" files
 qlonglong TorrentImpl::wantedSize() const
 {
-    return m_nativeStatus.total_wanted;
+    return m_status.totalWanted;
 }
 
 qlonglong TorrentImpl::completedSize() const
 {
-    return m_nativeStatus.total_wanted_done;
+    return m_status.totalWantedDone;
 }
 
 qlonglong TorrentImpl::pieceLength() const
@@ -406,12 +490,12 @@ qlonglong TorrentImpl::pieceLength() const
 
 qlonglong TorrentImpl::wastedSize() const
 {
-    return (m_nativeStatus.total_failed_bytes + m_nativeStatus.total_redundant_bytes);
+    return (m_status.totalFailedBytes + m_status.totalRedundantBytes);
 }
 
 QString TorrentImpl::currentTracker() const
 {
-    return QString::fromStdString(m_nativeStatus.current_tracker);
+    return m_currentTracker;
 }
 
 Path TorrentImpl::savePath() const
@@ -474,11 +558,10 @@ Path TorrentImpl::rootPath() const
     if (!hasMetadata())
         return {};
 
-    const Path relativeRootPath = Path::findRootFolder(filePaths());
-    if (relativeRootPath.isEmpty())
+    if (m_relativeRootPath.isEmpty())
         return {};
 
-    return (actualStorageLocation() / relativeRootPath);
+    return (actualStorageLocation() / m_relativeRootPath);
 }
 
 Path TorrentImpl::contentPath() const
@@ -521,7 +604,7 @@ Path TorrentImpl::actualStorageLocation() const
     if (!hasMetadata())
         return {};
 
-    return Path(m_nativeStatus.save_path);
+    return m_actualStorageLocation;
 }
 
 void TorrentImpl::setAutoManaged(const bool enable)
@@ -558,8 +641,11 @@ void TorrentImpl::addTrackers(QVector<TrackerEntry> trackers)
         return;
 
     trackers = QVector<TrackerEntry>(newTrackers.cbegin(), newTrackers.cend());
-    for (const TrackerEntry &tracker : trackers)
+    for (TrackerEntry &tracker : trackers)
+    {
+        tracker.url = m_session->internString(tracker.url);
         m_nativeHandle.add_tracker(makeNativeAnnounceEntry(tracker.url, tracker.tier));
+    }
 
     m_trackerEntries.append(trackers);
     std::sort(m_trackerEntries.begin(), m_trackerEntries.end()
@@ -600,11 +686,14 @@ void TorrentImpl::replaceTrackers(QVector<TrackerEntry> trackers)
 
     std::vector<lt::announce_entry> nativeTrackers;
     nativeTrackers.reserve(trackers.size());
-    for (const TrackerEntry &tracker : trackers)
+    for (TrackerEntry &tracker : trackers)
+    {
+        tracker.url = m_session->internString(tracker.url);
         nativeTrackers.emplace_back(makeNativeAnnounceEntry(tracker.url, tracker.tier));
+    }
 
     m_nativeHandle.replace_trackers(nativeTrackers);
-    m_trackerEntries = trackers;
+    const QVector<TrackerEntry> prevTrackers = std::exchange(m_trackerEntries, trackers);
 
     // Clear the peer list if it's a private torrent since
     // we do not want to keep connecting with peers from old tracker.
@@ -612,7 +701,7 @@ void TorrentImpl::replaceTrackers(QVector<TrackerEntry> trackers)
         clearPeers();
 
     m_session->handleTorrentNeedSaveResumeData(this);
-    m_session->handleTorrentTrackersChanged(this);
+    m_session->handleTorrentTrackersChanged(this, prevTrackers);
 }
 
 QVector<QUrl> TorrentImpl::urlSeeds() const
@@ -737,7 +826,7 @@ bool TorrentImpl::connectPeer(const PeerAddress &peerAddress)
 
 bool TorrentImpl::needSaveResumeData() const
 {
-    return m_nativeStatus.need_save_resume;
+    return m_status.needSaveResume;
 }
 
 void TorrentImpl::saveResumeData(lt::resume_data_flags_t flags)
@@ -758,25 +847,25 @@ int TorrentImpl::piecesCount() const
 
 int TorrentImpl::piecesHave() const
 {
-    return m_nativeStatus.num_pieces;
+    return m_status.numPieces;
 }
 
 qreal TorrentImpl::progress() const
 {
     if (isChecking())
-        return m_nativeStatus.progress;
+        return m_status.progress;
 
-    if (m_nativeStatus.total_wanted == 0)
+    if (m_status.totalWanted == 0)
         return 0.;
 
-    if (m_nativeStatus.total_wanted_done == m_nativeStatus.total_wanted)
+    if (m_status.totalWantedDone == m_status.totalWanted)
         return 1.;
 
-    const qreal progress = static_cast<qreal>(m_nativeStatus.total_wanted_done) / m_nativeStatus.total_wanted;
+    const qreal progress = static_cast<qreal>(m_status.totalWantedDone) / m_status.totalWanted;
     if ((progress < 0.f) || (progress > 1.f))
     {
         LogMsg(tr("Unexpected data detected. Torrent: %1. Data: total_wanted=%2 total_wanted_done=%3.")
-                .arg(name(), QString::number(m_nativeStatus.total_wanted), QString::number(m_nativeStatus.total_wanted_done))
+                .arg(name(), QString::number(m_status.totalWanted), QString::number(m_status.totalWantedDone))
                 , Log::WARNING);
     }
 
@@ -799,14 +888,27 @@ bool TorrentImpl::belongsToCategory(const QString &category) const
     return (m_session->isSubcategoriesEnabled() && m_category.startsWith(category + u'/'));
 }
 
-TagSet TorrentImpl::tags() const
+const TagSet &TorrentImpl::tags() const
 {
-    return m_tags;
+    if (!m_tags)
+    {
+        m_tags.emplace();
+        for (const TagID tagID : m_tagIDs)
+            m_tags->insert(m_session->tagName(tagID));
+    }
+
+    return *m_tags;
+}
+
+const TagIDList &TorrentImpl::tagIDs() const
+{
+    return m_tagIDs;
 }
 
 bool TorrentImpl::hasTag(const QString &tag) const
 {
-    return m_tags.contains(tag);
+    const TagID tagID = m_session->tagID(tag);
+    return (tagID >= 0) && std::binary_search(m_tagIDs.cbegin(), m_tagIDs.cend(), tagID);
 }
 
 bool TorrentImpl::addTag(const QString &tag)
@@ -821,7 +923,9 @@ bool TorrentImpl::addTag(const QString &tag)
         if (!m_session->addTag(tag))
             return false;
     }
-    m_tags.insert(tag);
+    const TagID tagID = m_session->tagID(tag);
+    m_tagIDs.insert(std::lower_bound(m_tagIDs.cbegin(), m_tagIDs.cend(), tagID), tagID);
+    m_tags.reset();
     m_session->handleTorrentNeedSaveResumeData(this);
     m_session->handleTorrentTagAdded(this, tag);
     return true;
@@ -829,24 +933,29 @@ bool TorrentImpl::addTag(const QString &tag)
 
 bool TorrentImpl::removeTag(const QString &tag)
 {
-    if (m_tags.remove(tag))
-    {
-        m_session->handleTorrentNeedSaveResumeData(this);
-        m_session->handleTorrentTagRemoved(this, tag);
-        return true;
-    }
-    return false;
+    const TagID tagID = m_session->tagID(tag);
+    const auto iter = std::lower_bound(m_tagIDs.cbegin(), m_tagIDs.cend(), tagID);
+    if ((tagID < 0) || (iter == m_tagIDs.cend()) || (*iter != tagID))
+        return false;
+
+    m_tagIDs.erase(iter);
+    m_tags.reset();
+    m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentTagRemoved(this, tag);
+    return true;
 }
 
 void TorrentImpl::removeAllTags()
 {
-    for (const QString &tag : asConst(tags()))
+    // the cached tags are reset by removeTag(), so they are copied
+    const TagSet tags = this->tags();
+    for (const QString &tag : tags)
         removeTag(tag);
 }
 
 QDateTime TorrentImpl::addedTime() const
 {
-    return QDateTime::fromSecsSinceEpoch(m_nativeStatus.added_time);
+    return QDateTime::fromSecsSinceEpoch(m_status.addedTime);
 }
 
 qreal TorrentImpl::ratioLimit() const
@@ -866,6 +975,9 @@ int TorrentImpl::inactiveSeedingTimeLimit() const
 
 Path TorrentImpl::filePath(const int index) const
 {
+    if (m_filePaths.isEmpty())
+        return m_torrentInfo.filePath(index);
+
     Q_ASSERT(index >= 0);
     Q_ASSERT(index < m_filePaths.size());
 
@@ -891,9 +1003,38 @@ qlonglong TorrentImpl::fileSize(const int index) const
 
 PathList TorrentImpl::filePaths() const
 {
+    if (m_filePaths.isEmpty())
+        return m_torrentInfo.filePaths();
+
     return m_filePaths;
 }
 
+void TorrentImpl::setFilePaths(const PathList &filePaths)
+{
+    m_filePaths.clear();
+    for (int i = 0; i < filePaths.size(); ++i)
+    {
+        if (filePaths[i].data() != m_torrentInfo.filePath(i).data())
+        {
+            m_filePaths = filePaths;
+            break;
+        }
+    }
+
+    m_relativeRootPath = Path::findRootFolder(filePaths);
+}
+
+int TorrentImpl::fileIndexOf(const lt::file_index_t nativeIndex) const
+{
+    // Native indexes are sorted and they have gaps in place of pad files only
+    const QVector<lt::file_index_t> nativeIndexes = m_torrentInfo.nativeIndexes();
+    const auto iter = std::lower_bound(nativeIndexes.cbegin(), nativeIndexes.cend(), nativeIndex);
+    if ((iter == nativeIndexes.cend()) || (*iter != nativeIndex))
+        return -1;
+
+    return static_cast<int>(iter - nativeIndexes.cbegin());
+}
+
 QVector<DownloadPriority> TorrentImpl::filePriorities() const
 {
     return m_filePriorities;
@@ -913,14 +1054,14 @@ bool TorrentImpl::isQueued() const
 {
     // Torrent is Queued if it isn't in Paused state but paused internally
     return (!isPaused()
-            && (m_nativeStatus.flags & lt::torrent_flags::auto_managed)
-            && (m_nativeStatus.flags & lt::torrent_flags::paused));
+            && (m_status.flags & lt::torrent_flags::auto_managed)
+            && (m_status.flags & lt::torrent_flags::paused));
 }
 
 bool TorrentImpl::isChecking() const
 {
-    return ((m_nativeStatus.state == lt::torrent_status::checking_files)
-            || (m_nativeStatus.state == lt::torrent_status::checking_resume_data));
+    return ((m_status.state == lt::torrent_status::checking_files)
+            || (m_status.state == lt::torrent_status::checking_resume_data));
 }
 
 bool TorrentImpl::isDownloading() const
@@ -1019,8 +1160,8 @@ bool TorrentImpl::isErrored() const
 
 bool TorrentImpl::isFinished() const
 {
-    return ((m_nativeStatus.state == lt::torrent_status::finished)
-            || (m_nativeStatus.state == lt::torrent_status::seeding));
+    return ((m_status.state == lt::torrent_status::finished)
+            || (m_status.state == lt::torrent_status::seeding));
 }
 
 bool TorrentImpl::isForced() const
@@ -1030,7 +1171,7 @@ bool TorrentImpl::isForced() const
 
 bool TorrentImpl::isSequentialDownload() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::sequential_download);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::sequential_download);
 }
 
 bool TorrentImpl::hasFirstLastPiecePriority() const
@@ -1043,9 +1184,14 @@ TorrentState TorrentImpl::state() const
     return m_state;
 }
 
+TorrentStateFlags TorrentImpl::stateFlags() const
+{
+    return m_stateFlags;
+}
+
 void TorrentImpl::updateState()
 {
-    if (m_nativeStatus.state == lt::torrent_status::checking_resume_data)
+    if (m_status.state == lt::torrent_status::checking_resume_data)
     {
         m_state = TorrentState::CheckingResumeData;
     }
@@ -1070,7 +1216,7 @@ void TorrentImpl::updateState()
         else
             m_state = isForced() ? TorrentState::ForcedDownloadingMetadata : TorrentState::DownloadingMetadata;
     }
-    else if ((m_nativeStatus.state == lt::torrent_status::checking_files) && !isPaused())
+    else if ((m_status.state == lt::torrent_status::checking_files) && !isPaused())
     {
         // If the torrent is not just in the "checking" state, but is being actually checked
         m_state = m_hasFinishedStatus ? TorrentState::CheckingUploading : TorrentState::CheckingDownloading;
@@ -1083,7 +1229,7 @@ void TorrentImpl::updateState()
             m_state = TorrentState::QueuedUploading;
         else if (isForced())
             m_state = TorrentState::ForcedUploading;
-        else if (m_nativeStatus.upload_payload_rate > 0)
+        else if (m_status.uploadPayloadRate > 0)
             m_state = TorrentState::Uploading;
         else
             m_state = TorrentState::StalledUploading;
@@ -1096,11 +1242,56 @@ void TorrentImpl::updateState()
             m_state = TorrentState::QueuedDownloading;
         else if (isForced())
             m_state = TorrentState::ForcedDownloading;
-        else if (m_nativeStatus.download_payload_rate > 0)
+        else if (m_status.downloadPayloadRate > 0)
             m_state = TorrentState::Downloading;
         else
             m_state = TorrentState::StalledDownloading;
     }
+
+    updateStateFlags();
+}
+
+void TorrentImpl::updateStateFlags()
+{
+    TorrentStateFlags flags;
+    if (isDownloading())
+        flags |= TorrentStateFlag::Downloading;
+    if (isUploading())
+        flags |= TorrentStateFlag::Seeding;
+    if (isCompleted())
+        flags |= TorrentStateFlag::Completed;
+    flags |= (isPaused() ? TorrentStateFlag::Paused : TorrentStateFlag::Resumed);
+    flags |= (isActive() ? TorrentStateFlag::Active : TorrentStateFlag::Inactive);
+
+    switch (m_state)
+    {
+    case TorrentState::StalledUploading:
+        flags |= TorrentStateFlag::StalledUploading;
+        break;
+    case TorrentState::StalledDownloading:
+        flags |= TorrentStateFlag::StalledDownloading;
+        break;
+    case TorrentState::CheckingUploading:
+    case TorrentState::CheckingDownloading:
+    case TorrentState::CheckingResumeData:
+        flags |= TorrentStateFlag::Checking;
+        break;
+    case TorrentState::Moving:
+        flags |= TorrentStateFlag::Moving;
+        break;
+    case TorrentState::MissingFiles:
+    case TorrentState::Error:
+        flags |= TorrentStateFlag::Errored;
+        break;
+    default:
+        break;
+    }
+
+    if (flags == m_stateFlags)
+        return;
+
+    const TorrentStateFlags prevFlags = std::exchange(m_stateFlags, flags);
+    m_session->handleTorrentStateFlagsChanged(this, prevFlags);
 }
 
 bool TorrentImpl::hasMetadata() const
@@ -1115,20 +1306,20 @@ bool TorrentImpl::hasMissingFiles() const
 
 bool TorrentImpl::hasError() const
 {
-    return (m_nativeStatus.errc || (m_nativeStatus.flags & lt::torrent_flags::upload_mode));
+    return (m_status.errc || (m_status.flags & lt::torrent_flags::upload_mode));
 }
 
 int TorrentImpl::queuePosition() const
 {
-    return static_cast<int>(m_nativeStatus.queue_position);
+    return static_cast<int>(m_status.queuePosition);
 }
 
 QString TorrentImpl::error() const
 {
-    if (m_nativeStatus.errc)
-        return QString::fromLocal8Bit(m_nativeStatus.errc.message().c_str());
+    if (m_status.errc)
+        return QString::fromLocal8Bit(m_status.errc.message().c_str());
 
-    if (m_nativeStatus.flags & lt::torrent_flags::upload_mode)
+    if (m_status.flags & lt::torrent_flags::upload_mode)
     {
         return tr("Couldn't write to file. Reason: \"%1\". Torrent is now in \"upload only\" mode.")
             .arg(QString::fromLocal8Bit(m_lastFileError.error.message().c_str()));
@@ -1139,22 +1330,22 @@ QString TorrentImpl::error() const
 
 qlonglong TorrentImpl::totalDownload() const
 {
-    return m_nativeStatus.all_time_download;
+    return m_status.allTimeDownload;
 }
 
 qlonglong TorrentImpl::totalUpload() const
 {
-    return m_nativeStatus.all_time_upload;
+    return m_status.allTimeUpload;
 }
 
 qlonglong TorrentImpl::activeTime() const
 {
-    return lt::total_seconds(m_nativeStatus.active_duration);
+    return lt::total_seconds(m_status.activeDuration);
 }
 
 qlonglong TorrentImpl::finishedTime() const
 {
-    return lt::total_seconds(m_nativeStatus.finished_duration);
+    return lt::total_seconds(m_status.finishedDuration);
 }
 
 qlonglong TorrentImpl::eta() const
@@ -1220,80 +1411,68 @@ QVector<qreal> TorrentImpl::filesProgress() const
     if (m_completedFiles.count(true) == count)
         return QVector<qreal>(count, 1);
 
-    QVector<qreal> result;
-    result.reserve(count);
-    for (int i = 0; i < count; ++i)
-    {
-        const int64_t progress = m_filesProgress.at(i);
-        const int64_t size = fileSize(i);
-        if ((size <= 0) || (progress == size))
-            result << 1;
-        else
-            result << (progress / static_cast<qreal>(size));
-    }
-
-    return result;
+    return calculateFilesProgress(m_torrentInfo, m_filesProgress);
 }
 
 int TorrentImpl::seedsCount() const
 {
-    return m_nativeStatus.num_seeds;
+    return m_status.numSeeds;
 }
 
 int TorrentImpl::peersCount() const
 {
-    return m_nativeStatus.num_peers;
+    return m_status.numPeers;
 }
 
 int TorrentImpl::leechsCount() const
 {
-    return (m_nativeStatus.num_peers - m_nativeStatus.num_seeds);
+    return (m_status.numPeers - m_status.numSeeds);
 }
 
 int TorrentImpl::totalSeedsCount() const
 {
-    return (m_nativeStatus.num_complete > -1) ? m_nativeStatus.num_complete : m_nativeStatus.list_seeds;
+    return (m_status.numComplete > -1) ? m_status.numComplete : m_status.listSeeds;
 }
 
 int TorrentImpl::totalPeersCount() const
 {
-    const int peers = m_nativeStatus.num_complete + m_nativeStatus.num_incomplete;
-    return (peers > -1) ? peers : m_nativeStatus.list_peers;
+    const int peers = m_status.numComplete + m_status.numIncomplete;
+    return (peers > -1) ? peers : m_status.listPeers;
 }
 
 int TorrentImpl::totalLeechersCount() const
 {
-    return (m_nativeStatus.num_incomplete > -1) ? m_nativeStatus.num_incomplete : (m_nativeStatus.list_peers - m_nativeStatus.list_seeds);
+    return (m_status.numIncomplete > -1) ? m_status.numIncomplete : (m_status.listPeers - m_status.listSeeds);
 }
 
 QDateTime TorrentImpl::lastSeenComplete() const
 {
-    if (m_nativeStatus.last_seen_complete > 0)
-        return QDateTime::fromSecsSinceEpoch(m_nativeStatus.last_seen_complete);
+    if (m_status.lastSeenComplete > 0)
+        return QDateTime::fromSecsSinceEpoch(m_status.lastSeenComplete);
     else
         return {};
 }
 
 QDateTime TorrentImpl::completedTime() const
 {
-    if (m_nativeStatus.completed_time > 0)
-        return QDateTime::fromSecsSinceEpoch(m_nativeStatus.completed_time);
+    if (m_status.completedTime > 0)
+        return QDateTime::fromSecsSinceEpoch(m_status.completedTime);
     else
         return {};
 }
 
 qlonglong TorrentImpl::timeSinceUpload() const
 {
-    if (m_nativeStatus.last_upload.time_since_epoch().count() == 0)
+    if (m_status.lastUpload.time_since_epoch().count() == 0)
         return -1;
-    return lt::total_seconds(lt::clock_type::now() - m_nativeStatus.last_upload);
+    return lt::total_seconds(lt::clock_type::now() - m_status.lastUpload);
 }
 
 qlonglong TorrentImpl::timeSinceDownload() const
 {
-    if (m_nativeStatus.last_download.time_since_epoch().count() == 0)
+    if (m_status.lastDownload.time_since_epoch().count() == 0)
         return -1;
-    return lt::total_seconds(lt::clock_type::now() - m_nativeStatus.last_download);
+    return lt::total_seconds(lt::clock_type::now() - m_status.lastDownload);
 }
 
 qlonglong TorrentImpl::timeSinceActivity() const
@@ -1317,22 +1496,22 @@ int TorrentImpl::uploadLimit() const
 
 bool TorrentImpl::superSeeding() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::super_seeding);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::super_seeding);
 }
 
 bool TorrentImpl::isDHTDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_dht);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_dht);
 }
 
 bool TorrentImpl::isPEXDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_pex);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_pex);
 }
 
 bool TorrentImpl::isLSDDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_lsd);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_lsd);
 }
 
 QVector<PeerInfo> TorrentImpl::peers() const
@@ -1377,7 +1556,7 @@ QVector<int> TorrentImpl::pieceAvailability() const
 
 qreal TorrentImpl::distributedCopies() const
 {
-    return m_nativeStatus.distributed_copies;
+    return m_status.distributedCopies;
 }
 
 qreal TorrentImpl::maxRatio() const
@@ -1406,11 +1585,11 @@ int TorrentImpl::maxInactiveSeedingTime() const
 
 qreal TorrentImpl::realRatio() const
 {
-    const int64_t upload = m_nativeStatus.all_time_upload;
+    const int64_t upload = m_status.allTimeUpload;
     // special case for a seeder who lost its stats, also assume nobody will import a 99% done torrent
-    const int64_t download = (m_nativeStatus.all_time_download < (m_nativeStatus.total_done * 0.01))
-        ? m_nativeStatus.total_done
-        : m_nativeStatus.all_time_download;
+    const int64_t download = (m_status.allTimeDownload < (m_status.totalDone * 0.01))
+        ? m_status.totalDone
+        : m_status.allTimeDownload;
 
     if (download == 0)
         return (upload == 0) ? 0 : MAX_RATIO;
@@ -1423,38 +1602,38 @@ qreal TorrentImpl::realRatio() const
 int TorrentImpl::uploadPayloadRate() const
 {
     // workaround: suppress the speed for paused state
-    return isPaused() ? 0 : m_nativeStatus.upload_payload_rate;
+    return isPaused() ? 0 : m_status.uploadPayloadRate;
 }
 
 int TorrentImpl::downloadPayloadRate() const
 {
     // workaround: suppress the speed for paused state
-    return isPaused() ? 0 : m_nativeStatus.download_payload_rate;
+    return isPaused() ? 0 : m_status.downloadPayloadRate;
 }
 
 qlonglong TorrentImpl::totalPayloadUpload() const
 {
-    return m_nativeStatus.total_payload_upload;
+    return m_status.totalPayloadUpload;
 }
 
 qlonglong TorrentImpl::totalPayloadDownload() const
 {
-    return m_nativeStatus.total_payload_download;
+    return m_status.totalPayloadDownload;
 }
 
 int TorrentImpl::connectionsCount() const
 {
-    return m_nativeStatus.num_connections;
+    return m_status.numConnections;
 }
 
 int TorrentImpl::connectionsLimit() const
 {
-    return m_nativeStatus.connections_limit;
+    return m_status.connectionsLimit;
 }
 
 qlonglong TorrentImpl::nextAnnounce() const
 {
-    return lt::total_seconds(m_nativeStatus.next_announce);
+    return lt::total_seconds(m_status.nextAnnounce);
 }
 
 void TorrentImpl::setName(const QString &name)
@@ -1475,7 +1654,7 @@ bool TorrentImpl::setCategory(const QString &category)
             return false;
 
         const QString oldCategory = m_category;
-        m_category = category;
+        m_category = m_session->internString(category);
         m_session->handleTorrentNeedSaveResumeData(this);
         m_session->handleTorrentCategoryChanged(this, oldCategory);
 
@@ -1509,7 +1688,7 @@ void TorrentImpl::forceRecheck()
     m_nativeHandle.force_recheck();
     // We have to force update the cached state, otherwise someone will be able to get
     // an incorrect one during the interval until the cached state is updated in a regular way.
-    m_nativeStatus.state = lt::torrent_status::checking_resume_data;
+    m_status.state = lt::torrent_status::checking_resume_data;
 
     m_hasMissingFiles = false;
     m_unchecked = false;
@@ -1517,8 +1696,7 @@ void TorrentImpl::forceRecheck()
     m_completedFiles.fill(false);
     m_filesProgress.fill(0);
     m_pieces.fill(false);
-    m_nativeStatus.pieces.clear_all();
-    m_nativeStatus.num_pieces = 0;
+    m_status.numPieces = 0;
 
     if (isPaused())
     {
@@ -1533,12 +1711,12 @@ void TorrentImpl::setSequentialDownload(const bool enable)
     if (enable)
     {
         m_nativeHandle.set_flags(lt::torrent_flags::sequential_download);
-        m_nativeStatus.flags |= lt::torrent_flags::sequential_download;  // prevent return cached value
+        m_status.flags |= lt::torrent_flags::sequential_download;  // prevent return cached value
     }
     else
     {
         m_nativeHandle.unset_flags(lt::torrent_flags::sequential_download);
-        m_nativeStatus.flags &= ~lt::torrent_flags::sequential_download;  // prevent return cached value
+        m_status.flags &= ~lt::torrent_flags::sequential_download;  // prevent return cached value
     }
 
     m_session->handleTorrentNeedSaveResumeData(this);
@@ -1623,9 +1801,9 @@ TrackerEntry TorrentImpl::updateTrackerEntry(const lt::announce_entry &announceE
 
 std::shared_ptr<const libtorrent::torrent_info> TorrentImpl::nativeTorrentInfo() const
 {
-    if (m_nativeStatus.torrent_file.expired())
-        m_nativeStatus.torrent_file = m_nativeHandle.torrent_file();
-    return m_nativeStatus.torrent_file.lock();
+    if (m_nativeTorrentInfo.expired())
+        m_nativeTorrentInfo = m_nativeHandle.torrent_file();
+    return m_nativeTorrentInfo.lock();
 }
 
 void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathList &fileNames)
@@ -1636,14 +1814,16 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
 
     const std::shared_ptr<lt::torrent_info> metadata = std::const_pointer_cast<lt::torrent_info>(nativeTorrentInfo());
     m_torrentInfo = TorrentInfo(*metadata);
+    PathList filePaths;
+    filePaths.reserve(filesCount());
     m_filePriorities.reserve(filesCount());
     const auto nativeIndexes = m_torrentInfo.nativeIndexes();
     p.file_priorities = resized(p.file_priorities, metadata->files().num_files()
                                 , LT::toNative(p.file_priorities.empty() ? DownloadPriority::Normal : DownloadPriority::Ignored));
 
     m_completedFiles.fill(static_cast<bool>(p.flags & lt::torrent_flags::seed_mode), filesCount());
+    // The progress is calculated from scratch when the torrent is reloaded below
     m_filesProgress.resize(filesCount());
-    updateProgress();
 
     for (int i = 0; i < fileNames.size(); ++i)
     {
@@ -1653,7 +1833,7 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
         p.renamed_files[nativeIndex] = actualFilePath.toString().toStdString();
 
         const Path filePath = actualFilePath.removedExtension(QB_EXT);
-        m_filePaths.append(filePath);
+        filePaths.append(filePath);
 
         lt::download_priority_t &nativePriority = p.file_priorities[LT::toUnderlyingType(nativeIndex)];
         if ((nativePriority != lt::dont_download) && m_session->isFilenameExcluded(filePath.filename()))
@@ -1661,6 +1841,7 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
         const auto priority = LT::fromNative(nativePriority);
         m_filePriorities.append(priority);
     }
+    setFilePaths(filePaths);
     p.save_path = savePath.toString().toStdString();
     p.ti = metadata;
 
@@ -1693,8 +1874,7 @@ void TorrentImpl::reload()
     m_completedFiles.fill(false);
     m_filesProgress.fill(0);
     m_pieces.fill(false);
-    m_nativeStatus.pieces.clear_all();
-    m_nativeStatus.num_pieces = 0;
+    m_status.numPieces = 0;
 
     const auto queuePos = m_nativeHandle.queue_position();
 
@@ -1723,11 +1903,11 @@ void TorrentImpl::reload()
     p.userdata = LTClientData(extensionData);
     m_nativeHandle = m_nativeSession->add_torrent(p);
 
-    m_nativeStatus = extensionData->status;
+    resetStatus(extensionData->status);
 
     if (queuePos >= lt::queue_position_t {})
         m_nativeHandle.queue_position_set(queuePos);
-    m_nativeStatus.queue_position = queuePos;
+    m_status.queuePosition = queuePos;
 
     updateState();
 }
@@ -1738,6 +1918,7 @@ void TorrentImpl::pause()
     {
         m_stopCondition = StopCondition::None;
         m_isStopped = true;
+        updateStateFlags();
         m_session->handleTorrentNeedSaveResumeData(this);
         m_session->handleTorrentPaused(this);
     }
@@ -1773,6 +1954,7 @@ void TorrentImpl::resume(const TorrentOperatingMode mode)
     if (m_isStopped)
     {
         m_isStopped = false;
+        updateStateFlags();
         m_session->handleTorrentNeedSaveResumeData(this);
         m_session->handleTorrentResumed(this);
     }
@@ -1828,7 +2010,7 @@ void TorrentImpl::handleMoveStorageJobFinished(const Path &path, const MoveStora
     else if (context == MoveStorageContext::ChangeDownloadPath)
         m_downloadPath = path;
     m_storageIsMoving = hasOutstandingJob;
-    m_nativeStatus.save_path = path.toString().toStdString();
+    m_actualStorageLocation = path;
 
     m_session->handleTorrentSavePathChanged(this);
     m_session->handleTorrentNeedSaveResumeData(this);
@@ -1842,7 +2024,7 @@ void TorrentImpl::handleMoveStorageJobFinished(const Path &path, const MoveStora
         {
             // it can be moved to the proper location
             m_hasMissingFiles = false;
-            m_ltAddTorrentParams.save_path = m_nativeStatus.save_path;
+            m_ltAddTorrentParams.save_path = m_actualStorageLocation.toString().toStdString();
             m_ltAddTorrentParams.ti = std::const_pointer_cast<lt::torrent_info>(nativeTorrentInfo());
             reload();
         }
@@ -1890,7 +2072,7 @@ void TorrentImpl::handleTorrentCheckedAlert(const lt::torrent_checked_alert *p)
             }
         }
 
-        if (m_nativeStatus.need_save_resume)
+        if (m_status.needSaveResume)
             m_session->handleTorrentNeedSaveResumeData(this);
 
         m_session->handleTorrentChecked(this);
@@ -1951,8 +2133,6 @@ void TorrentImpl::handleSaveResumeDataAlert(const lt::save_resume_data_alert *p)
 
     if (m_maintenanceJob == MaintenanceJob::HandleMetadata)
     {
-        Q_ASSERT(m_indexMap.isEmpty());
-
         const auto isSeedMode = static_cast<bool>(m_ltAddTorrentParams.flags & lt::torrent_flags::seed_mode);
         m_ltAddTorrentParams = p->params;
         if (isSeedMode)
@@ -1981,12 +2161,9 @@ void TorrentImpl::handleSaveResumeDataAlert(const lt::save_resume_data_alert *p)
         }
 
         const auto nativeIndexes = metadata.nativeIndexes();
-        m_indexMap.reserve(filePaths.size());
         for (int i = 0; i < filePaths.size(); ++i)
         {
             const auto nativeIndex = nativeIndexes.at(i);
-            m_indexMap[nativeIndex] = i;
-
             if (const auto it = renamedFiles.find(nativeIndex); it != renamedFiles.cend())
                 filePaths[i] = Path(it->second);
         }
@@ -2028,7 +2205,7 @@ void TorrentImpl::prepareResumeData(const lt::add_torrent_params &params)
     LoadTorrentParams resumeData;
     resumeData.name = m_name;
     resumeData.category = m_category;
-    resumeData.tags = m_tags;
+    resumeData.tags = tags();
     resumeData.contentLayout = m_contentLayout;
     resumeData.ratioLimit = m_ratioLimit;
     resumeData.seedingTimeLimit = m_seedingTimeLimit;
@@ -2070,13 +2247,13 @@ void TorrentImpl::handleFastResumeRejectedAlert(const lt::fastresume_rejected_al
 
 void TorrentImpl::handleFileRenamedAlert(const lt::file_renamed_alert *p)
 {
-    const int fileIndex = m_indexMap.value(p->index, -1);
+    const int fileIndex = fileIndexOf(p->index);
     Q_ASSERT(fileIndex >= 0);
 
     // Remove empty leftover folders
     // For example renaming "a/b/c" to "d/b/c", then folders "a/b" and "a" will
     // be removed if they are empty
-    const Path oldFilePath = m_filePaths.at(fileIndex);
+    const Path oldFilePath = filePath(fileIndex);
     const Path newFilePath = Path(QString::fromUtf8(p->new_name())).removedExtension(QB_EXT);
 
     // Check if ".!qB" extension was just added or removed
@@ -2084,7 +2261,10 @@ void TorrentImpl::handleFileRenamedAlert(const lt::file_renamed_alert *p)
     // platforms since it can be renamed by only changing case of some character(s)
     if (oldFilePath.data() != newFilePath.data())
     {
+        if (m_filePaths.isEmpty())
+            m_filePaths = m_torrentInfo.filePaths();
         m_filePaths[fileIndex] = newFilePath;
+        m_relativeRootPath = Path::findRootFolder(m_filePaths);
 
         Path oldParentPath = oldFilePath.parentPath();
         const Path commonBasePath = Path::commonPath(oldParentPath, newFilePath.parentPath());
@@ -2100,11 +2280,13 @@ void TorrentImpl::handleFileRenamedAlert(const lt::file_renamed_alert *p)
         m_moveFinishedTriggers.takeFirst()();
 
     m_session->handleTorrentNeedSaveResumeData(this);
+
+    emit fileRenamed(fileIndex);
 }
 
 void TorrentImpl::handleFileRenameFailedAlert(const lt::file_rename_failed_alert *p)
 {
-    const int fileIndex = m_indexMap.value(p->index, -1);
+    const int fileIndex = fileIndexOf(p->index);
     Q_ASSERT(fileIndex >= 0);
 
     LogMsg(tr("File rename failed. Torrent: \"%1\", file: \"%2\", reason: \"%3\"")
@@ -2115,6 +2297,8 @@ void TorrentImpl::handleFileRenameFailedAlert(const lt::file_rename_failed_alert
         m_moveFinishedTriggers.takeFirst()();
 
     m_session->handleTorrentNeedSaveResumeData(this);
+
+    emit fileRenameFailed(fileIndex);
 }
 
 void TorrentImpl::handleFileCompletedAlert(const lt::file_completed_alert *p)
@@ -2122,7 +2306,7 @@ void TorrentImpl::handleFileCompletedAlert(const lt::file_completed_alert *p)
     if (m_maintenanceJob == MaintenanceJob::HandleMetadata)
         return;
 
-    const int fileIndex = m_indexMap.value(p->index, -1);
+    const int fileIndex = fileIndexOf(p->index);
     Q_ASSERT(fileIndex >= 0);
 
     m_completedFiles.setBit(fileIndex);
@@ -2331,12 +2515,23 @@ bool TorrentImpl::isMoveInProgress() const
     return m_storageIsMoving;
 }
 
+void TorrentImpl::resetStatus(const lt::torrent_status &nativeStatus)
+{
+    m_status = makeStatusSnapshot(nativeStatus);
+    m_nativeTorrentInfo = nativeStatus.torrent_file;
+    m_currentTracker = m_session->internString(QString::fromStdString(nativeStatus.current_tracker));
+    m_actualStorageLocation = Path(nativeStatus.save_path);
+}
+
 void TorrentImpl::updateStatus(const lt::torrent_status &nativeStatus)
 {
-    const lt::torrent_status oldStatus = std::exchange(m_nativeStatus, nativeStatus);
+    const TorrentStatusSnapshot oldStatus = std::exchange(m_status, makeStatusSnapshot(nativeStatus));
+    m_nativeTorrentInfo = nativeStatus.torrent_file;
+    if (!QAnyStringView::equal(m_currentTracker, QUtf8StringView(nativeStatus.current_tracker)))
+        m_currentTracker = m_session->internString(QString::fromStdString(nativeStatus.current_tracker));
 
-    if (m_nativeStatus.num_pieces != oldStatus.num_pieces)
-        updateProgress();
+    if (m_status.numPieces != oldStatus.numPieces)
+        updateProgress(nativeStatus.pieces);
 
     updateState();
 
@@ -2357,7 +2552,7 @@ void TorrentImpl::updateStatus(const lt::torrent_status &nativeStatus)
         std::invoke(m_statusUpdatedTriggers.dequeue());
 }
 
-void TorrentImpl::updateProgress()
+void TorrentImpl::updateProgress(const lt::typed_bitfield<lt::piece_index_t> &pieces)
 {
     Q_ASSERT(hasMetadata());
     if (!hasMetadata()) [[unlikely]]
@@ -2367,7 +2562,7 @@ void TorrentImpl::updateProgress()
     if (m_filesProgress.isEmpty()) [[unlikely]]
         m_filesProgress.resize(filesCount());
 
-    const QBitArray oldPieces = std::exchange(m_pieces, LT::toQBitArray(m_nativeStatus.pieces));
+    const QBitArray oldPieces = std::exchange(m_pieces, LT::toQBitArray(pieces));
     const QBitArray newPieces = m_pieces ^ oldPieces;
 
     const int64_t pieceSize = m_torrentInfo.pieceLength();
@@ -2609,6 +2804,76 @@ nonstd::expected<void, QString> TorrentImpl::exportToFile(const Path &path) cons
     return {};
 }
 
+DiskIOStatus TorrentImpl::diskIOStatus() const
+{
+    return DiskIOStats::instance()->torrentStatus(id());
+}
+
+TorrentMemoryUsage TorrentImpl::memoryUsage() const
+{
+    TorrentMemoryUsage usage;
+    usage.object = sizeof(TorrentImpl);
+
+    if (hasMetadata())
+    {
+        // Parsed file storage has roughly the same size as the info section that is kept as well
+        usage.metadata = sizeof(lt::torrent_info) + (2 * m_torrentInfo.nativeInfo()->metadata_size())
+                + (m_torrentInfo.nativeIndexes().capacity() * sizeof(lt::file_index_t));
+
+        const PathList &originalFilePaths = m_torrentInfo.filePaths();
+        usage.metadata += originalFilePaths.capacity() * sizeof(Path);
+        for (const Path &filePath : originalFilePaths)
+            usage.metadata += heapSize(filePath);
+    }
+
+    // Own file paths share the data with the original ones except the renamed ones
+    usage.filePaths = (m_filePaths.capacity() * sizeof(Path)) + heapSize(m_relativeRootPath);
+    for (const Path &filePath : m_filePaths)
+        usage.filePaths += heapSize(filePath.data());
+
+    usage.fileStates = (m_filePriorities.capacity() * sizeof(DownloadPriority))
+            + (m_completedFiles.size() / 8) + (m_filesProgress.capacity() * sizeof(std::int64_t));
+    usage.pieces = m_pieces.size() / 8;
+
+    usage.trackers = m_trackerEntries.capacity() * sizeof(TrackerEntry);
+    for (const TrackerEntry &trackerEntry : m_trackerEntries)
+    {
+        usage.trackers += heapSize(trackerEntry.url) + heapSize(trackerEntry.message);
+        for (const QHash<int, TrackerEntry::EndpointStats> &endpointStats : trackerEntry.stats)
+        {
+            usage.trackers += sizeof(TrackerEntry::Endpoint) + (endpointStats.size() * sizeof(TrackerEntry::EndpointStats));
+            for (const TrackerEntry::EndpointStats &stats : endpointStats)
+                usage.trackers += heapSize(stats.message);
+        }
+    }
+
+    usage.urlSeeds = m_urlSeeds.capacity() * sizeof(QUrl);
+    for (const QUrl &urlSeed : m_urlSeeds)
+        usage.urlSeeds += urlSeed.toString().size() * sizeof(QChar);
+
+    usage.categoryAndTags = heapSize(m_category) + (m_tagIDs.capacity() * sizeof(TagID));
+    if (m_tags)
+        usage.categoryAndTags += sizeof(TagSet) + (m_tags->size() * (sizeof(QString) + TREE_NODE_OVERHEAD));
+
+    usage.status = sizeof(TorrentStatusSnapshot) + heapSize(m_currentTracker) + heapSize(m_actualStorageLocation);
+
+    const lt::add_torrent_params &p = m_ltAddTorrentParams;
+    usage.resumeData = sizeof(lt::add_torrent_params) + (p.have_pieces.size() / 8) + (p.verified_pieces.size() / 8)
+            + p.file_priorities.capacity() + p.piece_priorities.capacity() + p.name.size() + p.save_path.size();
+    for (const auto &[nativeIndex, filePath] : p.renamed_files)
+        usage.resumeData += sizeof(nativeIndex) + sizeof(filePath) + TREE_NODE_OVERHEAD + filePath.size();
+    for (const std::string &tracker : p.trackers)
+        usage.resumeData += sizeof(tracker) + tracker.size();
+    for (const std::string &urlSeed : p.url_seeds)
+        usage.resumeData += sizeof(urlSeed) + urlSeed.size();
+#ifdef QBT_USES_LIBTORRENT2
+    for (const std::vector<lt::sha256_hash> &merkleTree : p.merkle_trees)
+        usage.resumeData += merkleTree.size() * sizeof(lt::sha256_hash);
+#endif
+
+    return usage;
+}
+
 void TorrentImpl::fetchPeerInfo(std::function<void (QVector<PeerInfo>)> resultHandler) const
 {
     invokeAsync([nativeHandle = m_nativeHandle, allPieces = pieces()]() -> QVector<PeerInfo>
@@ -2692,6 +2957,35 @@ void TorrentImpl::fetchDownloadingPieces(std::function<void (QBitArray)> resultH
     , std::move(resultHandler));
 }
 
+void TorrentImpl::fetchFilesProgress(std::function<void (QVector<qreal>)> resultHandler) const
+{
+    if (!hasMetadata())
+    {
+        resultHandler({});
+        return;
+    }
+
+    const int count = m_filesProgress.size();
+    Q_ASSERT(count == filesCount());
+    if (count != filesCount()) [[unlikely]]
+    {
+        resultHandler({});
+        return;
+    }
+
+    if (m_completedFiles.count(true) == count)
+    {
+        resultHandler(QVector<qreal>(count, 1));
+        return;
+    }
+
+    invokeAsync([torrentInfo = m_torrentInfo, filesProgress = m_filesProgress]() -> QVector<qreal>
+    {
+        return calculateFilesProgress(torrentInfo, filesProgress);
+    }
+    , std::move(resultHandler));
+}
+
 void TorrentImpl::fetchAvailableFileFractions(std::function<void (QVector<qreal>)> resultHandler) const
 {
     invokeAsync([nativeHandle = m_nativeHandle, torrentInfo = m_torrentInfo]() -> QVector<qreal>
@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <ctime>
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include <libtorrent/add_torrent_params.hpp>
 #include <libtorrent/fwd.hpp>
@@ -51,6 +54,7 @@
 #include "base/tagset.h"
 #include "infohash.h"
 #include "speedmonitor.h"
+#include "tagregistry.h"
 #include "torrent.h"
 #include "torrentcontentlayout.h"
 #include "torrentinfo.h"
@@ -87,6 +91,51 @@ namespace BitTorrent
         lt::operation_t operation = lt::operation_t::unknown;
     };
 
+    // The fields of lt::torrent_status that are used by TorrentImpl.
+    // It doesn't own any dynamic data, so it is cheap to store and copy.
+    struct TorrentStatusSnapshot
+    {
+        lt::torrent_status::state_t state = lt::torrent_status::checking_resume_data;
+        lt::torrent_flags_t flags {};
+        lt::error_code errc;
+        lt::queue_position_t queuePosition {-1};
+
+        std::int64_t totalDone = 0;
+        std::int64_t totalWanted = 0;
+        std::int64_t totalWantedDone = 0;
+        std::int64_t totalFailedBytes = 0;
+        std::int64_t totalRedundantBytes = 0;
+        std::int64_t totalPayloadDownload = 0;
+        std::int64_t totalPayloadUpload = 0;
+        std::int64_t allTimeDownload = 0;
+        std::int64_t allTimeUpload = 0;
+
+        int downloadPayloadRate = 0;
+        int uploadPayloadRate = 0;
+        int numSeeds = 0;
+        int numPeers = 0;
+        int numComplete = -1;
+        int numIncomplete = -1;
+        int listSeeds = 0;
+        int listPeers = 0;
+        int numConnections = 0;
+        int connectionsLimit = 0;
+        int numPieces = 0;
+        float progress = 0;
+        float distributedCopies = 0;
+
+        std::time_t addedTime = 0;
+        std::time_t completedTime = 0;
+        std::time_t lastSeenComplete = 0;
+        lt::time_point lastUpload {};
+        lt::time_point lastDownload {};
+        lt::time_duration activeDuration {};
+        lt::time_duration finishedDuration {};
+        lt::time_duration nextAnnounce {};
+
+        bool needSaveResume = false;
+    };
+
     class TorrentImpl final : public Torrent
     {
         Q_OBJECT
@@ -125,7 +174,8 @@ namespace BitTorrent
         bool belongsToCategory(const QString &category) const override;
         bool setCategory(const QString &category) override;
 
-        TagSet tags() const override;
+        const TagSet &tags() const override;
+        const TagIDList &tagIDs() const override;
         bool hasTag(const QString &tag) const override;
         bool addTag(const QString &tag) override;
         bool removeTag(const QString &tag) override;
@@ -162,6 +212,7 @@ namespace BitTorrent
         bool isSequentialDownload() const override;
         bool hasFirstLastPiecePriority() const override;
         TorrentState state() const override;
+        TorrentStateFlags stateFlags() const override;
         bool hasMetadata() const override;
         bool hasMissingFiles() const override;
         bool hasError() const override;
@@ -246,10 +297,14 @@ namespace BitTorrent
         nonstd::expected<QByteArray, QString> exportToBuffer() const override;
         nonstd::expected<void, QString> exportToFile(const Path &path) const override;
 
+        TorrentMemoryUsage memoryUsage() const override;
+        DiskIOStatus diskIOStatus() const override;
+
         void fetchPeerInfo(std::function<void (QVector<PeerInfo>)> resultHandler) const override;
         void fetchURLSeeds(std::function<void (QVector<QUrl>)> resultHandler) const override;
         void fetchPieceAvailability(std::function<void (QVector<int>)> resultHandler) const override;
         void fetchDownloadingPieces(std::function<void (QBitArray)> resultHandler) const override;
+        void fetchFilesProgress(std::function<void (QVector<qreal>)> resultHandler) const override;
         void fetchAvailableFileFractions(std::function<void (QVector<qreal>)> resultHandler) const override;
 
         bool needSaveResumeData() const;
@@ -272,8 +327,13 @@ namespace BitTorrent
         std::shared_ptr<const lt::torrent_info> nativeTorrentInfo() const;
 
         void updateStatus(const lt::torrent_status &nativeStatus);
-        void updateProgress();
+        void resetStatus(const lt::torrent_status &nativeStatus);
+        void updateProgress(const lt::typed_bitfield<lt::piece_index_t> &pieces);
         void updateState();
+        void updateStateFlags();
+
+        void setFilePaths(const PathList &filePaths);
+        int fileIndexOf(lt::file_index_t nativeIndex) const;
 
         void handleFastResumeRejectedAlert(const lt::fastresume_rejected_alert *p);
         void handleFileCompletedAlert(const lt::file_completed_alert *p);
@@ -315,11 +375,17 @@ namespace BitTorrent
         SessionImpl *const m_session = nullptr;
         lt::session *m_nativeSession = nullptr;
         lt::torrent_handle m_nativeHandle;
-        mutable lt::torrent_status m_nativeStatus;
+        TorrentStatusSnapshot m_status;
+        // The data of lt::torrent_status which isn't included in the snapshot
+        mutable std::weak_ptr<const lt::torrent_info> m_nativeTorrentInfo;
+        QString m_currentTracker;
+        Path m_actualStorageLocation;
         TorrentState m_state = TorrentState::Unknown;
+        TorrentStateFlags m_stateFlags;
         TorrentInfo m_torrentInfo;
+        // It's empty if file paths are the same as in metadata, so they aren't duplicated
         PathList m_filePaths;
-        QHash<lt::file_index_t, int> m_indexMap;
+        Path m_relativeRootPath;
         QVector<DownloadPriority> m_filePriorities;
         QBitArray m_completedFiles;
         SpeedMonitor m_payloadRateMonitor;
@@ -345,7 +411,9 @@ namespace BitTorrent
         Path m_savePath;
         Path m_downloadPath;
         QString m_category;
-        TagSet m_tags;
+        TagIDList m_tagIDs;
+        // names of the tags are resolved once they are requested, then they are kept until the tags are changed
+        mutable std::optional<TagSet> m_tags;
         qreal m_ratioLimit;
         int m_seedingTimeLimit;
         int m_inactiveSeedingTimeLimit;
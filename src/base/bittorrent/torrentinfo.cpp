@@ -60,10 +60,14 @@ TorrentInfo::TorrentInfo(const lt::torrent_info &nativeInfo)
 
     const lt::file_storage &fileStorage = m_nativeInfo->orig_files();
     m_nativeIndexes.reserve(fileStorage.num_files());
+    m_filePaths.reserve(fileStorage.num_files());
     for (const lt::file_index_t nativeIndex : fileStorage.file_range())
     {
         if (!fileStorage.pad_file_at(nativeIndex))
+        {
             m_nativeIndexes.append(nativeIndex);
+            m_filePaths.append(Path(fileStorage.file_path(nativeIndex)));
+        }
     }
 }
 
@@ -73,6 +77,7 @@ TorrentInfo &TorrentInfo::operator=(const TorrentInfo &other)
     {
         m_nativeInfo = other.m_nativeInfo;
         m_nativeIndexes = other.m_nativeIndexes;
+        m_filePaths = other.m_filePaths;
     }
     return *this;
 }
@@ -229,21 +234,16 @@ Path TorrentInfo::filePath(const int index) const
     if (!isValid()) return {};
 
     Q_ASSERT(index >= 0);
-    Q_ASSERT(index < m_nativeIndexes.size());
-    if ((index < 0) || (index >= m_nativeIndexes.size()))
+    Q_ASSERT(index < m_filePaths.size());
+    if ((index < 0) || (index >= m_filePaths.size()))
         return {};
 
-    return Path(m_nativeInfo->orig_files().file_path(m_nativeIndexes[index]));
+    return m_filePaths[index];
 }
 
-PathList TorrentInfo::filePaths() const
+const PathList &TorrentInfo::filePaths() const
 {
-    PathList list;
-    list.reserve(filesCount());
-    for (int i = 0; i < filesCount(); ++i)
-        list << filePath(i);
-
-    return list;
+    return m_filePaths;
 }
 
 qlonglong TorrentInfo::fileSize(const int index) const
@@ -77,7 +77,7 @@ namespace BitTorrent
         int pieceLength(int index) const;
         int piecesCount() const;
         Path filePath(int index) const;
-        PathList filePaths() const;
+        const PathList &filePaths() const;
         qlonglong fileSize(int index) const;
         qlonglong fileOffset(int index) const;
         QVector<TrackerEntry> trackers() const;
@@ -107,6 +107,8 @@ namespace BitTorrent
         // internal indexes of files (payload only, excluding any .pad files)
         // by which they are addressed in libtorrent
         QVector<lt::file_index_t> m_nativeIndexes;
+        // file paths are built once, then they are shared by all the copies
+        PathList m_filePaths;
     };
 }
 
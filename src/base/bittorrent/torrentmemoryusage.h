@@ -0,0 +1,72 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QtTypes>
+
+namespace BitTorrent
+{
+    // Approximate amount of memory used by the torrent data kept by qBittorrent
+    // (the memory used by libtorrent internally isn't included).
+    // Interned strings are shared between torrents, so they aren't included as well.
+    struct TorrentMemoryUsage
+    {
+        qint64 object = 0;
+        qint64 metadata = 0;
+        qint64 filePaths = 0;
+        qint64 fileStates = 0;
+        qint64 pieces = 0;
+        qint64 trackers = 0;
+        qint64 urlSeeds = 0;
+        qint64 categoryAndTags = 0;
+        qint64 status = 0;
+        qint64 resumeData = 0;
+
+        qint64 total() const
+        {
+            return object + metadata + filePaths + fileStates + pieces + trackers
+                    + urlSeeds + categoryAndTags + status + resumeData;
+        }
+
+        TorrentMemoryUsage &operator+=(const TorrentMemoryUsage &other)
+        {
+            object += other.object;
+            metadata += other.metadata;
+            filePaths += other.filePaths;
+            fileStates += other.fileStates;
+            pieces += other.pieces;
+            trackers += other.trackers;
+            urlSeeds += other.urlSeeds;
+            categoryAndTags += other.categoryAndTags;
+            status += other.status;
+            resumeData += other.resumeData;
+            return *this;
+        }
+    };
+}
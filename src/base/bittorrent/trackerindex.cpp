@@ -0,0 +1,136 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "trackerindex.h"
+
+#include <QUrl>
+
+namespace
+{
+    QString extractHost(const QString &trackerURL)
+    {
+        // If failed to parse the host, the original URL is used
+        const QString host = QUrl(trackerURL).host();
+        return host.isEmpty() ? trackerURL : host;
+    }
+}
+
+QString BitTorrent::TrackerIndex::host(const QString &trackerURL) const
+{
+    const auto iter = m_trackers.constFind(trackerURL);
+    return (iter != m_trackers.cend()) ? iter->host : extractHost(trackerURL);
+}
+
+QSet<BitTorrent::Torrent *> BitTorrent::TrackerIndex::torrents(const QString &trackerURL) const
+{
+    return m_trackers.value(trackerURL).torrents;
+}
+
+QSet<BitTorrent::Torrent *> BitTorrent::TrackerIndex::hostTorrents(const QString &host) const
+{
+    if (host.isEmpty())
+        return m_trackerlessTorrents;
+
+    const QHash<Torrent *, int> torrents = m_hostTorrents.value(host);
+    return {torrents.keyBegin(), torrents.keyEnd()};
+}
+
+qsizetype BitTorrent::TrackerIndex::hostTorrentsCount(const QString &host) const
+{
+    if (host.isEmpty())
+        return m_trackerlessTorrents.size();
+
+    return m_hostTorrents.value(host).size();
+}
+
+void BitTorrent::TrackerIndex::addTorrent(Torrent *torrent, const QStringList &trackerURLs)
+{
+    if (trackerURLs.isEmpty())
+        m_trackerlessTorrents.insert(torrent);
+    else
+        addTrackers(torrent, trackerURLs);
+}
+
+void BitTorrent::TrackerIndex::removeTorrent(Torrent *torrent, const QStringList &trackerURLs)
+{
+    removeTrackers(torrent, trackerURLs, false);
+    m_trackerlessTorrents.remove(torrent);
+}
+
+void BitTorrent::TrackerIndex::addTrackers(Torrent *torrent, const QStringList &trackerURLs)
+{
+    if (trackerURLs.isEmpty())
+        return;
+
+    m_trackerlessTorrents.remove(torrent);
+    for (const QString &trackerURL : trackerURLs)
+        addTracker(torrent, trackerURL);
+}
+
+void BitTorrent::TrackerIndex::removeTrackers(Torrent *torrent, const QStringList &trackerURLs, const bool hasOtherTrackers)
+{
+    for (const QString &trackerURL : trackerURLs)
+        removeTracker(torrent, trackerURL);
+
+    if (!hasOtherTrackers)
+        m_trackerlessTorrents.insert(torrent);
+}
+
+void BitTorrent::TrackerIndex::addTracker(Torrent *torrent, const QString &trackerURL)
+{
+    auto iter = m_trackers.find(trackerURL);
+    if (iter == m_trackers.end())
+        iter = m_trackers.insert(trackerURL, {extractHost(trackerURL), {}});
+
+    if (iter->torrents.contains(torrent))
+        return;
+
+    iter->torrents.insert(torrent);
+    ++m_hostTorrents[iter->host][torrent];
+}
+
+void BitTorrent::TrackerIndex::removeTracker(Torrent *torrent, const QString &trackerURL)
+{
+    const auto iter = m_trackers.find(trackerURL);
+    if ((iter == m_trackers.end()) || !iter->torrents.remove(torrent))
+        return;
+
+    const QString host = iter->host;
+    if (iter->torrents.isEmpty())
+        m_trackers.erase(iter);
+
+    const auto hostIter = m_hostTorrents.find(host);
+    Q_ASSERT(hostIter != m_hostTorrents.end());
+    if (hostIter == m_hostTorrents.end()) [[unlikely]]
+        return;
+
+    if (const auto torrentIter = hostIter->find(torrent); (torrentIter != hostIter->end()) && (--torrentIter.value() == 0))
+        hostIter->erase(torrentIter);
+    if (hostIter->isEmpty())
+        m_hostTorrents.erase(hostIter);
+}
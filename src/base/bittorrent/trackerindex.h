@@ -0,0 +1,79 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace BitTorrent
+{
+    class Torrent;
+
+    // Keeps the torrents using each of the trackers (by tracker URL and by tracker host),
+    // so they can be found without checking all the torrents. The host of each tracker URL
+    // is extracted only once, when the tracker is used by some torrent for the first time.
+    class TrackerIndex
+    {
+        Q_DISABLE_COPY_MOVE(TrackerIndex)
+
+    public:
+        TrackerIndex() = default;
+
+        QString host(const QString &trackerURL) const;
+
+        QSet<Torrent *> torrents(const QString &trackerURL) const;
+        // Empty host means trackerless torrents
+        QSet<Torrent *> hostTorrents(const QString &host) const;
+        qsizetype hostTorrentsCount(const QString &host) const;
+
+        void addTorrent(Torrent *torrent, const QStringList &trackerURLs);
+        void removeTorrent(Torrent *torrent, const QStringList &trackerURLs);
+        void addTrackers(Torrent *torrent, const QStringList &trackerURLs);
+        void removeTrackers(Torrent *torrent, const QStringList &trackerURLs, bool hasOtherTrackers);
+
+    private:
+        struct TrackerData
+        {
+            QString host;
+            QSet<Torrent *> torrents;
+        };
+
+        void addTracker(Torrent *torrent, const QString &trackerURL);
+        void removeTracker(Torrent *torrent, const QString &trackerURL);
+
+        QHash<QString, TrackerData> m_trackers;  // <tracker URL, tracker data>
+        // A torrent can have several trackers with the same host,
+        // so the number of such trackers is kept for each torrent
+        QHash<QString, QHash<Torrent *, int>> m_hostTorrents;
+        QSet<Torrent *> m_trackerlessTorrents;
+    };
+}
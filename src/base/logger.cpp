@@ -29,26 +29,112 @@
 #include "logger.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <QDateTime>
+#include <QMetaObject>
 #include <QVector>
 
 namespace
 {
-    template <typename T>
-    QVector<T> loadFromBuffer(const boost::circular_buffer_space_optimized<T> &src, const int offset = 0)
+    const std::size_t PENDING_QUEUE_CAPACITY = 4096;
+
+    // Returns the items that follow the item with "lastKnownId" (oldest first).
+    // Only the items accepted by predicate are copied, up to "limit" ones (if not negative).
+    template <typename T, typename Predicate>
+    QVector<T> loadFromBuffer(const boost::circular_buffer_space_optimized<T> &src, const int counter
+            , const int lastKnownId, const int limit, Predicate &&predicate)
     {
+        const int size = static_cast<int>(src.size());
+        const int diff = counter - lastKnownId - 1;
+        if ((lastKnownId != -1) && (diff <= 0))
+            return {};
+
+        const int offset = ((lastKnownId == -1) || (diff >= size)) ? 0 : (size - diff);
+        const int count = size - offset;
+
         QVector<T> ret;
-        ret.reserve(static_cast<typename decltype(ret)::size_type>(src.size()) - offset);
-        std::copy((src.begin() + offset), src.end(), std::back_inserter(ret));
+        ret.reserve((limit >= 0) ? std::min(limit, count) : count);
+        for (auto it = (src.begin() + offset); (it != src.end()) && ((limit < 0) || (ret.size() < limit)); ++it)
+        {
+            if (predicate(*it))
+                ret.append(*it);
+        }
         return ret;
     }
 }
 
+// It is an adaptation of the bounded queue by Dmitry Vyukov. Each slot has a sequence number
+// which tells whether it is ready to be filled by the producer that has claimed its position
+// or to be emptied by the consumer.
+template <typename T>
+Logger::PendingQueue<T>::PendingQueue(const std::size_t capacity)
+    : m_mask {capacity - 1}
+    , m_slots {std::make_unique<Slot[]>(capacity)}
+{
+    Q_ASSERT((capacity > 0) && ((capacity & m_mask) == 0));
+
+    for (std::size_t i = 0; i < capacity; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool Logger::PendingQueue<T>::isEmpty() const
+{
+    return (m_popPos.load(std::memory_order_acquire) == m_pushPos.load(std::memory_order_acquire));
+}
+
+template <typename T>
+bool Logger::PendingQueue<T>::push(T &&item)
+{
+    std::size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true)
+    {
+        slot = &m_slots[pos & m_mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            if (m_pushPos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // the slot still holds an item that isn't popped yet
+            return false;
+        }
+        else
+        {
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->item = std::move(item);
+    slot->sequence.store((pos + 1), std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool Logger::PendingQueue<T>::pop(T &item)
+{
+    const std::size_t pos = m_popPos.load(std::memory_order_relaxed);
+    Slot &slot = m_slots[pos & m_mask];
+    if (slot.sequence.load(std::memory_order_acquire) != (pos + 1))
+        return false;
+
+    item = std::exchange(slot.item, {});
+    slot.sequence.store((pos + m_mask + 1), std::memory_order_release);
+    m_popPos.store((pos + 1), std::memory_order_release);
+    return true;
+}
+
 Logger *Logger::m_instance = nullptr;
 
 Logger::Logger()
-    : m_messages(MAX_LOG_MESSAGES)
+    : m_pendingMessages(PENDING_QUEUE_CAPACITY)
+    , m_pendingPeers(PENDING_QUEUE_CAPACITY)
+    , m_messages(MAX_LOG_MESSAGES)
     , m_peers(MAX_LOG_MESSAGES)
 {
 }
@@ -70,56 +156,107 @@ void Logger::freeInstance()
     m_instance = nullptr;
 }
 
+// Items are added without locking. They are put to the pending queue, and then they are
+// taken into the log (and get their IDs) by a single thread at a time holding the lock.
 void Logger::addMessage(const QString &message, const Log::MsgType &type)
 {
-    QWriteLocker locker(&m_lock);
-    const Log::Msg msg = {m_msgCounter++, type, QDateTime::currentSecsSinceEpoch(), message};
-    m_messages.push_back(msg);
-    locker.unlock();
+    Log::Msg msg {-1, type, QDateTime::currentSecsSinceEpoch(), message};
+    while (!m_pendingMessages.push(std::move(msg))) [[unlikely]]
+    {
+        // queue is full (e.g. the thread of Logger is busy) so it is emptied by the producer
+        const QWriteLocker locker(&m_lock);
+        takePendingItems();
+    }
 
-    emit newLogMessage(msg);
+    scheduleNotification();
 }
 
 void Logger::addPeer(const QString &ip, const bool blocked, const QString &reason)
 {
-    QWriteLocker locker(&m_lock);
-    const Log::Peer msg = {m_peerCounter++, blocked, QDateTime::currentSecsSinceEpoch(), ip, reason};
-    m_peers.push_back(msg);
-    locker.unlock();
+    Log::Peer peer {-1, blocked, QDateTime::currentSecsSinceEpoch(), ip, reason};
+    while (!m_pendingPeers.push(std::move(peer))) [[unlikely]]
+    {
+        const QWriteLocker locker(&m_lock);
+        takePendingItems();
+    }
 
-    emit newLogPeer(msg);
+    scheduleNotification();
 }
 
-QVector<Log::Msg> Logger::getMessages(const int lastKnownId) const
+void Logger::processPendingItems()
 {
-    const QReadLocker locker(&m_lock);
+    if (m_pendingMessages.isEmpty() && m_pendingPeers.isEmpty())
+        return;
 
-    const int diff = m_msgCounter - lastKnownId - 1;
-    const int size = static_cast<int>(m_messages.size());
+    const QWriteLocker locker(&m_lock);
+    takePendingItems();
+}
 
-    if ((lastKnownId == -1) || (diff >= size))
-        return loadFromBuffer(m_messages);
+// Should be called with the lock held
+void Logger::takePendingItems()
+{
+    Log::Msg msg;
+    while (m_pendingMessages.pop(msg))
+    {
+        msg.id = m_msgCounter++;
+        m_messages.push_back(std::move(msg));
+        m_hasNewMessages = true;
+    }
 
-    if (diff <= 0)
-        return {};
+    Log::Peer peer;
+    while (m_pendingPeers.pop(peer))
+    {
+        peer.id = m_peerCounter++;
+        m_peers.push_back(std::move(peer));
+        m_hasNewPeers = true;
+    }
+}
 
-    return loadFromBuffer(m_messages, (size - diff));
+void Logger::scheduleNotification()
+{
+    // Items can be added from any thread, but they are reported in the thread of Logger
+    // only once per event loop iteration, so floods of messages don't flood event queues
+    if (!m_isNotificationScheduled.exchange(true))
+        QMetaObject::invokeMethod(this, &Logger::notify, Qt::QueuedConnection);
 }
 
-QVector<Log::Peer> Logger::getPeers(const int lastKnownId) const
+void Logger::notify()
 {
-    const QReadLocker locker(&m_lock);
+    // Reset the flag first, so the items added from now on schedule another notification
+    m_isNotificationScheduled = false;
 
-    const int diff = m_peerCounter - lastKnownId - 1;
-    const int size = static_cast<int>(m_peers.size());
+    QWriteLocker locker(&m_lock);
+    takePendingItems();
+    const bool hasNewMessages = std::exchange(m_hasNewMessages, false);
+    const bool hasNewPeers = std::exchange(m_hasNewPeers, false);
+    locker.unlock();
+
+    if (hasNewMessages)
+        emit newLogMessages();
+    if (hasNewPeers)
+        emit newLogPeers();
+}
+
+QVector<Log::Msg> Logger::getMessages(const int lastKnownId)
+{
+    return getMessages(lastKnownId, Log::MsgTypes(Log::ALL), -1);
+}
 
-    if ((lastKnownId == -1) || (diff >= size))
-        return loadFromBuffer(m_peers);
+QVector<Log::Msg> Logger::getMessages(const int lastKnownId, const Log::MsgTypes types, const int limit)
+{
+    processPendingItems();
+
+    const QReadLocker locker(&m_lock);
+    return loadFromBuffer(m_messages, m_msgCounter, lastKnownId, limit
+            , [types](const Log::Msg &msg) { return types.testFlag(msg.type); });
+}
 
-    if (diff <= 0)
-        return {};
+QVector<Log::Peer> Logger::getPeers(const int lastKnownId, const int limit)
+{
+    processPendingItems();
 
-    return loadFromBuffer(m_peers, (size - diff));
+    const QReadLocker locker(&m_lock);
+    return loadFromBuffer(m_peers, m_peerCounter, lastKnownId, limit, [](const Log::Peer &) { return true; });
 }
 
 void LogMsg(const QString &message, const Log::MsgType &type)
@@ -28,6 +28,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
 #include <boost/circular_buffer.hpp>
 
 #include <QObject>
@@ -81,23 +85,67 @@ public:
 
     void addMessage(const QString &message, const Log::MsgType &type = Log::NORMAL);
     void addPeer(const QString &ip, bool blocked, const QString &reason = {});
-    QVector<Log::Msg> getMessages(int lastKnownId = -1) const;
-    QVector<Log::Peer> getPeers(int lastKnownId = -1) const;
+    // The getters take the pending items into the log first, so they return everything added so far
+    QVector<Log::Msg> getMessages(int lastKnownId = -1);
+    // Returns up to "limit" (if not negative) messages of given types following the one with "lastKnownId"
+    QVector<Log::Msg> getMessages(int lastKnownId, Log::MsgTypes types, int limit);
+    QVector<Log::Peer> getPeers(int lastKnownId = -1, int limit = -1);
 
 signals:
-    void newLogMessage(const Log::Msg &message);
-    void newLogPeer(const Log::Peer &peer);
+    // Notifications are batched, so a lot of items added in a row produce a single signal.
+    // The new items can be retrieved using getMessages()/getPeers() with the last known ID.
+    void newLogMessages();
+    void newLogPeers();
 
 private:
+    // Bounded lock-free queue of fixed capacity (power of two).
+    // Items can be pushed by any number of threads at once, but only one thread can pop them at a time.
+    template <typename T>
+    class PendingQueue
+    {
+        Q_DISABLE_COPY_MOVE(PendingQueue)
+
+    public:
+        explicit PendingQueue(std::size_t capacity);
+
+        bool isEmpty() const;
+        bool push(T &&item); // returns false if queue is full
+        bool pop(T &item);
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence;
+            T item;
+        };
+
+        const std::size_t m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+        alignas(64) std::atomic<std::size_t> m_pushPos = 0;
+        alignas(64) std::atomic<std::size_t> m_popPos = 0;
+    };
+
     Logger();
     ~Logger() = default;
 
+    void processPendingItems();
+    void takePendingItems();
+    void scheduleNotification();
+    void notify();
+
     static Logger *m_instance;
+    PendingQueue<Log::Msg> m_pendingMessages;
+    PendingQueue<Log::Peer> m_pendingPeers;
+    std::atomic_bool m_isNotificationScheduled = false;
+
+    // the following are guarded by m_lock
     boost::circular_buffer_space_optimized<Log::Msg> m_messages;
     boost::circular_buffer_space_optimized<Log::Peer> m_peers;
-    mutable QReadWriteLock m_lock;
+    QReadWriteLock m_lock;
     int m_msgCounter = 0;
     int m_peerCounter = 0;
+    bool m_hasNewMessages = false;
+    bool m_hasNewPeers = false;
 };
 
 // Helper function
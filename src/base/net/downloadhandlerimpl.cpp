@@ -122,6 +122,14 @@ void Net::DownloadHandlerImpl::processFinishedDownload()
         return;
     }
 
+    if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304)
+    {
+        // The content hasn't changed since it was downloaded with provided validators
+        m_result.status = DownloadStatus::NotModified;
+        finish();
+        return;
+    }
+
     // Check if the server ask us to redirect somewhere else
     const QVariant redirection = m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute);
     if (redirection.isValid())
@@ -138,6 +146,8 @@ void Net::DownloadHandlerImpl::processFinishedDownload()
 #else
     m_result.data = m_reply->readAll();
 #endif
+    m_result.etag = QString::fromLatin1(m_reply->rawHeader("ETag"));
+    m_result.lastModified = QString::fromLatin1(m_reply->rawHeader("Last-Modified"));
 
     if (m_downloadRequest.saveToFile())
     {
@@ -299,6 +299,11 @@ void Net::DownloadManager::processRequest(DownloadHandlerImpl *downloadHandler)
     // Qt doesn't support Magnet protocol so we need to handle redirections manually
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
 
+    if (!downloadRequest.ifNoneMatch().isEmpty())
+        request.setRawHeader("If-None-Match", downloadRequest.ifNoneMatch().toLatin1());
+    if (!downloadRequest.ifModifiedSince().isEmpty())
+        request.setRawHeader("If-Modified-Since", downloadRequest.ifModifiedSince().toLatin1());
+
     QNetworkReply *reply = m_networkManager->get(request);
     connect(reply, &QNetworkReply::finished, this, [this, downloadHandler]
     {
@@ -367,6 +372,28 @@ Net::DownloadRequest &Net::DownloadRequest::destFileName(const Path &value)
     return *this;
 }
 
+QString Net::DownloadRequest::ifNoneMatch() const
+{
+    return m_ifNoneMatch;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::ifNoneMatch(const QString &value)
+{
+    m_ifNoneMatch = value;
+    return *this;
+}
+
+QString Net::DownloadRequest::ifModifiedSince() const
+{
+    return m_ifModifiedSince;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::ifModifiedSince(const QString &value)
+{
+    m_ifModifiedSince = value;
+    return *this;
+}
+
 Net::ServiceID Net::ServiceID::fromURL(const QUrl &url)
 {
     return {url.host(), url.port(80)};
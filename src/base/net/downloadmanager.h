@@ -61,6 +61,7 @@ namespace Net
     {
         Success,
         RedirectedToMagnet,
+        NotModified,
         Failed
     };
 
@@ -88,12 +89,22 @@ namespace Net
         Path destFileName() const;
         DownloadRequest &destFileName(const Path &value);
 
+        // validators of previously downloaded content (i.e. "ETag" and "Last-Modified" header values),
+        // DownloadStatus::NotModified is reported if it hasn't changed since then
+        QString ifNoneMatch() const;
+        DownloadRequest &ifNoneMatch(const QString &value);
+
+        QString ifModifiedSince() const;
+        DownloadRequest &ifModifiedSince(const QString &value);
+
     private:
         QString m_url;
         QString m_userAgent;
         qint64 m_limit = 0;
         bool m_saveToFile = false;
         Path m_destFileName;
+        QString m_ifNoneMatch;
+        QString m_ifModifiedSince;
     };
 
     struct DownloadResult
@@ -104,6 +115,8 @@ namespace Net
         QByteArray data;
         Path filePath;
         QString magnetURI;
+        QString etag;
+        QString lastModified;
     };
 
     class DownloadHandler : public QObject
@@ -30,6 +30,7 @@
 #include "preferences.h"
 
 #include <chrono>
+#include <utility>
 
 #ifdef Q_OS_MACOS
 #include <CoreServices/CoreServices.h>
@@ -84,7 +85,21 @@ namespace
 
 Preferences *Preferences::m_instance = nullptr;
 
-Preferences::Preferences() = default;
+Preferences::Preferences()
+    : m_torrentFileSizeLimit {u"BitTorrent/TorrentFileSizeLimit"_s, (100 * 1024 * 1024)}
+    , m_bdecodeDepthLimit {u"BitTorrent/BdecodeDepthLimit"_s, 100}
+    , m_bdecodeTokenLimit {u"BitTorrent/BdecodeTokenLimit"_s, 10'000'000}
+    , m_webUIMaxAuthFailCount {u"Preferences/WebUI/MaxAuthenticationFailCount"_s, 5}
+    , m_useProxyForBT {u"Network/Proxy/Profiles/BitTorrent"_s}
+    , m_useProxyForRSS {u"Network/Proxy/Profiles/RSS"_s}
+    , m_useProxyForGeneralPurposes {u"Network/Proxy/Profiles/Misc"_s}
+{
+    connect(SettingsStorage::instance(), &SettingsStorage::saved, this, [this]
+    {
+        if (std::exchange(m_isApplyPending, false))
+            emit changed();
+    });
+}
 
 Preferences *Preferences::instance()
 {
@@ -306,7 +321,7 @@ void Preferences::setIconsInMenusEnabled(const bool enable)
 
 qint64 Preferences::getTorrentFileSizeLimit() const
 {
-    return value(u"BitTorrent/TorrentFileSizeLimit"_s, (100 * 1024 * 1024));
+    return m_torrentFileSizeLimit;
 }
 
 void Preferences::setTorrentFileSizeLimit(const qint64 value)
@@ -314,12 +329,12 @@ void Preferences::setTorrentFileSizeLimit(const qint64 value)
     if (value == getTorrentFileSizeLimit())
         return;
 
-    setValue(u"BitTorrent/TorrentFileSizeLimit"_s, value);
+    m_torrentFileSizeLimit = value;
 }
 
 int Preferences::getBdecodeDepthLimit() const
 {
-    return value(u"BitTorrent/BdecodeDepthLimit"_s, 100);
+    return m_bdecodeDepthLimit;
 }
 
 void Preferences::setBdecodeDepthLimit(const int value)
@@ -327,12 +342,12 @@ void Preferences::setBdecodeDepthLimit(const int value)
     if (value == getBdecodeDepthLimit())
         return;
 
-    setValue(u"BitTorrent/BdecodeDepthLimit"_s, value);
+    m_bdecodeDepthLimit = value;
 }
 
 int Preferences::getBdecodeTokenLimit() const
 {
-    return value(u"BitTorrent/BdecodeTokenLimit"_s, 10'000'000);
+    return m_bdecodeTokenLimit;
 }
 
 void Preferences::setBdecodeTokenLimit(const int value)
@@ -340,7 +355,7 @@ void Preferences::setBdecodeTokenLimit(const int value)
     if (value == getBdecodeTokenLimit())
         return;
 
-    setValue(u"BitTorrent/BdecodeTokenLimit"_s, value);
+    m_bdecodeTokenLimit = value;
 }
 
 bool Preferences::isToolbarDisplayed() const
@@ -793,7 +808,7 @@ void Preferences::setWebUIPassword(const QByteArray &password)
 
 int Preferences::getWebUIMaxAuthFailCount() const
 {
-    return value<int>(u"Preferences/WebUI/MaxAuthenticationFailCount"_s, 5);
+    return m_webUIMaxAuthFailCount;
 }
 
 void Preferences::setWebUIMaxAuthFailCount(const int count)
@@ -801,7 +816,7 @@ void Preferences::setWebUIMaxAuthFailCount(const int count)
     if (count == getWebUIMaxAuthFailCount())
         return;
 
-    setValue(u"Preferences/WebUI/MaxAuthenticationFailCount"_s, count);
+    m_webUIMaxAuthFailCount = count;
 }
 
 std::chrono::seconds Preferences::getWebUIBanDuration() const
@@ -2009,7 +2024,7 @@ void Preferences::setNetworkCookies(const QList<QNetworkCookie> &cookies)
 
 bool Preferences::useProxyForBT() const
 {
-    return value<bool>(u"Network/Proxy/Profiles/BitTorrent"_s);
+    return m_useProxyForBT;
 }
 
 void Preferences::setUseProxyForBT(const bool value)
@@ -2017,12 +2032,12 @@ void Preferences::setUseProxyForBT(const bool value)
     if (value == useProxyForBT())
         return;
 
-    setValue(u"Network/Proxy/Profiles/BitTorrent"_s, value);
+    m_useProxyForBT = value;
 }
 
 bool Preferences::useProxyForRSS() const
 {
-    return value<bool>(u"Network/Proxy/Profiles/RSS"_s);
+    return m_useProxyForRSS;
 }
 
 void Preferences::setUseProxyForRSS(const bool value)
@@ -2030,12 +2045,12 @@ void Preferences::setUseProxyForRSS(const bool value)
     if (value == useProxyForRSS())
         return;
 
-    setValue(u"Network/Proxy/Profiles/RSS"_s, value);
+    m_useProxyForRSS = value;
 }
 
 bool Preferences::useProxyForGeneralPurposes() const
 {
-    return value<bool>(u"Network/Proxy/Profiles/Misc"_s);
+    return m_useProxyForGeneralPurposes;
 }
 
 void Preferences::setUseProxyForGeneralPurposes(const bool value)
@@ -2043,7 +2058,7 @@ void Preferences::setUseProxyForGeneralPurposes(const bool value)
     if (value == useProxyForGeneralPurposes())
         return;
 
-    setValue(u"Network/Proxy/Profiles/Misc"_s, value);
+    m_useProxyForGeneralPurposes = value;
 }
 
 bool Preferences::isSpeedWidgetEnabled() const
@@ -2088,6 +2103,7 @@ void Preferences::setSpeedWidgetGraphEnable(const int id, const bool enable)
 
 void Preferences::apply()
 {
+    // settings are written asynchronously, so the change is reported once they are written successfully
     if (SettingsStorage::instance()->save())
-        emit changed();
+        m_isApplyPending = true;
 }
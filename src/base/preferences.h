@@ -34,6 +34,7 @@
 #include <QObject>
 
 #include "base/pathfwd.h"
+#include "base/settingvalue.h"
 #include "base/utils/net.h"
 
 class QDateTime;
@@ -437,4 +438,16 @@ signals:
 
 private:
     static Preferences *m_instance;
+
+    bool m_isApplyPending = false;
+
+    // The settings read on hot paths (e.g. when loading torrents in worker threads),
+    // so they are kept converted
+    AtomicSettingValue<qint64> m_torrentFileSizeLimit;
+    AtomicSettingValue<int> m_bdecodeDepthLimit;
+    AtomicSettingValue<int> m_bdecodeTokenLimit;
+    AtomicSettingValue<int> m_webUIMaxAuthFailCount;
+    AtomicSettingValue<bool> m_useProxyForBT;
+    AtomicSettingValue<bool> m_useProxyForRSS;
+    AtomicSettingValue<bool> m_useProxyForGeneralPurposes;
 };
@@ -31,58 +31,307 @@
 
 #include "feed_serializer.h"
 
+#include <algorithm>
+
+#include <QDataStream>
+#include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QVector>
 
+#include "base/global.h"
 #include "base/logger.h"
 #include "base/path.h"
+#include "base/utils/fs.h"
 #include "base/utils/io.h"
-#include "rss_article.h"
 
-const int ARTICLEDATALIST_TYPEID = qRegisterMetaType<QVector<QVariantHash>>();
+const int ARTICLEDATALIST_TYPEID = qRegisterMetaType<QVector<RSS::ArticleData>>();
+
+namespace
+{
+    const quint32 DATA_FILE_MAGIC = 0x51425246;  // "QBRF"
+    const quint32 DATA_FILE_VERSION = 1;
+    const QDataStream::Version DATA_STREAM_VERSION = QDataStream::Qt_6_0;
+    const qint64 DATA_FILE_MAX_SIZE = 64 * 1024 * 1024;
+    const qint64 LEGACY_DATA_FILE_MAX_SIZE = 10 * 1024 * 1024;
+
+    enum class RecordType : quint8
+    {
+        Article = 1,
+        ArticleRead = 2,
+        ArticleRemoved = 3
+    };
+
+    void writeHeader(QDataStream &stream)
+    {
+        stream << DATA_FILE_MAGIC << DATA_FILE_VERSION;
+    }
+
+    void writeArticle(QDataStream &stream, const RSS::ArticleData &article)
+    {
+        stream << static_cast<quint8>(RecordType::Article) << article.id << article.date << article.title
+                << article.author << article.description << article.torrentURL << article.link
+                << article.isRead << article.extraFields;
+    }
+
+    void writeArticleID(QDataStream &stream, const RecordType recordType, const QString &articleID)
+    {
+        stream << static_cast<quint8>(recordType) << articleID;
+    }
+
+    void sortArticles(QVector<RSS::ArticleData> &articles)
+    {
+        std::sort(articles.begin(), articles.end(), [](const RSS::ArticleData &left, const RSS::ArticleData &right)
+        {
+            return (left.date > right.date);
+        });
+    }
+}
 
-void RSS::Private::FeedSerializer::load(const Path &dataFileName, const QString &url)
+void RSS::Private::FeedSerializer::load(const Path &dataFileName, const Path &legacyDataFileName, const QString &url)
 {
-    const int fileMaxSize = 10 * 1024 * 1024;
-    const auto readResult = Utils::IO::readFile(dataFileName, fileMaxSize);
+    const auto readResult = Utils::IO::readFile(dataFileName, DATA_FILE_MAX_SIZE);
     if (!readResult)
     {
         if (readResult.error().status == Utils::IO::ReadError::NotExist)
         {
-            emit loadingFinished({});
+            // Convert the data file of previous versions, if any
+            const auto legacyReadResult = Utils::IO::readFile(legacyDataFileName, LEGACY_DATA_FILE_MAX_SIZE);
+            if (!legacyReadResult)
+            {
+                if (legacyReadResult.error().status == Utils::IO::ReadError::NotExist)
+                {
+                    emit loadingFinished({});
+                    return;
+                }
+
+                LogMsg(tr("Failed to read RSS session data. %1").arg(legacyReadResult.error().message), Log::WARNING);
+                // The legacy data file must be converted once it can be read,
+                // so the articles aren't stored in the new one until then
+                m_isStoringDisabled = true;
+                emit loadingFinished({});
+                return;
+            }
+
+            const std::optional<QVector<ArticleData>> articles = loadLegacyArticles(legacyReadResult.value(), url);
+            if (!articles)
+            {
+                // The legacy data file is kept as is, so the data can still be recovered
+                emit loadingFinished({});
+                return;
+            }
+
+            store(dataFileName, *articles);
+            if (dataFileName.exists())
+                Utils::Fs::removeFile(legacyDataFileName);
+            emit loadingFinished(*articles);
             return;
         }
 
         LogMsg(tr("Failed to read RSS session data. %1").arg(readResult.error().message), Log::WARNING);
+        // The data file that can't be read must not be overwritten
+        m_isStoringDisabled = true;
+        emit loadingFinished({});
+        return;
+    }
+
+    const std::optional<QVector<ArticleData>> articles = loadArticles(readResult.value(), url);
+    if (!articles)
+    {
+        // The file could be written by newer version, so it must not be overwritten.
+        // It is moved aside, so the new articles are stored in a new file.
+        m_isStoringDisabled = !backupDataFile(dataFileName, false);
+        emit loadingFinished({});
         return;
     }
 
-    emit loadingFinished(loadArticles(readResult.value(), url));
+    if (needsCompaction())
+    {
+        // The records that can't be read are dropped by compaction
+        if (m_hasCorruptedData)
+            backupDataFile(dataFileName, true);
+        store(dataFileName, *articles);
+    }
+
+    emit loadingFinished(*articles);
 }
 
-void RSS::Private::FeedSerializer::store(const Path &dataFileName, const QVector<QVariantHash> &articlesData)
+void RSS::Private::FeedSerializer::store(const Path &dataFileName, const QVector<ArticleData> &articles)
 {
-    QJsonArray arr;
-    for (const QVariantHash &data : articlesData)
-    {
-        auto jsonObj = QJsonObject::fromVariantHash(data);
-        // JSON object doesn't support DateTime so we need to convert it
-        jsonObj[Article::KeyDate] = data[Article::KeyDate].toDateTime().toString(Qt::RFC2822Date);
+    if (m_isStoringDisabled)
+        return;
 
-        arr << jsonObj;
-    }
+    QByteArray data;
+    QDataStream stream {&data, QIODevice::WriteOnly};
+    stream.setVersion(DATA_STREAM_VERSION);
+
+    writeHeader(stream);
+    for (const ArticleData &article : articles)
+        writeArticle(stream, article);
 
-    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(dataFileName, QJsonDocument(arr).toJson());
+    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(dataFileName, data);
     if (!result)
     {
        LogMsg(tr("Failed to save RSS feed in '%1', Reason: %2").arg(dataFileName.toString(), result.error())
               , Log::WARNING);
+       return;
+    }
+
+    m_recordCount = articles.size();
+    m_hasCorruptedData = false;
+    m_articleIDs.clear();
+    m_articleIDs.reserve(articles.size());
+    for (const ArticleData &article : articles)
+        m_articleIDs.insert(article.id);
+}
+
+void RSS::Private::FeedSerializer::storeChanges(const Path &dataFileName, const QString &url
+        , const QVector<ArticleData> &newArticles, const QStringList &readArticleIDs, const QStringList &removedArticleIDs)
+{
+    if (m_isStoringDisabled)
+        return;
+
+    QFile file {dataFileName.data()};
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        LogMsg(tr("Failed to save RSS feed in '%1', Reason: %2").arg(dataFileName.toString(), file.errorString())
+               , Log::WARNING);
+        return;
+    }
+
+    QDataStream stream {&file};
+    stream.setVersion(DATA_STREAM_VERSION);
+
+    if (file.size() == 0)
+        writeHeader(stream);
+
+    // Removed articles go first since they can be added again
+    for (const QString &articleID : removedArticleIDs)
+    {
+        writeArticleID(stream, RecordType::ArticleRemoved, articleID);
+        m_articleIDs.remove(articleID);
+    }
+
+    for (const ArticleData &article : newArticles)
+    {
+        writeArticle(stream, article);
+        m_articleIDs.insert(article.id);
+    }
+
+    for (const QString &articleID : readArticleIDs)
+        writeArticleID(stream, RecordType::ArticleRead, articleID);
+
+    m_recordCount += removedArticleIDs.size() + newArticles.size() + readArticleIDs.size();
+
+    if (!file.flush() || (stream.status() != QDataStream::Ok))
+    {
+        LogMsg(tr("Failed to save RSS feed in '%1', Reason: %2").arg(dataFileName.toString(), file.errorString())
+               , Log::WARNING);
+        m_hasCorruptedData = true;
+    }
+
+    file.close();
+
+    if (needsCompaction())
+    {
+        const auto readResult = Utils::IO::readFile(dataFileName, DATA_FILE_MAX_SIZE);
+        if (!readResult)
+        {
+            LogMsg(tr("Failed to read RSS session data. %1").arg(readResult.error().message), Log::WARNING);
+            return;
+        }
+
+        if (const std::optional<QVector<ArticleData>> articles = loadArticles(readResult.value(), url))
+            store(dataFileName, *articles);
     }
 }
 
-QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArray &data, const QString &url)
+std::optional<QVector<RSS::ArticleData>> RSS::Private::FeedSerializer::loadArticles(const QByteArray &data, const QString &url)
+{
+    m_recordCount = 0;
+    m_hasCorruptedData = false;
+    m_articleIDs.clear();
+
+    QDataStream stream {data};
+    stream.setVersion(DATA_STREAM_VERSION);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if ((magic != DATA_FILE_MAGIC) || (version != DATA_FILE_VERSION))
+    {
+        LogMsg(tr("Couldn't load RSS Session data. Invalid data format."), Log::WARNING);
+        return std::nullopt;
+    }
+
+    QHash<QString, ArticleData> articles;
+    QSet<QString> fieldNames;  // to share the names of extra fields between the articles
+    while (!stream.atEnd())
+    {
+        quint8 recordType = 0;
+        stream >> recordType;
+        switch (static_cast<RecordType>(recordType))
+        {
+        case RecordType::Article:
+            {
+                ArticleData article;
+                QHash<QString, QString> extraFields;
+                stream >> article.id >> article.date >> article.title >> article.author >> article.description
+                        >> article.torrentURL >> article.link >> article.isRead >> extraFields;
+                for (auto it = extraFields.cbegin(); it != extraFields.cend(); ++it)
+                    article.extraFields.insert(*fieldNames.insert(it.key()), it.value());
+
+                if (stream.status() == QDataStream::Ok)
+                    articles.insert(article.id, article);
+            }
+            break;
+        case RecordType::ArticleRead:
+            {
+                QString articleID;
+                stream >> articleID;
+                if (const auto iter = articles.find(articleID); iter != articles.end())
+                    iter->isRead = true;
+            }
+            break;
+        case RecordType::ArticleRemoved:
+            {
+                QString articleID;
+                stream >> articleID;
+                articles.remove(articleID);
+            }
+            break;
+        default:
+            stream.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+
+        if (stream.status() != QDataStream::Ok)
+        {
+            // The rest of data can't be read, e.g. it wasn't completely written
+            LogMsg(tr("Couldn't load RSS article '%1#%2'. Invalid data format.")
+                   .arg(url, QString::number(m_recordCount)), Log::WARNING);
+            m_hasCorruptedData = true;
+            break;
+        }
+
+        ++m_recordCount;
+    }
+
+    QVector<ArticleData> result;
+    result.reserve(articles.size());
+    m_articleIDs.reserve(articles.size());
+    for (const ArticleData &article : asConst(articles))
+    {
+        result.append(article);
+        m_articleIDs.insert(article.id);
+    }
+
+    sortArticles(result);
+    return result;
+}
+
+std::optional<QVector<RSS::ArticleData>> RSS::Private::FeedSerializer::loadLegacyArticles(const QByteArray &data, const QString &url)
 {
     QJsonParseError jsonError;
     const QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &jsonError);
@@ -90,16 +339,18 @@ QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArra
     {
         LogMsg(tr("Couldn't parse RSS Session data. Error: %1").arg(jsonError.errorString())
                , Log::WARNING);
-        return {};
+        return std::nullopt;
     }
 
     if (!jsonDoc.isArray())
     {
         LogMsg(tr("Couldn't load RSS Session data. Invalid data format."), Log::WARNING);
-        return {};
+        return std::nullopt;
     }
 
-    QVector<QVariantHash> result;
+    QVector<ArticleData> result;
+    QSet<QString> articleIDs;
+    QSet<QString> fieldNames;  // to share the names of extra fields between the articles
     const QJsonArray jsonArr = jsonDoc.array();
     result.reserve(jsonArr.size());
     for (int i = 0; i < jsonArr.size(); ++i)
@@ -112,19 +363,61 @@ QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArra
             continue;
         }
 
-        const auto jsonObj = jsonVal.toObject();
-        auto varHash = jsonObj.toVariantHash();
-        // JSON object store DateTime as string so we need to convert it
-        varHash[Article::KeyDate] =
-                QDateTime::fromString(jsonObj.value(Article::KeyDate).toString(), Qt::RFC2822Date);
+        ArticleData article;
+        const QJsonObject jsonObj = jsonVal.toObject();
+        for (auto it = jsonObj.constBegin(); it != jsonObj.constEnd(); ++it)
+        {
+            const QString key = it.key();
+            if (key == Article::KeyId)
+                article.id = it.value().toString();
+            else if (key == Article::KeyDate)
+                // JSON object store DateTime as string so we need to convert it
+                article.date = QDateTime::fromString(it.value().toString(), Qt::RFC2822Date);
+            else if (key == Article::KeyTitle)
+                article.title = it.value().toString();
+            else if (key == Article::KeyAuthor)
+                article.author = it.value().toString();
+            else if (key == Article::KeyDescription)
+                article.description = it.value().toString();
+            else if (key == Article::KeyTorrentURL)
+                article.torrentURL = it.value().toString();
+            else if (key == Article::KeyLink)
+                article.link = it.value().toString();
+            else if (key == Article::KeyIsRead)
+                article.isRead = it.value().toBool();
+            else
+                article.extraFields.insert(*fieldNames.insert(key), it.value().toString());
+        }
+
+        if (articleIDs.contains(article.id)) [[unlikely]]
+            continue;
 
-        result.push_back(varHash);
+        articleIDs.insert(article.id);
+        result.push_back(article);
     }
 
-    std::sort(result.begin(), result.end(), [](const QVariantHash &left, const QVariantHash &right)
-    {
-        return (left.value(Article::KeyDate).toDateTime() > right.value(Article::KeyDate).toDateTime());
-    });
+    sortArticles(result);
+    return result;
+}
+
+bool RSS::Private::FeedSerializer::backupDataFile(const Path &dataFileName, const bool keepOriginal)
+{
+    const Path backupPath = dataFileName + u".bak";
+    Utils::Fs::removeFile(backupPath);
+
+    const bool result = keepOriginal
+            ? Utils::Fs::copyFile(dataFileName, backupPath)
+            : Utils::Fs::renameFile(dataFileName, backupPath);
+    if (result)
+        LogMsg(tr("RSS feed data was backed up. File: \"%1\"").arg(backupPath.toString()), Log::WARNING);
+    else
+        LogMsg(tr("Failed to back up RSS feed data. File: \"%1\"").arg(dataFileName.toString()), Log::WARNING);
 
     return result;
 }
+
+bool RSS::Private::FeedSerializer::needsCompaction() const
+{
+    // Keep the amount of outdated records comparable to the amount of actual ones
+    return m_hasCorruptedData || (m_recordCount > ((2 * m_articleIDs.size()) + 32));
+}
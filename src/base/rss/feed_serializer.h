@@ -31,15 +31,21 @@
 
 #pragma once
 
+#include <optional>
+
 #include <QtContainerFwd>
 #include <QObject>
+#include <QSet>
 #include <QString>
-#include <QVariantHash>
 
 #include "base/pathfwd.h"
+#include "rss_article.h"
 
 namespace RSS::Private
 {
+    // Articles are stored as a log of binary records, so the changes
+    // are appended to the data file instead of rewriting it every time.
+    // The log is compacted when it gets too many outdated records.
     class FeedSerializer final : public QObject
     {
         Q_OBJECT
@@ -48,13 +54,25 @@ namespace RSS::Private
     public:
         using QObject::QObject;
 
-        void load(const Path &dataFileName, const QString &url);
-        void store(const Path &dataFileName, const QVector<QVariantHash> &articlesData);
+        void load(const Path &dataFileName, const Path &legacyDataFileName, const QString &url);
+        void store(const Path &dataFileName, const QVector<ArticleData> &articles);
+        void storeChanges(const Path &dataFileName, const QString &url, const QVector<ArticleData> &newArticles
+                , const QStringList &readArticleIDs, const QStringList &removedArticleIDs);
 
     signals:
-        void loadingFinished(const QVector<QVariantHash> &articles);
+        void loadingFinished(const QVector<RSS::ArticleData> &articles);
 
     private:
-        QVector<QVariantHash> loadArticles(const QByteArray &data, const QString &url);
+        // Return nothing if the data can't be read at all (e.g. it has unknown format)
+        std::optional<QVector<ArticleData>> loadArticles(const QByteArray &data, const QString &url);
+        std::optional<QVector<ArticleData>> loadLegacyArticles(const QByteArray &data, const QString &url);
+        bool backupDataFile(const Path &dataFileName, bool keepOriginal);
+        bool needsCompaction() const;
+
+        int m_recordCount = 0;
+        bool m_hasCorruptedData = false;
+        // Unreadable data file that can't be moved aside must not be changed
+        bool m_isStoringDisabled = false;
+        QSet<QString> m_articleIDs;
     };
 }
@@ -46,72 +46,84 @@ const QString Article::KeyTorrentURL = u"torrentURL"_s;
 const QString Article::KeyLink = u"link"_s;
 const QString Article::KeyIsRead = u"isRead"_s;
 
-Article::Article(Feed *feed, const QVariantHash &varHash)
+Article::Article(Feed *feed, const ArticleData &data)
     : QObject(feed)
     , m_feed(feed)
-    , m_guid(varHash.value(KeyId).toString())
-    , m_date(varHash.value(KeyDate).toDateTime())
-    , m_title(varHash.value(KeyTitle).toString())
-    , m_author(varHash.value(KeyAuthor).toString())
-    , m_description(varHash.value(KeyDescription).toString())
-    , m_torrentURL(varHash.value(KeyTorrentURL).toString())
-    , m_link(varHash.value(KeyLink).toString())
-    , m_isRead(varHash.value(KeyIsRead, false).toBool())
-    , m_data(varHash)
+    , m_data(data)
 {
 }
 
 QString Article::guid() const
 {
-    return m_guid;
+    return m_data.id;
 }
 
 QDateTime Article::date() const
 {
-    return m_date;
+    return m_data.date;
 }
 
 QString Article::title() const
 {
-    return m_title;
+    return m_data.title;
 }
 
 QString Article::author() const
 {
-    return m_author;
+    return m_data.author;
 }
 
 QString Article::description() const
 {
-    return m_description;
+    return m_data.description;
 }
 
 QString Article::torrentUrl() const
 {
-    return (m_torrentURL.isEmpty() ? m_link : m_torrentURL);
+    return (m_data.torrentURL.isEmpty() ? m_data.link : m_data.torrentURL);
 }
 
 QString Article::link() const
 {
-    return m_link;
+    return m_data.link;
 }
 
 bool Article::isRead() const
 {
-    return m_isRead;
+    return m_data.isRead;
 }
 
 QVariantHash Article::data() const
 {
-    return m_data;
+    QVariantHash varHash;
+    varHash.reserve(m_data.extraFields.size() + 8);
+    for (auto it = m_data.extraFields.cbegin(); it != m_data.extraFields.cend(); ++it)
+        varHash.insert(it.key(), it.value());
+
+    const auto insertField = [&varHash](const QString &key, const QString &value)
+    {
+        if (!value.isEmpty())
+            varHash[key] = value;
+    };
+
+    insertField(KeyId, m_data.id);
+    insertField(KeyTitle, m_data.title);
+    insertField(KeyAuthor, m_data.author);
+    insertField(KeyDescription, m_data.description);
+    insertField(KeyTorrentURL, m_data.torrentURL);
+    insertField(KeyLink, m_data.link);
+    if (m_data.date.isValid())
+        varHash[KeyDate] = m_data.date;
+    varHash[KeyIsRead] = m_data.isRead;
+
+    return varHash;
 }
 
 void Article::markAsRead()
 {
-    if (!m_isRead)
+    if (!m_data.isRead)
     {
-        m_isRead = true;
-        m_data[KeyIsRead] = m_isRead;
+        m_data.isRead = true;
         emit read(this);
     }
 }
@@ -31,6 +31,7 @@
 #pragma once
 
 #include <QDateTime>
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QVariantHash>
@@ -39,6 +40,19 @@ namespace RSS
 {
     class Feed;
 
+    struct ArticleData
+    {
+        QString id;
+        QDateTime date;
+        QString title;
+        QString author;
+        QString description;
+        QString torrentURL;
+        QString link;
+        bool isRead = false;
+        QHash<QString, QString> extraFields;  // other elements of the feed item
+    };
+
     class Article final : public QObject
     {
         Q_OBJECT
@@ -46,7 +60,7 @@ namespace RSS
 
         friend class Feed;
 
-        Article(Feed *feed, const QVariantHash &varHash);
+        Article(Feed *feed, const ArticleData &data);
 
     public:
         static const QString KeyId;
@@ -78,14 +92,6 @@ namespace RSS
 
     private:
         Feed *m_feed = nullptr;
-        QString m_guid;
-        QDateTime m_date;
-        QString m_title;
-        QString m_author;
-        QString m_description;
-        QString m_torrentURL;
-        QString m_link;
-        bool m_isRead = false;
-        QVariantHash m_data;
+        ArticleData m_data;
     };
 }
@@ -0,0 +1,190 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#include "rss_articletitleindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QChar>
+#include <QString>
+#include <QStringList>
+
+#include "base/global.h"
+#include "rss_article.h"
+
+namespace
+{
+    const int TRIGRAM_SIZE = 3;
+
+    QString foldCase(const QString &text)
+    {
+        // Fold characters one by one, the same way the case insensitive regular expressions do
+        QString result;
+        result.reserve(text.size());
+        for (const QChar ch : text)
+            result.append(ch.toCaseFolded());
+        return result;
+    }
+
+    bool hasSurrogates(const QString &text)
+    {
+        return std::any_of(text.cbegin(), text.cend(), [](const QChar ch) { return ch.isSurrogate(); });
+    }
+}
+
+void RSS::Private::ArticleTitleIndex::addArticle(Article *article)
+{
+    Q_ASSERT(!m_articleNumbers.contains(article));
+
+    const int articleNumber = m_articles.size();
+    m_articles.append(article);
+    m_articleNumbers.insert(article, articleNumber);
+
+    const QVector<Trigram> titleTrigrams = trigrams(foldCase(article->title()));
+    for (const Trigram trigram : titleTrigrams)
+        m_postings[trigram].append(articleNumber);
+}
+
+void RSS::Private::ArticleTitleIndex::removeArticle(const Article *article)
+{
+    const auto iter = m_articleNumbers.constFind(article);
+    if (iter == m_articleNumbers.cend()) [[unlikely]]
+        return;
+
+    m_articles[iter.value()] = nullptr;
+    m_articleNumbers.erase(iter);
+
+    // Removed articles are just skipped until they become the majority
+    if (m_articles.size() > (2 * m_articleNumbers.size()))
+        compact();
+}
+
+void RSS::Private::ArticleTitleIndex::clear()
+{
+    m_articles.clear();
+    m_articleNumbers.clear();
+    m_postings.clear();
+}
+
+QVector<RSS::Article *> RSS::Private::ArticleTitleIndex::findArticles(const QStringList &titleFragments) const
+{
+    QVector<Trigram> requiredTrigrams;
+    for (const QString &fragment : titleFragments)
+    {
+        // Case folding of surrogate pairs can't be done by code units
+        if ((fragment.size() < TRIGRAM_SIZE) || hasSurrogates(fragment))
+            continue;
+
+        requiredTrigrams.append(trigrams(foldCase(fragment)));
+    }
+
+    QVector<Article *> result;
+    if (requiredTrigrams.isEmpty())
+    {
+        result.reserve(m_articleNumbers.size());
+        for (Article *article : asConst(m_articles))
+        {
+            if (article)
+                result.append(article);
+        }
+
+        return result;
+    }
+
+    std::sort(requiredTrigrams.begin(), requiredTrigrams.end());
+    requiredTrigrams.erase(std::unique(requiredTrigrams.begin(), requiredTrigrams.end()), requiredTrigrams.end());
+
+    QVector<const QVector<int> *> postings;
+    postings.reserve(requiredTrigrams.size());
+    for (const Trigram trigram : asConst(requiredTrigrams))
+    {
+        const auto iter = m_postings.constFind(trigram);
+        if (iter == m_postings.cend())
+            return {};
+
+        postings.append(&iter.value());
+    }
+
+    // Start intersection from the shortest posting list
+    std::sort(postings.begin(), postings.end(), [](const QVector<int> *left, const QVector<int> *right)
+    {
+        return (left->size() < right->size());
+    });
+
+    QVector<int> articleNumbers = *postings.first();
+    QVector<int> intersection;
+    for (auto iter = std::next(postings.cbegin()); (iter != postings.cend()) && !articleNumbers.isEmpty(); ++iter)
+    {
+        const QVector<int> &posting = **iter;
+        intersection.clear();
+        std::set_intersection(articleNumbers.cbegin(), articleNumbers.cend()
+                , posting.cbegin(), posting.cend(), std::back_inserter(intersection));
+        articleNumbers.swap(intersection);
+    }
+
+    result.reserve(articleNumbers.size());
+    for (const int articleNumber : asConst(articleNumbers))
+    {
+        if (Article *article = m_articles[articleNumber])
+            result.append(article);
+    }
+
+    return result;
+}
+
+QVector<RSS::Private::ArticleTitleIndex::Trigram> RSS::Private::ArticleTitleIndex::trigrams(const QString &text)
+{
+    QVector<Trigram> result;
+    if (text.size() < TRIGRAM_SIZE)
+        return result;
+
+    result.reserve(text.size() - TRIGRAM_SIZE + 1);
+    for (qsizetype i = 0; i <= (text.size() - TRIGRAM_SIZE); ++i)
+    {
+        result.append((static_cast<Trigram>(text[i].unicode()) << 32)
+                | (static_cast<Trigram>(text[i + 1].unicode()) << 16)
+                | static_cast<Trigram>(text[i + 2].unicode()));
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void RSS::Private::ArticleTitleIndex::compact()
+{
+    const QVector<Article *> articles = m_articles;
+    clear();
+    for (Article *article : articles)
+    {
+        if (article)
+            addArticle(article);
+    }
+}
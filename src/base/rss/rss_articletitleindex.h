@@ -0,0 +1,71 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#pragma once
+
+#include <QtContainerFwd>
+#include <QtTypes>
+#include <QHash>
+#include <QVector>
+
+class QString;
+
+namespace RSS
+{
+    class Article;
+}
+
+namespace RSS::Private
+{
+    // Index of case folded trigrams of the article titles.
+    // It allows to find the articles which titles contain some fragments
+    // without checking all the articles.
+    class ArticleTitleIndex
+    {
+    public:
+        void addArticle(Article *article);
+        void removeArticle(const Article *article);
+        void clear();
+
+        // Returns the articles which titles can contain all the given fragments (ignoring case).
+        // Result can include some articles that don't contain the fragments,
+        // e.g. the fragments that are shorter than trigram don't restrict the result.
+        QVector<Article *> findArticles(const QStringList &titleFragments) const;
+
+    private:
+        using Trigram = quint64;
+
+        static QVector<Trigram> trigrams(const QString &text);
+        void compact();
+
+        QVector<Article *> m_articles;  // removed articles are replaced by nullptr
+        QHash<const Article *, int> m_articleNumbers;
+        QHash<Trigram, QVector<int>> m_postings;  // article numbers in ascending order
+    };
+}
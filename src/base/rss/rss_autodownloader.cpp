@@ -29,13 +29,16 @@
 #include "rss_autodownloader.h"
 
 #include <queue>
+#include <utility>
 
+#include <QCoreApplication>
 #include <QDataStream>
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUrl>
 #include <QVariant>
@@ -51,6 +54,7 @@
 #include "../utils/io.h"
 #include "rss_article.h"
 #include "rss_autodownloadrule.h"
+#include "rss_autodownloadrulematcher.h"
 #include "rss_feed.h"
 #include "rss_folder.h"
 #include "rss_session.h"
@@ -215,6 +219,7 @@ bool AutoDownloader::renameRule(const QString &ruleName, const QString &newRuleN
     const auto index = m_rulesByName.take(ruleName);
     m_rules[index].setName(newRuleName);
     m_rulesByName.insert(newRuleName, index);
+    m_ruleMatcher.reset();
     m_dirty = true;
     store();
     emit ruleRenamed(newRuleName, ruleName);
@@ -236,6 +241,7 @@ void AutoDownloader::removeRule(const QString &ruleName)
         m_rulesByName[rule.name()] = i;
     }
 
+    m_ruleMatcher.reset();
     m_dirty = true;
     store();
 }
@@ -350,12 +356,61 @@ void AutoDownloader::process()
     if (m_processingQueue.isEmpty()) // processing was disabled
         return;
 
-    processJob(m_processingQueue.takeFirst());
-    if (!m_processingQueue.isEmpty())
+    // wait for the articles being matched to be processed
+    if (m_isMatchingArticles)
+        return;
+
+    if (!m_ruleMatcher)
+        m_ruleMatcher = QSharedPointer<const AutoDownloadRuleMatcher>::create(m_rules);
+
+    const QList<QSharedPointer<ProcessingJob>> jobs = std::exchange(m_processingQueue, {});
+    QList<std::pair<QString, QString>> articles;  // <feed URL, article title>
+    articles.reserve(jobs.size());
+    for (const QSharedPointer<ProcessingJob> &job : jobs)
+        articles.append({job->feedURL, job->articleData.value(Article::KeyTitle).toString()});
+
+    m_isMatchingArticles = true;
+
+    // Matching a lot of articles against a lot of rules shouldn't block the main thread,
+    // so the rules that can accept the articles are found in worker thread
+    QThreadPool::globalInstance()->start([autoDownloader = QPointer<AutoDownloader>(this), jobs
+            , ruleMatcher = m_ruleMatcher, articles = std::move(articles)]
     {
-        // Schedule to process the next torrent (if any)
-        m_processingTimer->start();
+        QList<QStringList> candidateRuleNames;
+        candidateRuleNames.reserve(articles.size());
+        for (const auto &[feedURL, articleTitle] : articles)
+            candidateRuleNames.append(ruleMatcher->findCandidates(feedURL, articleTitle));
+
+        QMetaObject::invokeMethod(qApp, [autoDownloader, jobs, ruleMatcher
+                , candidateRuleNames = std::move(candidateRuleNames)]
+        {
+            if (autoDownloader)
+                autoDownloader->processJobs(jobs, ruleMatcher, candidateRuleNames);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AutoDownloader::processJobs(const QList<QSharedPointer<ProcessingJob>> &jobs
+        , const QSharedPointer<const AutoDownloadRuleMatcher> &ruleMatcher, const QList<QStringList> &candidateRuleNames)
+{
+    m_isMatchingArticles = false;
+
+    if (!isProcessingEnabled())
+        return;
+
+    if (ruleMatcher == m_ruleMatcher)
+    {
+        for (qsizetype i = 0; i < jobs.size(); ++i)
+            processJob(jobs[i], candidateRuleNames[i]);
+    }
+    else
+    {
+        // The rules were changed in the meantime so the articles should be matched again
+        resetProcessingQueue();
     }
+
+    if (!m_processingQueue.isEmpty() && !m_processingTimer->isActive())
+        m_processingTimer->start();
 }
 
 void AutoDownloader::handleTorrentDownloadFinished(const QString &url)
@@ -392,6 +447,7 @@ void AutoDownloader::handleFeedURLChanged(Feed *feed, const QString &oldURL)
             auto feedURLs = rule.feedURLs();
             feedURLs.replace(i, feed->url());
             rule.setFeedURLs(feedURLs);
+            m_ruleMatcher.reset();
             m_dirty = true;
         }
     }
@@ -424,6 +480,8 @@ void AutoDownloader::setRule_impl(const AutoDownloadRule &rule)
     {
         m_rules[index] = rule;
     }
+
+    m_ruleMatcher.reset();
 }
 
 void AutoDownloader::sortRules()
@@ -454,14 +512,17 @@ void AutoDownloader::addJobForArticle(const Article *article)
         m_processingTimer->start();
 }
 
-void AutoDownloader::processJob(const QSharedPointer<ProcessingJob> &job)
+void AutoDownloader::processJob(const QSharedPointer<ProcessingJob> &job, const QStringList &candidateRuleNames)
 {
-    for (AutoDownloadRule &rule : m_rules)
+    // Candidates are ordered by priority and they need to be checked by the rules themselves
+    for (const QString &ruleName : candidateRuleNames)
     {
-        if (!rule.isEnabled())
-            continue;
-        if (!rule.feedURLs().contains(job->feedURL))
+        const auto ruleIndex = m_rulesByName.value(ruleName, -1);
+        Q_ASSERT(ruleIndex >= 0);
+        if (ruleIndex < 0) [[unlikely]]
             continue;
+
+        AutoDownloadRule &rule = m_rules[ruleIndex];
         if (!rule.accepts(job->articleData))
             continue;
 
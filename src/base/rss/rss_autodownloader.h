@@ -54,6 +54,7 @@ namespace RSS
     class Item;
 
     class AutoDownloadRule;
+    class AutoDownloadRuleMatcher;
 
     class ParsingError : public RuntimeError
     {
@@ -122,7 +123,9 @@ namespace RSS
         void resetProcessingQueue();
         void startProcessing();
         void addJobForArticle(const Article *article);
-        void processJob(const QSharedPointer<ProcessingJob> &job);
+        void processJobs(const QList<QSharedPointer<ProcessingJob>> &jobs
+                , const QSharedPointer<const AutoDownloadRuleMatcher> &ruleMatcher, const QList<QStringList> &candidateRuleNames);
+        void processJob(const QSharedPointer<ProcessingJob> &job, const QStringList &candidateRuleNames);
         void load();
         void loadRules(const QByteArray &data);
         void loadRulesLegacy();
@@ -144,6 +147,8 @@ namespace RSS
         AsyncFileStorage *m_fileStorage = nullptr;
         QList<AutoDownloadRule> m_rules;
         QHash<QString, qsizetype> m_rulesByName;
+        QSharedPointer<const AutoDownloadRuleMatcher> m_ruleMatcher;  // is rebuilt on demand when rules are changed
+        bool m_isMatchingArticles = false;
         QList<QSharedPointer<ProcessingJob>> m_processingQueue;
         QHash<QString, QSharedPointer<ProcessingJob>> m_waitingJobs;
         bool m_dirty = false;
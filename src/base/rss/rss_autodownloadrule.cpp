@@ -36,6 +36,7 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QRegularExpression>
+#include <QSet>
 #include <QSharedData>
 #include <QString>
 #include <QStringList>
@@ -64,6 +65,26 @@ namespace
         return boolValue.has_value() ? *boolValue : QJsonValue {};
     }
 
+    // Returns the literal fragments of wildcards that must be contained in the matching titles
+    QStringList literalFragments(const QString &expression)
+    {
+        static const QRegularExpression whitespace {u"\\s+"_s};
+        static const QRegularExpression wildcardChars {u"[*?]"_s};
+
+        QStringList fragments;
+        const QStringList wildcards {expression.split(whitespace, Qt::SkipEmptyParts)};
+        for (const QString &wildcard : wildcards)
+        {
+            // Character sets and escaped characters are too complex to take them into account
+            if (wildcard.contains(u'[') || wildcard.contains(u'\\'))
+                continue;
+
+            fragments.append(wildcard.split(wildcardChars, Qt::SkipEmptyParts));
+        }
+
+        return fragments;
+    }
+
     std::optional<bool> addPausedLegacyToOptionalBool(const int val)
     {
         switch (val)
@@ -225,8 +246,6 @@ QRegularExpression AutoDownloadRule::cachedRegex(const QString &expression, cons
 
 bool AutoDownloadRule::matchesExpression(const QString &articleTitle, const QString &expression) const
 {
-    const QRegularExpression whitespace {u"\\s+"_s};
-
     if (expression.isEmpty())
     {
         // A regex of the form "expr|" will always match, so do the same for wildcards
@@ -241,6 +260,7 @@ bool AutoDownloadRule::matchesExpression(const QString &articleTitle, const QStr
 
     // Only match if every wildcard token (separated by spaces) is present in the article name.
     // Order of wildcard tokens is unimportant (if order is important, they should have used *).
+    static const QRegularExpression whitespace {u"\\s+"_s};
     const QStringList wildcards {expression.split(whitespace, Qt::SkipEmptyParts)};
     for (const QString &wildcard : wildcards)
     {
@@ -404,14 +424,17 @@ bool AutoDownloadRule::matchesSmartEpisodeFilter(const QString &articleTitle) co
 
 bool AutoDownloadRule::matches(const QVariantHash &articleData) const
 {
-    const QDateTime articleDate {articleData[Article::KeyDate].toDateTime()};
+    return matches(articleData[Article::KeyTitle].toString(), articleData[Article::KeyDate].toDateTime());
+}
+
+bool AutoDownloadRule::matches(const QString &articleTitle, const QDateTime &articleDate) const
+{
     if (ignoreDays() > 0)
     {
         if (lastMatch().isValid() && (articleDate < lastMatch().addDays(ignoreDays())))
             return false;
     }
 
-    const QString articleTitle {articleData[Article::KeyTitle].toString()};
     if (!matchesMustContainExpression(articleTitle))
         return false;
     if (!matchesMustNotContainExpression(articleTitle))
@@ -441,6 +464,41 @@ bool AutoDownloadRule::accepts(const QVariantHash &articleData)
     return true;
 }
 
+QList<Article *> AutoDownloadRule::findMatchingArticles(const Feed *feed) const
+{
+    QList<Article *> candidates;
+    if (m_dataPtr->useRegex || m_dataPtr->mustContain.isEmpty())
+    {
+        // Regular expressions can't be checked using title index
+        candidates = feed->articles();
+    }
+    else
+    {
+        // Accept if any complete expression matches, so the candidates of all expressions are united
+        QSet<Article *> candidateSet;
+        for (const QString &expression : asConst(m_dataPtr->mustContain))
+        {
+            const QList<Article *> expressionCandidates = feed->findArticlesByTitle(literalFragments(expression));
+            candidateSet.unite(QSet<Article *>(expressionCandidates.cbegin(), expressionCandidates.cend()));
+        }
+
+        candidates = candidateSet.values();
+        std::sort(candidates.begin(), candidates.end(), [](const Article *left, const Article *right)
+        {
+            return (left->date() > right->date());
+        });
+    }
+
+    QList<Article *> matchingArticles;
+    for (Article *article : asConst(candidates))
+    {
+        if (matches(article->title(), article->date()))
+            matchingArticles.append(article);
+    }
+
+    return matchingArticles;
+}
+
 AutoDownloadRule &AutoDownloadRule::operator=(const AutoDownloadRule &other)
 {
     if (this != &other)
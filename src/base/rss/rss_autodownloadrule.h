@@ -44,6 +44,8 @@ class QRegularExpression;
 
 namespace RSS
 {
+    class Article;
+    class Feed;
     struct AutoDownloadRuleData;
 
     class AutoDownloadRule
@@ -89,6 +91,8 @@ namespace RSS
 
         bool matches(const QVariantHash &articleData) const;
         bool accepts(const QVariantHash &articleData);
+        // Articles are ordered from the newest to the oldest
+        QList<Article *> findMatchingArticles(const Feed *feed) const;
 
         friend bool operator==(const AutoDownloadRule &left, const AutoDownloadRule &right);
 
@@ -99,6 +103,7 @@ namespace RSS
         static AutoDownloadRule fromLegacyDict(const QVariantHash &dict);
 
     private:
+        bool matches(const QString &articleTitle, const QDateTime &articleDate) const;
         bool matchesMustContainExpression(const QString &articleTitle) const;
         bool matchesMustNotContainExpression(const QString &articleTitle) const;
         bool matchesEpisodeFilterExpression(const QString &articleTitle) const;
@@ -0,0 +1,254 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#include "rss_autodownloadrulematcher.h"
+
+#include <algorithm>
+
+#include <QBitArray>
+#include <QChar>
+#include <QQueue>
+
+#include "base/global.h"
+#include "base/utils/string.h"
+#include "rss_autodownloadrule.h"
+
+namespace
+{
+    char16_t foldCase(const char16_t ch)
+    {
+        return QChar(ch).toCaseFolded().unicode();
+    }
+
+    // Wildcards that don't contain any special characters match any text
+    // containing them, so they can be found without using regular expressions
+    bool isKeyword(const QString &wildcard)
+    {
+        return std::none_of(wildcard.cbegin(), wildcard.cend(), [](const QChar ch)
+        {
+            // slashes are handled specially on some platforms when converting wildcards
+            return (ch == u'*') || (ch == u'?') || (ch == u'[') || (ch == u'\\') || (ch == u'/') || ch.isSurrogate();
+        });
+    }
+}
+
+using namespace RSS;
+
+AutoDownloadRuleMatcher::AutoDownloadRuleMatcher(const QList<AutoDownloadRule> &rules)
+    : m_keywordNodes(1)
+{
+    m_rules.reserve(rules.size());
+    for (const AutoDownloadRule &rule : rules)
+    {
+        if (!rule.isEnabled())
+            continue;
+
+        const int ruleIndex = m_rules.size();
+        m_rules.append({rule.name(), compileExpressions(rule.mustContain(), rule.useRegex())
+                , compileExpressions(rule.mustNotContain(), rule.useRegex())});
+
+        const QStringList feedURLs = rule.feedURLs();
+        for (const QString &feedURL : feedURLs)
+        {
+            QVector<int> &feedRules = m_rulesByFeedURL[feedURL];
+            if (feedRules.isEmpty() || (feedRules.last() != ruleIndex))
+                feedRules.append(ruleIndex);
+        }
+    }
+
+    buildKeywordAutomaton();
+}
+
+QStringList AutoDownloadRuleMatcher::findCandidates(const QString &feedURL, const QString &articleTitle) const
+{
+    const QVector<int> ruleIndexes = m_rulesByFeedURL.value(feedURL);
+    if (ruleIndexes.isEmpty())
+        return {};
+
+    const QBitArray foundKeywords = findKeywords(articleTitle);
+    const auto matchesTitle = [this, &articleTitle, &foundKeywords](const Expression &expression)
+    {
+        return matches(expression, articleTitle, foundKeywords);
+    };
+
+    QStringList candidates;
+    for (const int ruleIndex : ruleIndexes)
+    {
+        const CompiledRule &rule = m_rules[ruleIndex];
+        if (!rule.mustContain.isEmpty() && std::none_of(rule.mustContain.cbegin(), rule.mustContain.cend(), matchesTitle))
+            continue;
+        if (std::any_of(rule.mustNotContain.cbegin(), rule.mustNotContain.cend(), matchesTitle))
+            continue;
+
+        candidates.append(rule.name);
+    }
+
+    return candidates;
+}
+
+QVector<AutoDownloadRuleMatcher::Expression> AutoDownloadRuleMatcher::compileExpressions(const QString &expressions, const bool isRegex)
+{
+    // Should be kept in sync with the matching logic of AutoDownloadRule
+
+    if (expressions.isEmpty())
+        return {};
+
+    if (isRegex)
+    {
+        QRegularExpression regex {expressions, QRegularExpression::CaseInsensitiveOption};
+        regex.optimize();
+
+        Expression compiledExpression;
+        compiledExpression.regexes.append(regex);
+        return {compiledExpression};
+    }
+
+    const QRegularExpression whitespace {u"\\s+"_s};
+
+    // Each expression is a set of wildcards separated by whitespace
+    const QStringList splitExpressions = expressions.split(u'|');
+    QVector<Expression> result;
+    result.reserve(splitExpressions.size());
+    for (const QString &expression : splitExpressions)
+    {
+        Expression compiledExpression;
+        const QStringList wildcards = expression.split(whitespace, Qt::SkipEmptyParts);
+        for (const QString &wildcard : wildcards)
+        {
+            if (isKeyword(wildcard))
+            {
+                compiledExpression.keywords.append(addKeyword(wildcard));
+            }
+            else
+            {
+                QRegularExpression regex {Utils::String::wildcardToRegexPattern(wildcard), QRegularExpression::CaseInsensitiveOption};
+                regex.optimize();
+                compiledExpression.regexes.append(regex);
+            }
+        }
+
+        result.append(compiledExpression);
+    }
+
+    return result;
+}
+
+int AutoDownloadRuleMatcher::addKeyword(const QString &keyword)
+{
+    QString foldedKeyword;
+    foldedKeyword.reserve(keyword.size());
+    for (const QChar ch : keyword)
+        foldedKeyword.append(QChar(foldCase(ch.unicode())));
+
+    if (const auto iter = m_keywordIndexes.constFind(foldedKeyword); iter != m_keywordIndexes.cend())
+        return iter.value();
+
+    const int keywordIndex = m_keywordIndexes.size();
+    m_keywordIndexes.insert(foldedKeyword, keywordIndex);
+
+    int node = 0;
+    for (const QChar ch : asConst(foldedKeyword))
+    {
+        int nextNode = m_keywordNodes[node].transitions.value(ch.unicode(), 0);
+        if (nextNode == 0)
+        {
+            nextNode = m_keywordNodes.size();
+            m_keywordNodes.append({});
+            m_keywordNodes[node].transitions.insert(ch.unicode(), nextNode);
+        }
+
+        node = nextNode;
+    }
+
+    m_keywordNodes[node].keywords.append(keywordIndex);
+    return keywordIndex;
+}
+
+void AutoDownloadRuleMatcher::buildKeywordAutomaton()
+{
+    // The failure links are computed in breadth-first order,
+    // so the links of all the shallower nodes are already known
+    QQueue<int> nodes;
+    for (const int child : asConst(m_keywordNodes[0].transitions))
+        nodes.enqueue(child);
+
+    while (!nodes.isEmpty())
+    {
+        const int node = nodes.dequeue();
+        const QHash<char16_t, int> transitions = m_keywordNodes[node].transitions;
+        for (auto iter = transitions.cbegin(); iter != transitions.cend(); ++iter)
+        {
+            const char16_t ch = iter.key();
+            const int child = iter.value();
+
+            int failure = m_keywordNodes[node].failure;
+            while ((failure != 0) && !m_keywordNodes[failure].transitions.contains(ch))
+                failure = m_keywordNodes[failure].failure;
+            failure = m_keywordNodes[failure].transitions.value(ch, 0);
+
+            m_keywordNodes[child].failure = failure;
+            // the keywords ending at the failure node end at this node as well
+            m_keywordNodes[child].keywords.append(m_keywordNodes[failure].keywords);
+
+            nodes.enqueue(child);
+        }
+    }
+}
+
+QBitArray AutoDownloadRuleMatcher::findKeywords(const QString &text) const
+{
+    QBitArray foundKeywords {m_keywordIndexes.size()};
+    if (m_keywordIndexes.isEmpty())
+        return foundKeywords;
+
+    int node = 0;
+    for (const QChar textChar : text)
+    {
+        const char16_t ch = foldCase(textChar.unicode());
+        while ((node != 0) && !m_keywordNodes[node].transitions.contains(ch))
+            node = m_keywordNodes[node].failure;
+        node = m_keywordNodes[node].transitions.value(ch, 0);
+
+        for (const int keyword : m_keywordNodes[node].keywords)
+            foundKeywords.setBit(keyword);
+    }
+
+    return foundKeywords;
+}
+
+bool AutoDownloadRuleMatcher::matches(const Expression &expression, const QString &text, const QBitArray &foundKeywords) const
+{
+    const bool containsKeywords = std::all_of(expression.keywords.cbegin(), expression.keywords.cend()
+            , [&foundKeywords](const int keyword) { return foundKeywords.testBit(keyword); });
+    if (!containsKeywords)
+        return false;
+
+    return std::all_of(expression.regexes.cbegin(), expression.regexes.cend()
+            , [&text](const QRegularExpression &regex) { return regex.match(text).hasMatch(); });
+}
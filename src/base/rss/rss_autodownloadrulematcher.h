@@ -0,0 +1,93 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QBitArray;
+
+namespace RSS
+{
+    class AutoDownloadRule;
+
+    // Precompiled form of the rules that allows to quickly find the rules
+    // which can accept some article. It is immutable, so it can be used in any thread.
+    class AutoDownloadRuleMatcher
+    {
+        Q_DISABLE_COPY_MOVE(AutoDownloadRuleMatcher)
+
+    public:
+        explicit AutoDownloadRuleMatcher(const QList<AutoDownloadRule> &rules);
+
+        // Only "must contain" and "must not contain" expressions of enabled rules are checked,
+        // so the returned candidates should be finally checked by the rules themselves.
+        // The rule names are returned in the order the rules were passed.
+        QStringList findCandidates(const QString &feedURL, const QString &articleTitle) const;
+
+    private:
+        // All the conditions must be satisfied
+        struct Expression
+        {
+            QVector<int> keywords;  // indexes of the keywords that must be contained
+            QVector<QRegularExpression> regexes;  // the rest of conditions
+        };
+
+        struct CompiledRule
+        {
+            QString name;
+            QVector<Expression> mustContain;  // any of expressions must match
+            QVector<Expression> mustNotContain;  // none of expressions must match
+        };
+
+        // The keywords are found using Aho-Corasick automaton, so all of them
+        // are found in a single pass over the text
+        struct KeywordNode
+        {
+            QHash<char16_t, int> transitions;
+            int failure = 0;
+            QVector<int> keywords;  // indexes of the keywords that end at this node
+        };
+
+        QVector<Expression> compileExpressions(const QString &expressions, bool isRegex);
+        int addKeyword(const QString &keyword);
+        void buildKeywordAutomaton();
+        QBitArray findKeywords(const QString &text) const;
+        bool matches(const Expression &expression, const QString &text, const QBitArray &foundKeywords) const;
+
+        QVector<CompiledRule> m_rules;
+        QHash<QString, QVector<int>> m_rulesByFeedURL;
+        QHash<QString, int> m_keywordIndexes;
+        QVector<KeywordNode> m_keywordNodes;
+    };
+}
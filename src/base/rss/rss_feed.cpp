@@ -31,8 +31,6 @@
 #include "rss_feed.h"
 
 #include <algorithm>
-#include <utility>
-#include <vector>
 
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -70,14 +68,14 @@ Feed::Feed(const QUuid &uid, const QString &url, const QString &path, Session *s
     , m_url(url)
 {
     const auto uidHex = QString::fromLatin1(m_uid.toRfc4122().toHex());
-    m_dataFileName = Path(uidHex + u".json");
+    m_dataFileName = Path(uidHex + u".dat");
 
     // Move to new file naming scheme (since v4.1.2)
     const QString legacyFilename = Utils::Fs::toValidFileName(m_url, u"_"_s) + u".json";
     const Path storageDir = m_session->dataFileStorage()->storageDir();
-    const Path dataFilePath = storageDir / m_dataFileName;
-    if (!dataFilePath.exists())
-        Utils::Fs::renameFile((storageDir / Path(legacyFilename)), dataFilePath);
+    const Path jsonDataFilePath = storageDir / Path(uidHex + u".json");
+    if (!jsonDataFilePath.exists() && !(storageDir / m_dataFileName).exists())
+        Utils::Fs::renameFile((storageDir / Path(legacyFilename)), jsonDataFilePath);
 
     m_iconPath = storageDir / Path(uidHex + u".ico");
 
@@ -124,13 +122,13 @@ void Feed::markAsRead()
             article->disconnect(this);
             article->markAsRead();
             --m_unreadCount;
+            m_pendingReadArticles.insert(article->guid());
             emit articleRead(article);
         }
     }
 
     if (m_unreadCount != oldUnreadCount)
     {
-        m_dirty = true;
         store();
         emit unreadCountChanged(this);
     }
@@ -145,11 +143,17 @@ void Feed::refresh()
     }
 
     if (m_downloadHandler)
+    {
+        // The cancelled download must not be reported as a finished refresh
+        disconnect(m_downloadHandler, nullptr, this, nullptr);
         m_downloadHandler->cancel();
+    }
 
     // NOTE: Should we allow manually refreshing for disabled session?
 
-    m_downloadHandler = Net::DownloadManager::instance()->download(m_url, Preferences::instance()->useProxyForRSS());
+    // Conditional request allows to avoid downloading and parsing of unchanged feed
+    const auto downloadRequest = Net::DownloadRequest(m_url).ifNoneMatch(m_etag).ifModifiedSince(m_lastModified);
+    m_downloadHandler = Net::DownloadManager::instance()->download(downloadRequest, Preferences::instance()->useProxyForRSS());
     connect(m_downloadHandler, &Net::DownloadHandler::finished, this, &Feed::handleDownloadFinished);
 
     if (!m_iconPath.exists())
@@ -179,6 +183,11 @@ bool Feed::isLoading() const
     return m_isLoading || !m_isInitialized;
 }
 
+bool Feed::isInitialized() const
+{
+    return m_isInitialized;
+}
+
 QString Feed::lastBuildDate() const
 {
     return m_lastBuildDate;
@@ -194,11 +203,16 @@ Article *Feed::articleByGUID(const QString &guid) const
     return m_articles.value(guid);
 }
 
+QList<Article *> Feed::findArticlesByTitle(const QStringList &titleFragments) const
+{
+    return m_titleIndex.findArticles(titleFragments);
+}
+
 void Feed::handleMaxArticlesPerFeedChanged(const int n)
 {
     while (m_articlesByDate.size() > n)
         removeOldestArticle();
-    // We don't need store articles here
+    // Removed articles will be stored along with the next changes
 }
 
 void Feed::handleIconDownloadFinished(const Net::DownloadResult &result)
@@ -218,14 +232,34 @@ void Feed::handleDownloadFinished(const Net::DownloadResult &result)
 {
     m_downloadHandler = nullptr; // will be deleted by DownloadManager later
 
-    if (result.status == Net::DownloadStatus::Success)
+    if (result.status == Net::DownloadStatus::NotModified)
+    {
+        m_isLoading = false;
+        m_hasError = false;
+
+        LogMsg(tr("RSS feed at '%1' is not modified since last refresh.").arg(result.url));
+
+        emit refreshFinished(false);
+        emit stateChanged(this);
+    }
+    else if (result.status == Net::DownloadStatus::Success)
     {
         LogMsg(tr("RSS feed at '%1' is successfully downloaded. Starting to parse it.")
                 .arg(result.url));
+
+        m_etag = result.etag;
+        m_lastModified = result.lastModified;
+
+        QHash<QString, QDateTime> articleDates;
+        articleDates.reserve(m_articles.size());
+        for (const Article *article : asConst(m_articlesByDate))
+            articleDates.insert(article->guid(), article->date());
+
         // Parse the download RSS
-        QMetaObject::invokeMethod(m_parser, [this, data = result.data]()
+        QMetaObject::invokeMethod(m_parser, [parser = m_parser, data = result.data, articleDates
+                , maxArticles = m_session->maxArticlesPerFeed()]()
         {
-            m_parser->parse(data);
+            parser->parse(data, articleDates, maxArticles);
         });
     }
     else
@@ -236,6 +270,7 @@ void Feed::handleDownloadFinished(const Net::DownloadResult &result)
         LogMsg(tr("Failed to download RSS feed at '%1'. Reason: %2")
                .arg(result.url, result.errorString), Log::WARNING);
 
+        emit refreshFinished(false);
         emit stateChanged(this);
     }
 }
@@ -247,25 +282,32 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
     if (!result.title.isEmpty() && (title() != result.title))
     {
         m_title = result.title;
-        m_dirty = true;
         emit titleChanged(this);
     }
 
     if (!result.lastBuildDate.isEmpty())
-    {
         m_lastBuildDate = result.lastBuildDate;
-        m_dirty = true;
+
+    // Parser has already merged the articles with existing ones
+    int newArticlesCount = 0;
+    for (const ArticleData &articleData : result.articles)
+    {
+        // The articles could be added by another parsing result
+        if (m_articles.contains(articleData.id)) [[unlikely]]
+            continue;
+
+        addArticle(articleData);
+        ++newArticlesCount;
     }
 
-    // For some reason, the RSS feed may contain malformed XML data and it may not be
-    // successfully parsed by the XML parser. We are still trying to load as many articles
-    // as possible until we encounter corrupted data. So we can have some articles here
-    // even in case of parsing error.
-    const int newArticlesCount = updateArticles(result.articles);
     store();
 
     if (m_hasError)
     {
+        // Broken feed should be downloaded again
+        m_etag.clear();
+        m_lastModified.clear();
+
         LogMsg(tr("Failed to parse RSS feed at '%1'. Reason: %2").arg(m_url, result.error)
                , Log::WARNING);
     }
@@ -273,38 +315,53 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
            .arg(url(), QString::number(newArticlesCount)));
 
     m_isLoading = false;
+    emit refreshFinished(newArticlesCount > 0);
     emit stateChanged(this);
 }
 
 void Feed::load()
 {
+    const Path storageDir = m_session->dataFileStorage()->storageDir();
     QMetaObject::invokeMethod(m_serializer
-            , [serializer = m_serializer, url = m_url
-                , path = (m_session->dataFileStorage()->storageDir() / m_dataFileName)]
+            , [serializer = m_serializer, url = m_url, path = (storageDir / m_dataFileName)
+                , legacyPath = (storageDir / m_dataFileName.removedExtension() + u".json")]
     {
-        serializer->load(path, url);
+        serializer->load(path, legacyPath, url);
     });
 }
 
 void Feed::store()
 {
-    if (!m_dirty)
+    if (m_pendingNewArticles.isEmpty() && m_pendingReadArticles.isEmpty() && m_pendingRemovedArticles.isEmpty())
         return;
 
-    m_dirty = false;
     m_savingTimer.stop();
 
-    QVector<QVariantHash> articlesData;
-    articlesData.reserve(m_articles.size());
+    QVector<ArticleData> newArticles;
+    newArticles.reserve(m_pendingNewArticles.size());
+    for (const QString &articleID : asConst(m_pendingNewArticles))
+        newArticles.append(m_articles.value(articleID)->m_data);
+
+    // New articles are stored along with their read state
+    QStringList readArticleIDs;
+    readArticleIDs.reserve(m_pendingReadArticles.size());
+    for (const QString &articleID : asConst(m_pendingReadArticles))
+    {
+        if (!m_pendingNewArticles.contains(articleID))
+            readArticleIDs.append(articleID);
+    }
+
+    const QStringList removedArticleIDs = m_pendingRemovedArticles.values();
 
-    for (Article *article :asConst(m_articles))
-        articlesData.push_back(article->data());
+    m_pendingNewArticles.clear();
+    m_pendingReadArticles.clear();
+    m_pendingRemovedArticles.clear();
 
     QMetaObject::invokeMethod(m_serializer
-            , [articlesData, serializer = m_serializer
+            , [newArticles, readArticleIDs, removedArticleIDs, serializer = m_serializer, url = m_url
                 , path = (m_session->dataFileStorage()->storageDir() / m_dataFileName)]
     {
-        serializer->store(path, articlesData);
+        serializer->storeChanges(path, url, newArticles, readArticleIDs, removedArticleIDs);
     });
 }
 
@@ -314,27 +371,28 @@ void Feed::storeDeferred()
         m_savingTimer.start(5 * 1000, this);
 }
 
-bool Feed::addArticle(const QVariantHash &articleData)
+bool Feed::addArticle(const ArticleData &articleData)
 {
-    Q_ASSERT(!m_articles.contains(articleData.value(Article::KeyId).toString()));
+    Q_ASSERT(!m_articles.contains(articleData.id));
 
     // Insertion sort
     const int maxArticles = m_session->maxArticlesPerFeed();
     const auto lowerBound = std::lower_bound(m_articlesByDate.begin(), m_articlesByDate.end()
-                                       , articleData.value(Article::KeyDate).toDateTime(), Article::articleDateRecentThan);
+                                       , articleData.date, Article::articleDateRecentThan);
     if ((lowerBound - m_articlesByDate.begin()) >= maxArticles)
         return false; // we reach max articles
 
     auto *article = new Article(this, articleData);
     m_articles[article->guid()] = article;
     m_articlesByDate.insert(lowerBound, article);
+    m_titleIndex.addArticle(article);
     if (!article->isRead())
     {
         increaseUnreadCount();
         connect(article, &Article::read, this, &Feed::handleArticleRead);
     }
 
-    m_dirty = true;
+    m_pendingNewArticles.insert(article->guid());
     emit newArticle(article);
 
     if (m_articlesByDate.size() > maxArticles)
@@ -348,8 +406,14 @@ void Feed::removeOldestArticle()
     auto *oldestArticle = m_articlesByDate.last();
     emit articleAboutToBeRemoved(oldestArticle);
 
-    m_articles.remove(oldestArticle->guid());
+    const QString articleID = oldestArticle->guid();
+    m_articles.remove(articleID);
     m_articlesByDate.removeLast();
+    m_titleIndex.removeArticle(oldestArticle);
+    // Article that isn't stored yet doesn't need to be removed from the storage
+    if (!m_pendingNewArticles.remove(articleID))
+        m_pendingRemovedArticles.insert(articleID);
+    m_pendingReadArticles.remove(articleID);
     const bool isRead = oldestArticle->isRead();
     delete oldestArticle;
 
@@ -382,74 +446,6 @@ void Feed::downloadIcon()
             , Preferences::instance()->useProxyForRSS(), this, &Feed::handleIconDownloadFinished);
 }
 
-int Feed::updateArticles(const QList<QVariantHash> &loadedArticles)
-{
-    if (loadedArticles.empty())
-        return 0;
-
-    QDateTime dummyPubDate {QDateTime::currentDateTime()};
-    QVector<QVariantHash> newArticles;
-    newArticles.reserve(loadedArticles.size());
-    for (QVariantHash article : loadedArticles)
-    {
-        // If article has no publication date we use feed update time as a fallback.
-        // To prevent processing of "out-of-limit" articles we must not assign dates
-        // that are earlier than the dates of existing articles.
-        const Article *existingArticle = articleByGUID(article[Article::KeyId].toString());
-        if (existingArticle)
-        {
-            dummyPubDate = existingArticle->date().addMSecs(-1);
-            continue;
-        }
-
-        QVariant &articleDate = article[Article::KeyDate];
-        if (!articleDate.toDateTime().isValid())
-            articleDate = dummyPubDate;
-
-        newArticles.append(article);
-    }
-
-    if (newArticles.empty())
-        return 0;
-
-    using ArticleSortAdaptor = std::pair<QDateTime, const QVariantHash *>;
-    std::vector<ArticleSortAdaptor> sortData;
-    const QList<Article *> existingArticles = articles();
-    sortData.reserve(existingArticles.size() + newArticles.size());
-    std::transform(existingArticles.begin(), existingArticles.end(), std::back_inserter(sortData)
-                   , [](const Article *article)
-    {
-        return std::make_pair(article->date(), nullptr);
-    });
-    std::transform(newArticles.begin(), newArticles.end(), std::back_inserter(sortData)
-                   , [](const QVariantHash &article)
-    {
-        return std::make_pair(article[Article::KeyDate].toDateTime(), &article);
-    });
-
-    // Sort article list in reverse chronological order
-    std::sort(sortData.begin(), sortData.end()
-              , [](const ArticleSortAdaptor &a1, const ArticleSortAdaptor &a2)
-    {
-        return (a1.first > a2.first);
-    });
-
-    if (sortData.size() > static_cast<uint>(m_session->maxArticlesPerFeed()))
-        sortData.resize(m_session->maxArticlesPerFeed());
-
-    int newArticlesCount = 0;
-    std::for_each(sortData.crbegin(), sortData.crend(), [this, &newArticlesCount](const ArticleSortAdaptor &a)
-    {
-        if (a.second)
-        {
-            addArticle(*a.second);
-            ++newArticlesCount;
-        }
-    });
-
-    return newArticlesCount;
-}
-
 Path Feed::iconPath() const
 {
     return m_iconPath;
@@ -459,6 +455,8 @@ void Feed::setURL(const QString &url)
 {
     const QString oldURL = m_url;
     m_url = url;
+    m_etag.clear();
+    m_lastModified.clear();
     emit urlChanged(oldURL);
 }
 
@@ -505,31 +503,37 @@ void Feed::handleArticleRead(Article *article)
     decreaseUnreadCount();
     emit articleRead(article);
     // will be stored deferred
-    m_dirty = true;
+    m_pendingReadArticles.insert(article->guid());
     storeDeferred();
 }
 
-void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
+void Feed::handleArticleLoadFinished(QVector<ArticleData> articles)
 {
     Q_ASSERT(m_articles.isEmpty());
     Q_ASSERT(m_unreadCount == 0);
 
     const int maxArticles = m_session->maxArticlesPerFeed();
     if (articles.size() > maxArticles)
+    {
+        // Out-of-limit articles will be removed from the storage along with the next changes
+        for (auto it = (articles.cbegin() + maxArticles); it != articles.cend(); ++it)
+            m_pendingRemovedArticles.insert(it->id);
         articles.resize(maxArticles);
+    }
 
     m_articles.reserve(articles.size());
     m_articlesByDate.reserve(articles.size());
 
-    for (const QVariantHash &articleData : articles)
+    for (const ArticleData &articleData : asConst(articles))
     {
-        const auto articleID = articleData.value(Article::KeyId).toString();
+        const QString &articleID = articleData.id;
         if (m_articles.contains(articleID)) [[unlikely]]
             continue;
 
         auto *article = new Article(this, articleData);
         m_articles[articleID] = article;
         m_articlesByDate.append(article);
+        m_titleIndex.addArticle(article);
         if (!article->isRead())
         {
             ++m_unreadCount;
@@ -554,9 +558,13 @@ void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
 
 void Feed::cleanup()
 {
-    m_dirty = false;
+    m_pendingNewArticles.clear();
+    m_pendingReadArticles.clear();
+    m_pendingRemovedArticles.clear();
     m_savingTimer.stop();
-    Utils::Fs::removeFile(m_session->dataFileStorage()->storageDir() / m_dataFileName);
+    const Path storageDir = m_session->dataFileStorage()->storageDir();
+    Utils::Fs::removeFile(storageDir / m_dataFileName);
+    Utils::Fs::removeFile(storageDir / m_dataFileName.removedExtension() + u".json");
     Utils::Fs::removeFile(m_iconPath);
 }
 
@@ -34,10 +34,12 @@
 #include <QBasicTimer>
 #include <QHash>
 #include <QList>
+#include <QSet>
 #include <QUuid>
-#include <QVariantHash>
 
 #include "base/path.h"
+#include "rss_article.h"
+#include "rss_articletitleindex.h"
 #include "rss_item.h"
 
 class AsyncFileStorage;
@@ -50,7 +52,6 @@ namespace Net
 
 namespace RSS
 {
-    class Article;
     class Session;
 
     namespace Private
@@ -82,7 +83,11 @@ namespace RSS
         QString lastBuildDate() const;
         bool hasError() const;
         bool isLoading() const;
+        bool isInitialized() const;
         Article *articleByGUID(const QString &guid) const;
+        // Returns the articles which titles can contain all the given fragments,
+        // so the result still needs to be checked by the caller
+        QList<Article *> findArticlesByTitle(const QStringList &titleFragments) const;
         Path iconPath() const;
 
         QJsonValue toJsonValue(bool withData = false) const override;
@@ -92,6 +97,7 @@ namespace RSS
         void titleChanged(Feed *feed = nullptr);
         void stateChanged(Feed *feed = nullptr);
         void urlChanged(const QString &oldURL);
+        void refreshFinished(bool hasNewArticles);
 
     private slots:
         void handleSessionProcessingEnabledChanged(bool enabled);
@@ -100,7 +106,7 @@ namespace RSS
         void handleDownloadFinished(const Net::DownloadResult &result);
         void handleParsingFinished(const Private::ParsingResult &result);
         void handleArticleRead(Article *article);
-        void handleArticleLoadFinished(QVector<QVariantHash> articles);
+        void handleArticleLoadFinished(QVector<RSS::ArticleData> articles);
 
     private:
         void timerEvent(QTimerEvent *event) override;
@@ -108,12 +114,11 @@ namespace RSS
         void load();
         void store();
         void storeDeferred();
-        bool addArticle(const QVariantHash &articleData);
+        bool addArticle(const ArticleData &articleData);
         void removeOldestArticle();
         void increaseUnreadCount();
         void decreaseUnreadCount();
         void downloadIcon();
-        int updateArticles(const QList<QVariantHash> &loadedArticles);
         void setURL(const QString &url);
 
         Session *m_session = nullptr;
@@ -129,11 +134,18 @@ namespace RSS
         bool m_pendingRefresh = false;
         QHash<QString, Article *> m_articles;
         QList<Article *> m_articlesByDate;
+        Private::ArticleTitleIndex m_titleIndex;
         int m_unreadCount = 0;
         Path m_iconPath;
         Path m_dataFileName;
         QBasicTimer m_savingTimer;
-        bool m_dirty = false;
+        // changes that aren't stored yet
+        QSet<QString> m_pendingNewArticles;
+        QSet<QString> m_pendingReadArticles;
+        QSet<QString> m_pendingRemovedArticles;
         Net::DownloadHandler *m_downloadHandler = nullptr;
+        // validators of the last downloaded content
+        QString m_etag;
+        QString m_lastModified;
     };
 }
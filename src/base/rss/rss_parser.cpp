@@ -29,6 +29,10 @@
 
 #include "rss_parser.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <QDateTime>
 #include <QDebug>
 #include <QGlobalStatic>
@@ -36,7 +40,6 @@
 #include <QMetaObject>
 #include <QRegularExpression>
 #include <QStringList>
-#include <QVariant>
 #include <QXmlStreamEntityResolver>
 #include <QXmlStreamReader>
 
@@ -547,7 +550,7 @@ RSS::Private::Parser::Parser(const QString &lastBuildDate)
 }
 
 // read and create items from a rss document
-void RSS::Private::Parser::parse(const QByteArray &feedData)
+void RSS::Private::Parser::parse(const QByteArray &feedData, const QHash<QString, QDateTime> &existingArticleDates, const int maxArticles)
 {
     QXmlStreamReader xml {feedData};
     XmlStreamEntityResolver resolver;
@@ -595,6 +598,12 @@ void RSS::Private::Parser::parse(const QByteArray &feedData)
         m_result.error = tr("Invalid RSS feed.");
     }
 
+    // For some reason, the RSS feed may contain malformed XML data and it may not be
+    // successfully parsed by the XML parser. We are still trying to load as many articles
+    // as possible until we encounter corrupted data. So we can have some articles here
+    // even in case of parsing error.
+    mergeArticles(existingArticleDates, maxArticles);
+
     emit finished(m_result);
     m_result.articles.clear();
     m_result.error.clear();
@@ -603,7 +612,7 @@ void RSS::Private::Parser::parse(const QByteArray &feedData)
 
 void RSS::Private::Parser::parseRssArticle(QXmlStreamReader &xml)
 {
-    QVariantHash article;
+    ArticleData article;
     QString altTorrentUrl;
 
     while (!xml.atEnd())
@@ -618,12 +627,12 @@ void RSS::Private::Parser::parseRssArticle(QXmlStreamReader &xml)
         {
             if (name == u"title")
             {
-                article[Article::KeyTitle] = xml.readElementText().trimmed();
+                article.title = xml.readElementText().trimmed();
             }
             else if (name == u"enclosure")
             {
                 if (xml.attributes().value(u"type"_s) == u"application/x-bittorrent")
-                    article[Article::KeyTorrentURL] = xml.attributes().value(u"url"_s).toString();
+                    article.torrentURL = xml.attributes().value(u"url"_s).toString();
                 else if (xml.attributes().value(u"type"_s).isEmpty())
                     altTorrentUrl = xml.attributes().value(u"url"_s).toString();
             }
@@ -631,35 +640,35 @@ void RSS::Private::Parser::parseRssArticle(QXmlStreamReader &xml)
             {
                 const QString text {xml.readElementText().trimmed()};
                 if (text.startsWith(u"magnet:", Qt::CaseInsensitive))
-                    article[Article::KeyTorrentURL] = text; // magnet link instead of a news URL
+                    article.torrentURL = text; // magnet link instead of a news URL
                 else
-                    article[Article::KeyLink] = text;
+                    article.link = text;
             }
             else if (name == u"description")
             {
-                article[Article::KeyDescription] = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+                article.description = xml.readElementText(QXmlStreamReader::IncludeChildElements);
             }
             else if (name == u"pubDate")
             {
-                article[Article::KeyDate] = parseDate(xml.readElementText().trimmed());
+                article.date = parseDate(xml.readElementText().trimmed());
             }
             else if (name == u"author")
             {
-                article[Article::KeyAuthor] = xml.readElementText().trimmed();
+                article.author = xml.readElementText().trimmed();
             }
             else if (name == u"guid")
             {
-                article[Article::KeyId] = xml.readElementText().trimmed();
+                article.id = xml.readElementText().trimmed();
             }
             else
             {
-                article[name] = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+                setArticleField(article, name, xml.readElementText(QXmlStreamReader::IncludeChildElements));
             }
         }
     }
 
-    if (article[Article::KeyTorrentURL].toString().isEmpty())
-        article[Article::KeyTorrentURL] = altTorrentUrl;
+    if (article.torrentURL.isEmpty())
+        article.torrentURL = altTorrentUrl;
 
     addArticle(article);
 }
@@ -699,7 +708,7 @@ void RSS::Private::Parser::parseRSSChannel(QXmlStreamReader &xml)
 
 void RSS::Private::Parser::parseAtomArticle(QXmlStreamReader &xml)
 {
-    QVariantHash article;
+    ArticleData article;
     bool doubleContent = false;
 
     while (!xml.atEnd())
@@ -714,7 +723,7 @@ void RSS::Private::Parser::parseAtomArticle(QXmlStreamReader &xml)
         {
             if (name == u"title")
             {
-                article[Article::KeyTitle] = xml.readElementText().trimmed();
+                article.title = xml.readElementText().trimmed();
             }
             else if (name == u"link")
             {
@@ -724,14 +733,14 @@ void RSS::Private::Parser::parseAtomArticle(QXmlStreamReader &xml)
 
                 if (link.startsWith(u"magnet:", Qt::CaseInsensitive))
                 {
-                    article[Article::KeyTorrentURL] = link; // magnet link instead of a news URL
+                    article.torrentURL = link; // magnet link instead of a news URL
                 }
                 else
                 {
                     // Atom feeds can have relative links, work around this and
                     // take the stress of figuring article full URI from UI
                     // Assemble full URI
-                    article[Article::KeyLink] = (m_baseUrl.isEmpty() ? link : m_baseUrl + link);
+                    article.link = (m_baseUrl.isEmpty() ? link : m_baseUrl + link);
                 }
             }
             else if ((name == u"summary") || (name == u"content"))
@@ -747,7 +756,7 @@ void RSS::Private::Parser::parseAtomArticle(QXmlStreamReader &xml)
                 const QString feedText = xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
                 if (!feedText.isEmpty())
                 {
-                    article[Article::KeyDescription] = feedText;
+                    article.description = feedText;
                     doubleContent = true;
                 }
             }
@@ -755,25 +764,25 @@ void RSS::Private::Parser::parseAtomArticle(QXmlStreamReader &xml)
             {
                 // ATOM uses standard compliant date, don't do fancy stuff
                 const QDateTime articleDate = QDateTime::fromString(xml.readElementText().trimmed(), Qt::ISODate);
-                article[Article::KeyDate] = (articleDate.isValid() ? articleDate : QDateTime::currentDateTime());
+                article.date = (articleDate.isValid() ? articleDate : QDateTime::currentDateTime());
             }
             else if (name == u"author")
             {
                 while (xml.readNextStartElement())
                 {
                     if (xml.name() == u"name")
-                        article[Article::KeyAuthor] = xml.readElementText().trimmed();
+                        article.author = xml.readElementText().trimmed();
                     else
                         xml.skipCurrentElement();
                 }
             }
             else if (name == u"id")
             {
-                article[Article::KeyId] = xml.readElementText().trimmed();
+                article.id = xml.readElementText().trimmed();
             }
             else
             {
-                article[name] = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+                setArticleField(article, name, xml.readElementText(QXmlStreamReader::IncludeChildElements));
             }
         }
     }
@@ -816,21 +825,40 @@ void RSS::Private::Parser::parseAtomChannel(QXmlStreamReader &xml)
     }
 }
 
-void RSS::Private::Parser::addArticle(QVariantHash article)
+void RSS::Private::Parser::setArticleField(ArticleData &article, const QString &name, const QString &value)
+{
+    // Unknown elements that have the same names as the article fields override them
+    if (name == Article::KeyId)
+        article.id = value;
+    else if (name == Article::KeyDate)
+        article.date = QDateTime::fromString(value, Qt::ISODate);
+    else if (name == Article::KeyTitle)
+        article.title = value;
+    else if (name == Article::KeyAuthor)
+        article.author = value;
+    else if (name == Article::KeyDescription)
+        article.description = value;
+    else if (name == Article::KeyTorrentURL)
+        article.torrentURL = value;
+    else if (name == Article::KeyLink)
+        article.link = value;
+    else
+        article.extraFields[*m_fieldNames.insert(name)] = value;
+}
+
+void RSS::Private::Parser::addArticle(ArticleData article)
 {
-    QVariant &torrentURL = article[Article::KeyTorrentURL];
-    if (torrentURL.toString().isEmpty())
-        torrentURL = article.value(Article::KeyLink);
+    if (article.torrentURL.isEmpty())
+        article.torrentURL = article.link;
 
     // If item does not have an ID, fall back to some other identifier.
-    QVariant &localId = article[Article::KeyId];
-    if (localId.toString().isEmpty())
+    if (article.id.isEmpty())
     {
-        localId = article.value(Article::KeyTorrentURL);
-        if (localId.toString().isEmpty())
+        article.id = article.torrentURL;
+        if (article.id.isEmpty())
         {
-            localId = article.value(Article::KeyTitle);
-            if (localId.toString().isEmpty())
+            article.id = article.title;
+            if (article.id.isEmpty())
             {
                 // The article could not be uniquely identified
                 // since it has no appropriate data.
@@ -840,7 +868,7 @@ void RSS::Private::Parser::addArticle(QVariantHash article)
         }
     }
 
-    if (m_articleIDs.contains(localId.toString()))
+    if (m_articleIDs.contains(article.id))
     {
         // The article could not be uniquely identified
         // since the Feed has duplicate identifiers.
@@ -848,6 +876,61 @@ void RSS::Private::Parser::addArticle(QVariantHash article)
         return;
     }
 
-    m_articleIDs.insert(localId.toString());
+    m_articleIDs.insert(article.id);
     m_result.articles.prepend(article);
 }
+
+void RSS::Private::Parser::mergeArticles(const QHash<QString, QDateTime> &existingArticleDates, const int maxArticles)
+{
+    if (m_result.articles.isEmpty())
+        return;
+
+    QDateTime dummyPubDate {QDateTime::currentDateTime()};
+    QList<ArticleData> newArticles;
+    newArticles.reserve(m_result.articles.size());
+    for (ArticleData &article : m_result.articles)
+    {
+        // If article has no publication date we use feed update time as a fallback.
+        // To prevent processing of "out-of-limit" articles we must not assign dates
+        // that are earlier than the dates of existing articles.
+        if (const auto iter = existingArticleDates.constFind(article.id); iter != existingArticleDates.cend())
+        {
+            dummyPubDate = iter.value().addMSecs(-1);
+            continue;
+        }
+
+        if (!article.date.isValid())
+            article.date = dummyPubDate;
+
+        newArticles.append(std::move(article));
+    }
+
+    m_result.articles.clear();
+    if (newArticles.isEmpty())
+        return;
+
+    using ArticleSortAdaptor = std::pair<QDateTime, const ArticleData *>;
+    std::vector<ArticleSortAdaptor> sortData;
+    sortData.reserve(existingArticleDates.size() + newArticles.size());
+    for (const QDateTime &articleDate : existingArticleDates)
+        sortData.emplace_back(articleDate, nullptr);
+    for (const ArticleData &article : asConst(newArticles))
+        sortData.emplace_back(article.date, &article);
+
+    // Sort article list in reverse chronological order
+    std::sort(sortData.begin(), sortData.end()
+              , [](const ArticleSortAdaptor &a1, const ArticleSortAdaptor &a2)
+    {
+        return (a1.first > a2.first);
+    });
+
+    if (sortData.size() > static_cast<uint>(maxArticles))
+        sortData.resize(maxArticles);
+
+    m_result.articles.reserve(newArticles.size());
+    std::for_each(sortData.crbegin(), sortData.crend(), [this](const ArticleSortAdaptor &a)
+    {
+        if (a.second)
+            m_result.articles.append(*a.second);
+    });
+}
@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <QtContainerFwd>
+#include <QDateTime>
 #include <QList>
 #include <QObject>
 #include <QSet>
 #include <QString>
-#include <QVariantHash>
+
+#include "rss_article.h"
 
 class QXmlStreamReader;
 
@@ -44,7 +47,7 @@ namespace RSS::Private
         QString error;
         QString lastBuildDate;
         QString title;
-        QList<QVariantHash> articles;
+        QList<ArticleData> articles;  // only new articles, ordered from the oldest to the newest
     };
 
     class Parser final : public QObject
@@ -54,7 +57,9 @@ namespace RSS::Private
 
     public:
         explicit Parser(const QString &lastBuildDate);
-        void parse(const QByteArray &feedData);
+        // Articles are merged with the existing ones, so only the articles
+        // that should be added to the feed are reported
+        void parse(const QByteArray &feedData, const QHash<QString, QDateTime> &existingArticleDates, int maxArticles);
 
     signals:
         void finished(const RSS::Private::ParsingResult &result);
@@ -64,11 +69,14 @@ namespace RSS::Private
         void parseRSSChannel(QXmlStreamReader &xml);
         void parseAtomArticle(QXmlStreamReader &xml);
         void parseAtomChannel(QXmlStreamReader &xml);
-        void addArticle(QVariantHash article);
+        void setArticleField(ArticleData &article, const QString &name, const QString &value);
+        void addArticle(ArticleData article);
+        void mergeArticles(const QHash<QString, QDateTime> &existingArticleDates, int maxArticles);
 
         QString m_baseUrl;
         ParsingResult m_result;
         QSet<QString> m_articleIDs;
+        QSet<QString> m_fieldNames;  // to share the names of extra fields between the articles
     };
 }
 
@@ -30,6 +30,7 @@
 
 #include "rss_session.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QDebug>
@@ -38,6 +39,7 @@
 #include <QJsonValue>
 #include <QString>
 #include <QThread>
+#include <QUrl>
 
 #include "../asyncfilestorage.h"
 #include "../global.h"
@@ -46,6 +48,7 @@
 #include "../settingsstorage.h"
 #include "../utils/fs.h"
 #include "../utils/io.h"
+#include "../utils/random.h"
 #include "rss_article.h"
 #include "rss_feed.h"
 #include "rss_folder.h"
@@ -55,6 +58,14 @@ const QString CONF_FOLDER_NAME = u"rss"_s;
 const QString DATA_FOLDER_NAME = u"rss/articles"_s;
 const QString FEEDS_FILE_NAME = u"feeds.json"_s;
 
+const std::chrono::minutes REFRESH_CHECK_INTERVAL {1};
+const int MAX_CONCURRENT_REFRESHES = 10;
+// Download manager doesn't download from the feed hosts concurrently anyway
+const int MAX_CONCURRENT_REFRESHES_PER_HOST = 1;
+// Feed that doesn't get new articles is refreshed up to 4 times less often
+const int MAX_REFRESH_BACKOFF_EXPONENT = 2;
+const int REFRESH_JITTER_PERCENT = 10;
+
 using namespace RSS;
 
 QPointer<Session> Session::m_instance = nullptr;
@@ -91,10 +102,10 @@ Session::Session()
     m_workingThread->start();
     load();
 
-    connect(&m_refreshTimer, &QTimer::timeout, this, &Session::refresh);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &Session::refreshOutdatedFeeds);
     if (isProcessingEnabled())
     {
-        m_refreshTimer.start(std::chrono::minutes(refreshInterval()));
+        m_refreshTimer.start(REFRESH_CHECK_INTERVAL);
         refresh();
     }
 
@@ -441,6 +452,16 @@ void Session::addItem(Item *item, Folder *destFolder)
         connect(feed, &Feed::titleChanged, this, &Session::handleFeedTitleChanged);
         connect(feed, &Feed::iconLoaded, this, &Session::feedIconLoaded);
         connect(feed, &Feed::stateChanged, this, &Session::feedStateChanged);
+        connect(feed, &Feed::stateChanged, this, [this, feed]
+        {
+            // The feed may be waiting in the queue until its articles are loaded
+            if (feed->isInitialized() && m_refreshQueue.contains(feed))
+                processRefreshQueue();
+        });
+        connect(feed, &Feed::refreshFinished, this, [this, feed](const bool hasNewArticles)
+        {
+            handleFeedRefreshFinished(feed, hasNewArticles);
+        });
         connect(feed, &Feed::urlChanged, this, [this, feed](const QString &oldURL)
         {
             if (feed->name() == oldURL)
@@ -474,7 +495,7 @@ void Session::setProcessingEnabled(const bool enabled)
         m_storeProcessingEnabled = enabled;
         if (enabled)
         {
-            m_refreshTimer.start(std::chrono::minutes(refreshInterval()));
+            m_refreshTimer.start(REFRESH_CHECK_INTERVAL);
             refresh();
         }
         else
@@ -521,7 +542,8 @@ void Session::setRefreshInterval(const int refreshInterval)
     if (m_storeRefreshInterval != refreshInterval)
     {
         m_storeRefreshInterval = refreshInterval;
-        m_refreshTimer.start(std::chrono::minutes(m_storeRefreshInterval));
+        for (FeedRefreshState &refreshState : m_feedRefreshStates)
+            updateRefreshDeadline(refreshState);
     }
 }
 
@@ -538,6 +560,13 @@ void Session::handleItemAboutToBeDestroyed(Item *item)
     {
         m_feedsByUID.remove(feed->uid());
         m_feedsByURL.remove(feed->url());
+        m_feedRefreshStates.remove(feed);
+        m_refreshQueue.removeOne(feed);
+        if (const auto iter = m_refreshingFeeds.find(feed); iter != m_refreshingFeeds.end())
+        {
+            m_refreshingHosts.remove(iter.value());
+            m_refreshingFeeds.erase(iter);
+        }
     }
 }
 
@@ -577,5 +606,75 @@ void Session::setMaxArticlesPerFeed(const int n)
 void Session::refresh()
 {
     // NOTE: Should we allow manually refreshing for disabled session?
-    rootFolder()->refresh();
+    for (Feed *feed : asConst(m_feedsByURL))
+        enqueueRefresh(feed);
+    processRefreshQueue();
+}
+
+void Session::refreshOutdatedFeeds()
+{
+    for (Feed *feed : asConst(m_feedsByURL))
+    {
+        // Feed that has never been refreshed is outdated as well
+        const auto iter = m_feedRefreshStates.constFind(feed);
+        if ((iter == m_feedRefreshStates.cend()) || iter->deadline.hasExpired())
+            enqueueRefresh(feed);
+    }
+
+    processRefreshQueue();
+}
+
+void Session::enqueueRefresh(Feed *feed)
+{
+    if (!m_refreshingFeeds.contains(feed) && !m_refreshQueue.contains(feed))
+        m_refreshQueue.append(feed);
+}
+
+void Session::processRefreshQueue()
+{
+    static_assert(MAX_CONCURRENT_REFRESHES_PER_HOST == 1, "Refreshing hosts are tracked by QSet");
+
+    // Feeds of busy hosts keep their places in the queue, as well as the feeds which
+    // articles aren't loaded yet, since they would defer refreshing while taking the slot
+    for (auto iter = m_refreshQueue.begin(); (iter != m_refreshQueue.end())
+            && (m_refreshingFeeds.size() < MAX_CONCURRENT_REFRESHES);)
+    {
+        Feed *feed = *iter;
+        const QString host = QUrl(feed->url()).host();
+        if (!feed->isInitialized() || m_refreshingHosts.contains(host))
+        {
+            ++iter;
+            continue;
+        }
+
+        iter = m_refreshQueue.erase(iter);
+        m_refreshingFeeds.insert(feed, host);
+        m_refreshingHosts.insert(host);
+        feed->refresh();
+    }
+}
+
+void Session::handleFeedRefreshFinished(Feed *feed, const bool hasNewArticles)
+{
+    FeedRefreshState &refreshState = m_feedRefreshStates[feed];
+    refreshState.unchangedCount = (hasNewArticles ? 0 : (refreshState.unchangedCount + 1));
+    updateRefreshDeadline(refreshState);
+
+    // Feed can also be refreshed out of the queue
+    if (const auto iter = m_refreshingFeeds.find(feed); iter != m_refreshingFeeds.end())
+    {
+        m_refreshingHosts.remove(iter.value());
+        m_refreshingFeeds.erase(iter);
+        processRefreshQueue();
+    }
+}
+
+void Session::updateRefreshDeadline(FeedRefreshState &refreshState) const
+{
+    const int backoffExponent = std::min(refreshState.unchangedCount, MAX_REFRESH_BACKOFF_EXPONENT);
+    const qint64 interval = std::chrono::milliseconds(std::chrono::minutes(refreshInterval())).count() << backoffExponent;
+    // Spread the refreshes of the feeds so they don't fire together
+    const qint64 maxJitter = interval * REFRESH_JITTER_PERCENT / 100;
+    const qint64 jitter = static_cast<qint64>(Utils::Random::rand(0, (2 * maxJitter))) - maxJitter;
+    refreshState.deadline.setRemainingTime(interval + jitter);
 }
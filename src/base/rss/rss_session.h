@@ -68,9 +68,12 @@
  * 3.   Feed is JSON object (keys are property names, values are property values; 'uid' and 'url' are required)
  */
 
+#include <QDeadlineTimer>
 #include <QHash>
+#include <QList>
 #include <QObject>
 #include <QPointer>
+#include <QSet>
 #include <QTimer>
 
 #include "base/3rdparty/expected.hpp"
@@ -145,8 +148,15 @@ namespace RSS
     private slots:
         void handleItemAboutToBeDestroyed(Item *item);
         void handleFeedTitleChanged(Feed *feed);
+        void refreshOutdatedFeeds();
 
     private:
+        struct FeedRefreshState
+        {
+            QDeadlineTimer deadline;
+            int unchangedCount = 0;  // the number of last refreshes that didn't bring new articles
+        };
+
         QUuid generateUID() const;
         void load();
         bool loadFolder(const QJsonObject &jsonObj, Folder *folder);
@@ -156,6 +166,10 @@ namespace RSS
         Folder *addSubfolder(const QString &name, Folder *parentFolder);
         Feed *addFeedToFolder(const QUuid &uid, const QString &url, const QString &name, Folder *parentFolder);
         void addItem(Item *item, Folder *destFolder);
+        void enqueueRefresh(Feed *feed);
+        void processRefreshQueue();
+        void handleFeedRefreshFinished(Feed *feed, bool hasNewArticles);
+        void updateRefreshDeadline(FeedRefreshState &refreshState) const;
 
         static QPointer<Session> m_instance;
 
@@ -169,5 +183,9 @@ namespace RSS
         QHash<QString, Item *> m_itemsByPath;
         QHash<QUuid, Feed *> m_feedsByUID;
         QHash<QString, Feed *> m_feedsByURL;
+        QHash<Feed *, FeedRefreshState> m_feedRefreshStates;
+        QList<Feed *> m_refreshQueue;
+        QHash<Feed *, QString> m_refreshingFeeds;  // maps feed to its host
+        QSet<QString> m_refreshingHosts;
     };
 }
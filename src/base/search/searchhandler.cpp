@@ -29,8 +29,14 @@
 
 #include "searchhandler.h"
 
+#include <algorithm>
 #include <chrono>
 
+#include <QByteArrayView>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
 #include <QMetaObject>
 #include <QProcess>
 #include <QTimer>
@@ -46,6 +52,8 @@ using namespace std::chrono_literals;
 
 namespace
 {
+    const std::chrono::milliseconds PLUGIN_TIMEOUT = 3min;
+
     enum SearchResultColumn
     {
         PL_DL_LINK,
@@ -57,6 +65,25 @@ namespace
         PL_DESC_LINK,
         NB_PLUGIN_COLUMNS
     };
+
+    const QString KEY_LINK = u"link"_s;
+    const QString KEY_NAME = u"name"_s;
+    const QString KEY_SIZE = u"size"_s;
+    const QString KEY_SEEDS = u"seeds"_s;
+    const QString KEY_LEECH = u"leech"_s;
+    const QString KEY_ENGINE_URL = u"engine_url"_s;
+    const QString KEY_DESC_LINK = u"desc_link"_s;
+
+    // Plugins may provide numbers as strings
+    qlonglong toInteger(const QJsonValue &value)
+    {
+        if (!value.isString())
+            return value.toInteger(-1);
+
+        bool ok = false;
+        const qlonglong result = value.toString().trimmed().toLongLong(&ok);
+        return ok ? result : -1;
+    }
 }
 
 SearchHandler::SearchHandler(const QString &pattern, const QString &category, const QStringList &usedPlugins, SearchPluginManager *manager)
@@ -65,68 +92,140 @@ SearchHandler::SearchHandler(const QString &pattern, const QString &category, co
     , m_category {category}
     , m_usedPlugins {usedPlugins}
     , m_manager {manager}
-    , m_searchProcess {new QProcess {this}}
-    , m_searchTimeout {new QTimer {this}}
 {
     // Load environment variables (proxy)
-    m_searchProcess->setEnvironment(QProcess::systemEnvironment());
+    const QStringList environment = QProcess::systemEnvironment();
+    const QString program = Utils::ForeignApps::pythonInfo().executableName;
+    const QString enginePath = (SearchPluginManager::engineLocation() / Path(u"nova2.py"_s)).toString();
+    const QStringList keywords = m_pattern.split(u' ');
 
-    const QStringList params
-    {
-        Utils::ForeignApps::PYTHON_ISOLATE_MODE_FLAG,
-        (SearchPluginManager::engineLocation() / Path(u"nova2.py"_s)).toString(),
-        m_usedPlugins.join(u','),
-        m_category
-    };
-
-    // Launch search
-    m_searchProcess->setProgram(Utils::ForeignApps::pythonInfo().executableName);
-    m_searchProcess->setArguments(params + m_pattern.split(u' '));
+    QStringList plugins = m_usedPlugins;
+    plugins.removeDuplicates();
 
-    connect(m_searchProcess, &QProcess::errorOccurred, this, &SearchHandler::processFailed);
-    connect(m_searchProcess, &QProcess::readyReadStandardOutput, this, &SearchHandler::readSearchOutput);
-    connect(m_searchProcess, qOverload<int, QProcess::ExitStatus>(&QProcess::finished)
-            , this, &SearchHandler::processFinished);
+    // Each plugin is run in its own process, so slow plugin doesn't hold up the results of others
+    for (const QString &plugin : asConst(plugins))
+    {
+        auto *process = new QProcess(this);
+        process->setEnvironment(environment);
+        process->setProgram(program);
+        process->setArguments(QStringList {Utils::ForeignApps::PYTHON_ISOLATE_MODE_FLAG, enginePath, plugin, m_category} + keywords);
+
+        connect(process, &QProcess::errorOccurred, this, [this, process](const QProcess::ProcessError error)
+        {
+            // "finished" signal isn't emitted in this case
+            if (error == QProcess::FailedToStart)
+                handleProcessFinished(process, false);
+        });
+        connect(process, &QProcess::readyReadStandardOutput, this, [this, process]
+        {
+            readSearchOutput(process);
+        });
+        connect(process, &QProcess::finished, this, [this, process](const int exitCode, const QProcess::ExitStatus exitStatus)
+        {
+            handleProcessFinished(process, ((exitStatus == QProcess::NormalExit) && (exitCode == 0)));
+        });
+        // the process can wait in queue for a while, so timeout is counted since it is started
+        connect(process, &QProcess::started, process, [this, process]
+        {
+            QTimer::singleShot(PLUGIN_TIMEOUT, process, [this, process]
+            {
+                m_hasTimedOutProcess = true;
+#ifdef Q_OS_WIN
+                process->kill();
+#else
+                process->terminate();
+#endif
+            });
+        });
 
-    m_searchTimeout->setSingleShot(true);
-    connect(m_searchTimeout, &QTimer::timeout, this, &SearchHandler::cancelSearch);
-    m_searchTimeout->start(3min);
+        m_searchProcesses.append(process);
+    }
 
     // deferred start allows clients to handle starting-related signals
-    QMetaObject::invokeMethod(this, [this]() { m_searchProcess->start(QIODevice::ReadOnly); }
-        , Qt::QueuedConnection);
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        if (m_searchProcesses.isEmpty())
+        {
+            emit searchFinished(false);
+            return;
+        }
+
+        for (QProcess *process : asConst(m_searchProcesses))
+            m_manager->startSearchProcess(process);
+    }, Qt::QueuedConnection);
+}
+
+SearchHandler::~SearchHandler()
+{
+    // Running processes are released by the manager when they are destroyed, so it starts
+    // the queued ones. The queued processes of this search must not be started at that time.
+    removeQueuedProcesses();
 }
 
 bool SearchHandler::isActive() const
 {
-    return (m_searchProcess->state() != QProcess::NotRunning);
+    return !m_searchProcesses.isEmpty();
 }
 
 void SearchHandler::cancelSearch()
 {
-    if ((m_searchProcess->state() == QProcess::NotRunning) || m_searchCancelled)
+    if (m_searchProcesses.isEmpty() || m_searchCancelled)
         return;
 
+    m_searchCancelled = true;
+
+    // the queued processes are removed first, so they can't be started when running ones are finished
+    removeQueuedProcesses();
+    for (QProcess *process : asConst(m_searchProcesses))
+    {
 #ifdef Q_OS_WIN
-    m_searchProcess->kill();
+        process->kill();
 #else
-    m_searchProcess->terminate();
+        process->terminate();
 #endif
-    m_searchCancelled = true;
-    m_searchTimeout->stop();
+    }
+
+    if (m_searchProcesses.isEmpty())
+        emit searchFinished(true);
+}
+
+void SearchHandler::removeQueuedProcesses()
+{
+    // the processes that are still waiting in queue won't be started anymore
+    // (the queue keeps guarded pointers so deleted processes are skipped)
+    m_searchProcesses.removeIf([this](QProcess *process)
+    {
+        if (process->state() != QProcess::NotRunning)
+            return false;
+
+        m_searchOutputs.remove(process);
+        delete process;
+        return true;
+    });
 }
 
-// Slot called when QProcess is Finished
-// QProcess can be finished for 3 reasons:
-// Error | Stopped by user | Finished normally
-void SearchHandler::processFinished(const int exitcode)
+void SearchHandler::handleProcessFinished(QProcess *process, const bool succeeded)
 {
-    m_searchTimeout->stop();
+    if (!m_searchProcesses.removeOne(process))
+        return;
+
+    m_searchOutputs.remove(process);
+    process->deleteLater();
+
+    if (succeeded)
+        m_hasSucceededProcess = true;
 
+    if (!m_searchProcesses.isEmpty())
+        return;
+
+    // the search that has timed out is reported as cancelled, as it used to be
+    // when the whole search had common timeout
     if (m_searchCancelled)
         emit searchFinished(true);
-    else if ((m_searchProcess->exitStatus() == QProcess::NormalExit) && (exitcode == 0))
+    else if (m_hasSucceededProcess)
         emit searchFinished(false);
+    else if (m_hasTimedOutProcess)
+        emit searchFinished(true);
     else
         emit searchFailed();
 }
@@ -134,44 +233,70 @@ void SearchHandler::processFinished(const int exitcode)
 // search QProcess return output as soon as it gets new
 // stuff to read. We split it into lines and parse each
 // line to SearchResult calling parseSearchResult().
-void SearchHandler::readSearchOutput()
+void SearchHandler::readSearchOutput(QProcess *process)
 {
-    QByteArray output = m_searchProcess->readAllStandardOutput();
-    output.replace('\r', "");
-
-    QList<QByteArray> lines = output.split('\n');
-    if (!m_searchResultLineTruncated.isEmpty())
-        lines.prepend(m_searchResultLineTruncated + lines.takeFirst());
-    m_searchResultLineTruncated = lines.takeLast().trimmed();
+    QByteArray &searchOutput = m_searchOutputs[process];
+    searchOutput.append(process->readAllStandardOutput());
 
     QVector<SearchResult> searchResultList;
-    searchResultList.reserve(lines.size());
 
-    for (const QByteArray &line : asConst(lines))
+    // lines are parsed in place, without copying them out of the buffer
+    qsizetype lineStart = 0;
+    qsizetype lineEnd = 0;
+    while ((lineEnd = searchOutput.indexOf('\n', lineStart)) >= 0)
     {
+        const QByteArrayView line = QByteArrayView(searchOutput).sliced(lineStart, (lineEnd - lineStart)).trimmed();
         SearchResult searchResult;
-        if (parseSearchResult(QString::fromUtf8(line), searchResult))
-            searchResultList << searchResult;
-    }
+        if (parseSearchResult(line, searchResult))
+            searchResultList.append(std::move(searchResult));
 
-    if (!searchResultList.isEmpty())
-    {
-        for (const SearchResult &result : searchResultList)
-            m_results.append(result);
-        emit newSearchResults(searchResultList);
+        lineStart = lineEnd + 1;
     }
+    searchOutput.remove(0, lineStart);
+
+    if (searchResultList.isEmpty())
+        return;
+
+    // duplicates of already received results are dropped
+    const QVector<SearchResult> addedResults = m_results.append(searchResultList);
+    if (!addedResults.isEmpty())
+        emit newSearchResults(addedResults);
 }
 
-void SearchHandler::processFailed()
+// Parse one line of search results list
+// Line contains JSON object with the following fields:
+// link, name, size, seeds, leech, engine_url, desc_link (optional)
+bool SearchHandler::parseSearchResult(const QByteArrayView line, SearchResult &searchResult)
 {
-    if (!m_searchCancelled)
-        emit searchFailed();
+    if (line.isEmpty())
+        return false;
+
+    // Plugins can still use outdated "novaprinter" that produces the results in legacy format
+    if (!line.startsWith('{'))
+        return parseLegacySearchResult(QString::fromUtf8(line), searchResult);
+
+    QJsonParseError jsonError;
+    const QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray::fromRawData(line.data(), line.size()), &jsonError);
+    if ((jsonError.error != QJsonParseError::NoError) || !jsonDoc.isObject())
+        return false;
+
+    const QJsonObject jsonObj = jsonDoc.object();
+
+    searchResult = SearchResult();
+    searchResult.fileUrl = jsonObj.value(KEY_LINK).toString().trimmed();
+    searchResult.fileName = jsonObj.value(KEY_NAME).toString().trimmed();
+    searchResult.fileSize = toInteger(jsonObj.value(KEY_SIZE));
+    searchResult.nbSeeders = std::max<qlonglong>(-1, toInteger(jsonObj.value(KEY_SEEDS)));
+    searchResult.nbLeechers = std::max<qlonglong>(-1, toInteger(jsonObj.value(KEY_LEECH)));
+    searchResult.siteUrl = jsonObj.value(KEY_ENGINE_URL).toString().trimmed();
+    searchResult.descrLink = jsonObj.value(KEY_DESC_LINK).toString().trimmed();
+
+    return true;
 }
 
-// Parse one line of search results list
 // Line is in the following form:
 // file url | file name | file size | nb seeds | nb leechers | Search engine url
-bool SearchHandler::parseSearchResult(const QStringView line, SearchResult &searchResult)
+bool SearchHandler::parseLegacySearchResult(const QStringView line, SearchResult &searchResult)
 {
     const QList<QStringView> parts = line.split(u'|');
     const int nbFields = parts.size();
@@ -205,7 +330,7 @@ SearchPluginManager *SearchHandler::manager() const
     return m_manager;
 }
 
-QList<SearchResult> SearchHandler::results() const
+const SearchResultStore &SearchHandler::results() const
 {
     return m_results;
 }
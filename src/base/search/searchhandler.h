@@ -30,24 +30,16 @@
 #pragma once
 
 #include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QString>
 #include <QtContainerFwd>
 
-class QProcess;
-class QTimer;
+#include "searchresultstore.h"
 
-struct SearchResult
-{
-    QString fileName;
-    QString fileUrl;
-    qlonglong fileSize = 0;
-    qlonglong nbSeeders = 0;
-    qlonglong nbLeechers = 0;
-    QString siteUrl;
-    QString descrLink;
-};
+class QByteArrayView;
+class QProcess;
 
 class SearchPluginManager;
 
@@ -62,10 +54,12 @@ class SearchHandler : public QObject
                   , const QStringList &usedPlugins, SearchPluginManager *manager);
 
 public:
+    ~SearchHandler() override;
+
     bool isActive() const;
     QString pattern() const;
     SearchPluginManager *manager() const;
-    QList<SearchResult> results() const;
+    const SearchResultStore &results() const;
 
     void cancelSearch();
 
@@ -75,18 +69,20 @@ signals:
     void newSearchResults(const QVector<SearchResult> &results);
 
 private:
-    void readSearchOutput();
-    void processFailed();
-    void processFinished(int exitcode);
-    bool parseSearchResult(QStringView line, SearchResult &searchResult);
+    void removeQueuedProcesses();
+    void readSearchOutput(QProcess *process);
+    void handleProcessFinished(QProcess *process, bool succeeded);
+    bool parseSearchResult(QByteArrayView line, SearchResult &searchResult);
+    bool parseLegacySearchResult(QStringView line, SearchResult &searchResult);
 
     const QString m_pattern;
     const QString m_category;
     const QStringList m_usedPlugins;
     SearchPluginManager *m_manager = nullptr;
-    QProcess *m_searchProcess = nullptr;
-    QTimer *m_searchTimeout = nullptr;
-    QByteArray m_searchResultLineTruncated;
+    QList<QProcess *> m_searchProcesses;  // processes that aren't finished yet
+    QHash<QProcess *, QByteArray> m_searchOutputs;  // output that isn't parsed yet, i.e. incomplete line
     bool m_searchCancelled = false;
-    QList<SearchResult> m_results;
+    bool m_hasSucceededProcess = false;
+    bool m_hasTimedOutProcess = false;
+    SearchResultStore m_results;
 };
@@ -29,6 +29,7 @@
 
 #include "searchpluginmanager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <QDir>
@@ -39,6 +40,7 @@
 #include <QFile>
 #include <QPointer>
 #include <QProcess>
+#include <QThread>
 #include <QUrl>
 
 #include "base/global.h"
@@ -347,7 +349,57 @@ SearchHandler *SearchPluginManager::startSearch(const QString &pattern, const QS
     // No search pattern entered
     Q_ASSERT(!pattern.isEmpty());
 
-    return new SearchHandler {pattern, category, usedPlugins, this};
+    auto *searchHandler = new SearchHandler {pattern, category, usedPlugins, this};
+
+    m_activeSearches.insert(searchHandler);
+    const auto removeActiveSearch = [this, searchHandler] { m_activeSearches.remove(searchHandler); };
+    connect(searchHandler, &SearchHandler::searchFinished, this, removeActiveSearch);
+    connect(searchHandler, &SearchHandler::searchFailed, this, removeActiveSearch);
+    connect(searchHandler, &QObject::destroyed, this, removeActiveSearch);
+
+    return searchHandler;
+}
+
+int SearchPluginManager::activeSearchCount() const
+{
+    return m_activeSearches.size();
+}
+
+void SearchPluginManager::startSearchProcess(QProcess *process)
+{
+    m_searchProcessQueue.enqueue(process);
+    startQueuedSearchProcesses();
+}
+
+void SearchPluginManager::startQueuedSearchProcesses()
+{
+    // plugins spend most of time waiting for network, but each of them is
+    // a separate Python interpreter so their number is limited anyway
+    const int maxRunningSearchProcesses = std::max(QThread::idealThreadCount(), 2);
+
+    while ((m_runningSearchProcesses.size() < maxRunningSearchProcesses) && !m_searchProcessQueue.isEmpty())
+    {
+        QProcess *process = m_searchProcessQueue.dequeue();
+        if (!process)  // search was cancelled or deleted
+            continue;
+
+        m_runningSearchProcesses.insert(process);
+
+        const auto releaseProcess = [this, process]
+        {
+            if (m_runningSearchProcesses.remove(process))
+                startQueuedSearchProcesses();
+        };
+        connect(process, &QProcess::finished, this, releaseProcess);
+        connect(process, &QProcess::errorOccurred, this, [releaseProcess](const QProcess::ProcessError error)
+        {
+            if (error == QProcess::FailedToStart)
+                releaseProcess();
+        });
+        connect(process, &QObject::destroyed, this, releaseProcess);
+
+        process->start(QIODevice::ReadOnly);
+    }
 }
 
 QString SearchPluginManager::categoryFullName(const QString &categoryName)
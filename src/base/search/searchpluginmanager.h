@@ -32,6 +32,9 @@
 #include <QHash>
 #include <QMetaType>
 #include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QSet>
 
 #include "base/path.h"
 #include "base/utils/version.h"
@@ -55,6 +58,8 @@ struct PluginInfo
     bool enabled = false;
 };
 
+class QProcess;
+
 class SearchDownloadHandler;
 class SearchHandler;
 
@@ -63,6 +68,8 @@ class SearchPluginManager final : public QObject
     Q_OBJECT
     Q_DISABLE_COPY_MOVE(SearchPluginManager)
 
+    friend class SearchHandler;
+
 public:
     SearchPluginManager();
     ~SearchPluginManager() override;
@@ -84,6 +91,7 @@ public:
     void checkForUpdates();
 
     SearchHandler *startSearch(const QString &pattern, const QString &category, const QStringList &usedPlugins);
+    int activeSearchCount() const;
     SearchDownloadHandler *downloadTorrent(const QString &siteUrl, const QString &url);
 
     static PluginVersion getPluginVersion(const Path &filePath);
@@ -114,6 +122,11 @@ private:
     void versionInfoDownloadFinished(const Net::DownloadResult &result);
     void pluginDownloadFinished(const Net::DownloadResult &result);
 
+    // Search processes of all the searches are run via common queue
+    // so only limited number of them can be running at the same time
+    void startSearchProcess(QProcess *process);
+    void startQueuedSearchProcesses();
+
     static Path pluginPath(const QString &name);
 
     static QPointer<SearchPluginManager> m_instance;
@@ -121,4 +134,8 @@ private:
     const QString m_updateUrl;
 
     QHash<QString, PluginInfo*> m_plugins;
+
+    QSet<SearchHandler *> m_activeSearches;
+    QQueue<QPointer<QProcess>> m_searchProcessQueue;
+    QSet<QProcess *> m_runningSearchProcesses;
 };
@@ -0,0 +1,221 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#include "searchresultstore.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QRegularExpression>
+
+#include "base/global.h"
+
+namespace
+{
+    // Results of different plugins (or even of the same one) can point to the same torrent.
+    // Magnet links are identified by the info hash since they can differ in other parameters.
+    QString resultKey(const QString &fileUrl)
+    {
+        if (fileUrl.startsWith(u"magnet:", Qt::CaseInsensitive))
+        {
+            static const QRegularExpression hashRegex {u"[?&]xt=urn:bt(?:ih|mh):([^&]+)"_s, QRegularExpression::CaseInsensitiveOption};
+            const QRegularExpressionMatch match = hashRegex.match(fileUrl);
+            if (match.hasMatch())
+                return u"urn:"_s + match.capturedView(1).toString().toLower();
+        }
+
+        return fileUrl;
+    }
+
+    template <typename T>
+    int compareNumbers(const T left, const T right)
+    {
+        return (left < right) ? -1 : ((left > right) ? 1 : 0);
+    }
+}
+
+bool SearchResultFilter::isEmpty() const
+{
+    return nameWords.isEmpty() && (minSize <= 0) && (maxSize < 0)
+            && (minSeeds <= 0) && (maxSeeds < 0);
+}
+
+int SearchResultStore::size() const
+{
+    return m_fileUrls.size();
+}
+
+bool SearchResultStore::isEmpty() const
+{
+    return m_fileUrls.isEmpty();
+}
+
+SearchResult SearchResultStore::at(const int index) const
+{
+    return {m_fileNames[index], m_fileUrls[index], m_fileSizes[index], m_nbSeeders[index]
+            , m_nbLeechers[index], m_siteUrls[index], m_descrLinks[index]};
+}
+
+QVector<SearchResult> SearchResultStore::append(const QVector<SearchResult> &results)
+{
+    QVector<SearchResult> addedResults;
+    addedResults.reserve(results.size());
+
+    for (const SearchResult &result : results)
+    {
+        // Results without URL are useless but they cannot be identified so they are kept as is
+        if (!result.fileUrl.isEmpty())
+        {
+            const qsizetype keyCount = m_resultKeys.size();
+            m_resultKeys.insert(resultKey(result.fileUrl));
+            if (m_resultKeys.size() == keyCount)
+                continue;
+        }
+
+        m_fileNames.append(result.fileName);
+        m_fileUrls.append(result.fileUrl);
+        m_fileSizes.append(result.fileSize);
+        m_nbSeeders.append(result.nbSeeders);
+        m_nbLeechers.append(result.nbLeechers);
+        m_siteUrls.append(result.siteUrl);
+        m_descrLinks.append(result.descrLink);
+
+        addedResults.append(result);
+    }
+
+    return addedResults;
+}
+
+QVector<int> SearchResultStore::select(const SearchResultFilter &filter, const SortColumn sortColumn, const Qt::SortOrder sortOrder) const
+{
+    QVector<int> indexes;
+
+    if (sortColumn == SortColumn::None)
+    {
+        for (int i = 0; i < size(); ++i)
+        {
+            if (accepts(filter, i))
+                indexes.append(i);
+        }
+    }
+    else if (filter.isEmpty())
+    {
+        indexes = sortedIndexes(sortColumn);
+    }
+    else
+    {
+        for (const int i : sortedIndexes(sortColumn))
+        {
+            if (accepts(filter, i))
+                indexes.append(i);
+        }
+    }
+
+    if (sortOrder == Qt::DescendingOrder)
+        std::reverse(indexes.begin(), indexes.end());
+
+    return indexes;
+}
+
+const QVector<int> &SearchResultStore::sortedIndexes(const SortColumn sortColumn) const
+{
+    SortedIndexes &sorted = m_sortedIndexes[sortColumn];
+    if (sorted.resultCount == size())
+        return sorted.indexes;
+
+    // Only the results added since the last call are sorted, then they are merged
+    // into already sorted ones, so it is cheap to keep the order while search is running
+    const auto isLess = [this, sortColumn](const int left, const int right)
+    {
+        return lessThan(sortColumn, left, right);
+    };
+
+    QVector<int> &indexes = sorted.indexes;
+    indexes.resize(size());
+    const auto newIndexesBegin = indexes.begin() + sorted.resultCount;
+    std::iota(newIndexesBegin, indexes.end(), sorted.resultCount);
+    std::sort(newIndexesBegin, indexes.end(), isLess);
+    std::inplace_merge(indexes.begin(), newIndexesBegin, indexes.end(), isLess);
+    sorted.resultCount = size();
+
+    return indexes;
+}
+
+bool SearchResultStore::lessThan(const SortColumn sortColumn, const int left, const int right) const
+{
+    int result = 0;
+    switch (sortColumn)
+    {
+    case SortColumn::FileName:
+        result = m_naturalCompare(m_fileNames[left], m_fileNames[right]);
+        break;
+    case SortColumn::FileSize:
+        result = compareNumbers(m_fileSizes[left], m_fileSizes[right]);
+        break;
+    case SortColumn::NbSeeders:
+        result = compareNumbers(m_nbSeeders[left], m_nbSeeders[right]);
+        break;
+    case SortColumn::NbLeechers:
+        result = compareNumbers(m_nbLeechers[left], m_nbLeechers[right]);
+        break;
+    case SortColumn::SiteUrl:
+        result = m_naturalCompare(m_siteUrls[left], m_siteUrls[right]);
+        break;
+    case SortColumn::None:
+        break;
+    }
+
+    // keep the order of addition for equal values so the order is stable between calls
+    return (result != 0) ? (result < 0) : (left < right);
+}
+
+bool SearchResultStore::accepts(const SearchResultFilter &filter, const int index) const
+{
+    for (const QString &word : asConst(filter.nameWords))
+    {
+        if (!m_fileNames[index].contains(word, Qt::CaseInsensitive))
+            return false;
+    }
+
+    const qlonglong fileSize = m_fileSizes[index];
+    if (((filter.minSize > 0) && (fileSize < filter.minSize))
+        || ((filter.maxSize >= 0) && (fileSize > filter.maxSize)))
+    {
+        return false;
+    }
+
+    const qlonglong nbSeeders = m_nbSeeders[index];
+    if (((filter.minSeeds > 0) && (nbSeeders < filter.minSeeds))
+        || ((filter.maxSeeds >= 0) && (nbSeeders > filter.maxSeeds)))
+    {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,111 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#pragma once
+
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "base/utils/compare.h"
+
+struct SearchResult
+{
+    QString fileName;
+    QString fileUrl;
+    qlonglong fileSize = 0;
+    qlonglong nbSeeders = 0;
+    qlonglong nbLeechers = 0;
+    QString siteUrl;
+    QString descrLink;
+};
+
+struct SearchResultFilter
+{
+    QStringList nameWords;  // all of them must be contained in result name
+    qint64 minSize = 0;
+    qint64 maxSize = -1;  // negative value to disable filtering
+    qlonglong minSeeds = 0;
+    qlonglong maxSeeds = -1;  // negative value to disable filtering
+
+    bool isEmpty() const;
+};
+
+// Keeps search results column-wise, so filtering and sorting by some field
+// touches only the data of that field. Results are kept in the order they were added.
+class SearchResultStore
+{
+public:
+    enum class SortColumn
+    {
+        None,
+        FileName,
+        FileSize,
+        NbSeeders,
+        NbLeechers,
+        SiteUrl
+    };
+
+    int size() const;
+    bool isEmpty() const;
+    SearchResult at(int index) const;
+
+    // Duplicates (i.e. results pointing to the same torrent) are dropped,
+    // the results that were actually added are returned
+    QVector<SearchResult> append(const QVector<SearchResult> &results);
+
+    // Returns the indexes of the results that satisfy the filter, in the requested order
+    QVector<int> select(const SearchResultFilter &filter, SortColumn sortColumn, Qt::SortOrder sortOrder = Qt::AscendingOrder) const;
+
+private:
+    struct SortedIndexes
+    {
+        QVector<int> indexes;
+        int resultCount = 0;  // number of the results that are already sorted
+    };
+
+    const QVector<int> &sortedIndexes(SortColumn sortColumn) const;
+    bool lessThan(SortColumn sortColumn, int left, int right) const;
+    bool accepts(const SearchResultFilter &filter, int index) const;
+
+    QVector<QString> m_fileNames;
+    QVector<QString> m_fileUrls;
+    QVector<qlonglong> m_fileSizes;
+    QVector<qlonglong> m_nbSeeders;
+    QVector<qlonglong> m_nbLeechers;
+    QVector<QString> m_siteUrls;
+    QVector<QString> m_descrLinks;
+
+    QSet<QString> m_resultKeys;
+    Utils::Compare::NaturalCompare<Qt::CaseInsensitive> m_naturalCompare;
+    // Sort orders are built on demand and then updated with the results added later
+    mutable QMap<SortColumn, SortedIndexes> m_sortedIndexes;
+};
@@ -31,9 +31,14 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include <QFile>
 #include <QHash>
+#include <QMetaObject>
+#include <QMutex>
+#include <QThread>
 
 #include "global.h"
 #include "logger.h"
@@ -43,21 +48,52 @@
 
 using namespace std::chrono_literals;
 
+class SettingsStorage::Worker final : public QObject
+{
+    Q_DISABLE_COPY_MOVE(Worker)
+
+public:
+    Worker(SettingsStorage *storage, const QString &nativeSettingsName);
+
+    // Data that isn't written yet is replaced with the newer one, so the settings are
+    // written only once no matter how many times they were saved in the meantime
+    void schedule(const QVariantHash &data);
+    void writePending();
+
+private:
+    bool writeNativeSettings(const QVariantHash &data) const;
+
+    SettingsStorage *const m_storage;
+    const QString m_nativeSettingsName;
+    QMutex m_mutex;
+    std::optional<QVariantHash> m_pendingData;
+};
+
 SettingsStorage *SettingsStorage::m_instance = nullptr;
 
 SettingsStorage::SettingsStorage()
     : m_nativeSettingsName {u"qBittorrent"_s}
+    , m_data {std::make_shared<const QVariantHash>()}
+    , m_ioThread {new QThread}
+    , m_asyncWorker {std::make_unique<Worker>(this, m_nativeSettingsName)}
 {
     readNativeSettings();
 
     m_timer.setSingleShot(true);
     m_timer.setInterval(5s);
     connect(&m_timer, &QTimer::timeout, this, &SettingsStorage::save);
+
+    m_asyncWorker->moveToThread(m_ioThread.get());
+    m_ioThread->start();
 }
 
 SettingsStorage::~SettingsStorage()
 {
     save();
+
+    // The thread is stopped first, so the data that isn't written yet can be written from here
+    m_ioThread.reset();
+    m_asyncWorker->writePending();
 }
 
 void SettingsStorage::initInstance()
@@ -79,37 +115,69 @@ SettingsStorage *SettingsStorage::instance()
 
 bool SettingsStorage::save()
 {
-    // return `true` only when settings is different AND is saved successfully
-
-    const QWriteLocker locker(&m_lock);  // guard for `m_dirty` too
+    const QMutexLocker locker {&m_lock};  // guard for `m_dirty` too
     if (!m_dirty) return false;
 
-    if (!writeNativeSettings())
-    {
-        m_timer.start();
-        return false;
-    }
-
+    // the snapshot is implicitly shared, so it isn't copied
+    m_asyncWorker->schedule(*snapshot());
     m_dirty = false;
+    m_timer.stop();
     return true;
 }
 
+void SettingsStorage::handleWriteFailed()
+{
+    const QMutexLocker locker {&m_lock};
+    m_dirty = true;
+    m_timer.start();
+}
+
 QVariant SettingsStorage::loadValueImpl(const QString &key, const QVariant &defaultValue) const
 {
-    const QReadLocker locker(&m_lock);
-    return m_data.value(key, defaultValue);
+    return snapshot()->value(key, defaultValue);
 }
 
 void SettingsStorage::storeValueImpl(const QString &key, const QVariant &value)
 {
-    const QWriteLocker locker(&m_lock);
-    QVariant &currentValue = m_data[key];
-    if (currentValue != value)
-    {
-        m_dirty = true;
-        currentValue = value;
-        m_timer.start();
-    }
+    const QMutexLocker locker {&m_lock};
+    const std::shared_ptr<const QVariantHash> currentData = snapshot();
+    // check it first, so the data isn't copied when the value isn't changed
+    if (currentData->value(key) == value)
+        return;
+
+    QVariantHash newData = *currentData;
+    newData[key] = value;
+    setSnapshot(std::move(newData));
+    m_dirty = true;
+    m_timer.start();
+    notifyObservers(key, value);
+}
+
+std::shared_ptr<const QVariantHash> SettingsStorage::snapshot() const
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+    return m_data.load(std::memory_order_acquire);
+#else
+    return std::atomic_load(&m_data);
+#endif
+}
+
+// Should be called with the lock held.
+// The readers that have got the previous snapshot keep using it until they release it.
+void SettingsStorage::setSnapshot(QVariantHash data)
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+    m_data.store(std::make_shared<const QVariantHash>(std::move(data)), std::memory_order_release);
+#else
+    std::atomic_store(&m_data, std::make_shared<const QVariantHash>(std::move(data)));
+#endif
+}
+
+void SettingsStorage::notifyObservers(const QString &key, const QVariant &value) const
+{
+    const auto [begin, end] = m_observers.equal_range(key);
+    for (auto iter = begin; iter != end; ++iter)
+        iter.value()->handleValueChanged(value);
 }
 
 void SettingsStorage::readNativeSettings()
@@ -136,7 +204,8 @@ void SettingsStorage::readNativeSettings()
         return Path(nativeSettings->fileName());
     };
 
-    const Path newPath = deserialize(m_data, (m_nativeSettingsName + u"_new"));
+    QVariantHash data;
+    const Path newPath = deserialize(data, (m_nativeSettingsName + u"_new"));
     if (!newPath.isEmpty())
     {
         // "_new" file is NOT empty
@@ -157,11 +226,51 @@ void SettingsStorage::readNativeSettings()
     }
     else
     {
-        deserialize(m_data, m_nativeSettingsName);
+        deserialize(data, m_nativeSettingsName);
+    }
+
+    setSnapshot(std::move(data));
+}
+
+SettingsStorage::Worker::Worker(SettingsStorage *storage, const QString &nativeSettingsName)
+    : m_storage {storage}
+    , m_nativeSettingsName {nativeSettingsName}
+{
+}
+
+void SettingsStorage::Worker::schedule(const QVariantHash &data)
+{
+    const QMutexLocker locker {&m_mutex};
+
+    const bool isWriteScheduled = m_pendingData.has_value();
+    m_pendingData = data;
+    if (!isWriteScheduled)
+        QMetaObject::invokeMethod(this, &Worker::writePending, Qt::QueuedConnection);
+}
+
+void SettingsStorage::Worker::writePending()
+{
+    QMutexLocker locker {&m_mutex};
+    if (!m_pendingData)
+        return;
+
+    const QVariantHash data = *std::exchange(m_pendingData, std::nullopt);
+    locker.unlock();
+
+    if (!writeNativeSettings(data))
+    {
+        // retry later with the newest data
+        QMetaObject::invokeMethod(m_storage, [storage = m_storage] { storage->handleWriteFailed(); }, Qt::QueuedConnection);
+        return;
     }
+
+    // the newer data will be written soon, so it is reported after that
+    locker.relock();
+    if (!m_pendingData)
+        QMetaObject::invokeMethod(m_storage, &SettingsStorage::saved, Qt::QueuedConnection);
 }
 
-bool SettingsStorage::writeNativeSettings() const
+bool SettingsStorage::Worker::writeNativeSettings(const QVariantHash &data) const
 {
     std::unique_ptr<QSettings> nativeSettings = Profile::instance()->applicationSettings(m_nativeSettingsName + u"_new");
 
@@ -170,7 +279,7 @@ bool SettingsStorage::writeNativeSettings() const
     // between deleting the file and recreating it. This is a safety measure.
     // Write everything to qBittorrent_new.ini/qBittorrent_new.conf and if it succeeds
     // replace qBittorrent.ini/qBittorrent.conf with it.
-    for (auto i = m_data.begin(); i != m_data.end(); ++i)
+    for (auto i = data.cbegin(); i != data.cend(); ++i)
         nativeSettings->setValue(i.key(), i.value());
 
     nativeSettings->sync(); // Important to get error status
@@ -184,13 +293,13 @@ bool SettingsStorage::writeNativeSettings() const
     case QSettings::NoError:
         break;
     case QSettings::AccessError:
-        LogMsg(tr("An access error occurred while trying to write the configuration file."), Log::CRITICAL);
+        LogMsg(SettingsStorage::tr("An access error occurred while trying to write the configuration file."), Log::CRITICAL);
         break;
     case QSettings::FormatError:
-        LogMsg(tr("A format error occurred while trying to write the configuration file."), Log::CRITICAL);
+        LogMsg(SettingsStorage::tr("A format error occurred while trying to write the configuration file."), Log::CRITICAL);
         break;
     default:
-        LogMsg(tr("An unknown error occurred while trying to write the configuration file."), Log::CRITICAL);
+        LogMsg(SettingsStorage::tr("An unknown error occurred while trying to write the configuration file."), Log::CRITICAL);
         break;
     }
 
@@ -204,6 +313,11 @@ bool SettingsStorage::writeNativeSettings() const
     const int index = finalPathStr.lastIndexOf(u"_new", -1, Qt::CaseInsensitive);
     finalPathStr.remove(index, 4);
 
+    // The new file must reach the disk before it replaces the old one, otherwise
+    // both of them could be lost in case of power outage
+    if (!Utils::Fs::syncFile(newPath))
+        LogMsg(SettingsStorage::tr("Failed to flush the configuration file to disk. File: \"%1\".").arg(newPath.toString()), Log::WARNING);
+
     const Path finalPath {finalPathStr};
     Utils::Fs::removeFile(finalPath);
     return Utils::Fs::renameFile(newPath, finalPath);
@@ -211,16 +325,33 @@ bool SettingsStorage::writeNativeSettings() const
 
 void SettingsStorage::removeValue(const QString &key)
 {
-    const QWriteLocker locker(&m_lock);
-    if (m_data.remove(key))
-    {
-        m_dirty = true;
-        m_timer.start();
-    }
+    const QMutexLocker locker {&m_lock};
+    const std::shared_ptr<const QVariantHash> currentData = snapshot();
+    if (!currentData->contains(key))
+        return;
+
+    QVariantHash newData = *currentData;
+    newData.remove(key);
+    setSnapshot(std::move(newData));
+    m_dirty = true;
+    m_timer.start();
+    notifyObservers(key, {});
 }
 
 bool SettingsStorage::hasKey(const QString &key) const
 {
-    const QReadLocker locker {&m_lock};
-    return m_data.contains(key);
+    return snapshot()->contains(key);
+}
+
+void SettingsStorage::addObserver(const QString &key, Observer *observer)
+{
+    const QMutexLocker locker {&m_lock};
+    m_observers.insert(key, observer);
+    observer->handleValueChanged(snapshot()->value(key));
+}
+
+void SettingsStorage::removeObserver(const QString &key, Observer *observer)
+{
+    const QMutexLocker locker {&m_lock};
+    m_observers.remove(key, observer);
 }
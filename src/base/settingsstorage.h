@@ -30,16 +30,20 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <type_traits>
 
+#include <QMultiHash>
+#include <QMutex>
 #include <QObject>
-#include <QReadWriteLock>
 #include <QTimer>
 #include <QVariant>
 #include <QVariantHash>
 
 #include "base/concepts/stringable.h"
 #include "utils/string.h"
+#include "utils/thread.h"
 
 template <typename T>
 concept IsQFlags = std::same_as<T, QFlags<typename T::enum_type>>;
@@ -61,37 +65,57 @@ public:
     static void freeInstance();
     static SettingsStorage *instance();
 
+    // Gets notified of each change of some setting value (see `AtomicSettingValue`).
+    // It is called with the storage locked for writing, so it must not change the storage.
+    class Observer
+    {
+    public:
+        virtual ~Observer() = default;
+
+        // Invalid value means the setting is removed
+        virtual void handleValueChanged(const QVariant &value) = 0;
+    };
+
     template <typename T>
-    T loadValue(const QString &key, const T &defaultValue = {}) const
+    static T fromVariant(const QVariant &value, const T &defaultValue = {})
     {
         if constexpr (std::same_as<T, QVariant>)
         {
-            // fast path for loading QVariant
-            return loadValueImpl(key, defaultValue);
+            return value.isValid() ? value : defaultValue;
         }
         else if constexpr (Stringable<T>)
         {
-            const QString value = loadValue(key, defaultValue.toString());
-            return T {value};
+            return T {fromVariant(value, defaultValue.toString())};
         }
         else if constexpr (std::is_enum_v<T>)
         {
-            const auto value = loadValue<QString>(key);
-            return Utils::String::toEnum(value, defaultValue);
+            return Utils::String::toEnum(fromVariant<QString>(value), defaultValue);
         }
         else if constexpr (IsQFlags<T>)
         {
-            const typename T::Int value = loadValue(key, static_cast<typename T::Int>(defaultValue));
-            return T {value};
+            return T {fromVariant(value, static_cast<typename T::Int>(defaultValue))};
         }
         else
         {
-            const QVariant value = loadValueImpl(key);
             // check if retrieved value is convertible to T
             return value.template canConvert<T>() ? value.template value<T>() : defaultValue;
         }
     }
 
+    template <typename T>
+    T loadValue(const QString &key, const T &defaultValue = {}) const
+    {
+        if constexpr (std::same_as<T, QVariant>)
+        {
+            // fast path for loading QVariant
+            return loadValueImpl(key, defaultValue);
+        }
+        else
+        {
+            return fromVariant(loadValueImpl(key), defaultValue);
+        }
+    }
+
     template <typename T>
     void storeValue(const QString &key, const T &value)
     {
@@ -110,20 +134,49 @@ public:
     void removeValue(const QString &key);
     bool hasKey(const QString &key) const;
 
+    // The observer is notified of the current value immediately
+    void addObserver(const QString &key, Observer *observer);
+    void removeObserver(const QString &key, Observer *observer);
+
 public slots:
+    // The settings are written asynchronously (except when the storage is destroyed),
+    // so it returns `true` when they are different and are scheduled to be written
     bool save();
 
+signals:
+    // All the settings saved so far are written successfully
+    void saved();
+
 private:
+    class Worker;
+
+    void handleWriteFailed();
     QVariant loadValueImpl(const QString &key, const QVariant &defaultValue = {}) const;
     void storeValueImpl(const QString &key, const QVariant &value);
+    std::shared_ptr<const QVariantHash> snapshot() const;
+    void setSnapshot(QVariantHash data);
+    void notifyObservers(const QString &key, const QVariant &value) const;
     void readNativeSettings();
-    bool writeNativeSettings() const;
 
     static SettingsStorage *m_instance;
 
     const QString m_nativeSettingsName;
+    // The values are looked up in the immutable snapshot, so readers don't wait for writers (RCU-like).
+    // Writers replace the whole snapshot with the updated copy (see `setSnapshot()`).
+    // The snapshot pointer itself is swapped atomically, although the standard library
+    // may still use a short internal lock for it, i.e. it isn't necessarily lock-free.
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<std::shared_ptr<const QVariantHash>> m_data;
+#else
+    std::shared_ptr<const QVariantHash> m_data;  // accessed via std::atomic_load()/std::atomic_store() only
+#endif
+
+    // the following are guarded by m_lock, which is held by writers only
+    mutable QMutex m_lock;
     bool m_dirty = false;
-    QVariantHash m_data;
+    QMultiHash<QString, Observer *> m_observers;
     QTimer m_timer;
-    mutable QReadWriteLock m_lock;
+
+    Utils::Thread::UniquePtr m_ioThread;
+    std::unique_ptr<Worker> m_asyncWorker;
 };
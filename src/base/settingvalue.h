@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <type_traits>
+
 #include <QString>
 
 #include "settingsstorage.h"
@@ -106,3 +109,56 @@ private:
     SettingValue<T> m_setting;
     T m_cache;
 };
+
+// Use it for the settings of trivially copyable types (e.g. bool, number or enum) that are
+// read often, possibly from different threads. The converted value is kept in atomic variable
+// that is updated by `SettingsStorage` each time the setting is changed (by any means),
+// so reading it requires neither key lookup nor value conversion (the other settings
+// are looked up in the current snapshot of the storage and converted on each read).
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class AtomicSettingValue final : private SettingsStorage::Observer
+{
+    Q_DISABLE_COPY_MOVE(AtomicSettingValue)
+
+public:
+    explicit AtomicSettingValue(const QString &keyName, const T &defaultValue = {})
+        : m_keyName {keyName}
+        , m_defaultValue {defaultValue}
+        , m_value {defaultValue}
+    {
+        SettingsStorage::instance()->addObserver(m_keyName, this);
+    }
+
+    ~AtomicSettingValue() override
+    {
+        SettingsStorage::instance()->removeObserver(m_keyName, this);
+    }
+
+    T get() const
+    {
+        return m_value.load(std::memory_order_acquire);
+    }
+
+    operator T() const
+    {
+        return get();
+    }
+
+    AtomicSettingValue<T> &operator=(const T &value)
+    {
+        // the cached value is updated by the storage
+        SettingsStorage::instance()->storeValue(m_keyName, value);
+        return *this;
+    }
+
+private:
+    void handleValueChanged(const QVariant &value) override
+    {
+        m_value.store(SettingsStorage::fromVariant(value, m_defaultValue), std::memory_order_release);
+    }
+
+    const QString m_keyName;
+    const T m_defaultValue;
+    std::atomic<T> m_value;
+};
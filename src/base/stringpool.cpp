@@ -1,6 +1,6 @@
 /*
  * Bittorrent Client using Qt and libtorrent.
- * Copyright (C) 2006-2012  Christophe Dumez <chris@qbittorrent.org>
+ * Copyright (C) 2026  agent <agent@local>
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License
@@ -26,54 +26,49 @@
  * exception statement from your version.
  */
 
-#include "torrentcontentmodelfile.h"
+#include "stringpool.h"
 
-#include "torrentcontentmodelfolder.h"
+#include <algorithm>
 
-TorrentContentModelFile::TorrentContentModelFile(const QString &fileName, qulonglong fileSize,
-                                                 TorrentContentModelFolder *parent, int fileIndex)
-    : TorrentContentModelItem(parent)
-    , m_fileIndex(fileIndex)
+namespace
 {
-    Q_ASSERT(parent);
-
-    m_name = fileName;
-    m_size = fileSize;
-}
-
-int TorrentContentModelFile::fileIndex() const
-{
-    return m_fileIndex;
+    const qsizetype MIN_PURGE_THRESHOLD = 1024;
 }
 
-void TorrentContentModelFile::setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent)
+QString StringPool::intern(const QString &str)
 {
-    Q_ASSERT(newPriority != BitTorrent::DownloadPriority::Mixed);
+    if (str.isEmpty())
+        return {};
 
-    if (m_priority == newPriority)
-        return;
+    if (const auto iter = m_strings.constFind(str); iter != m_strings.cend())
+        return *iter;
 
-    m_priority = newPriority;
+    if (m_strings.size() >= std::max(m_purgeThreshold, MIN_PURGE_THRESHOLD))
+    {
+        // Purge is done when the pool doubles in size, so its cost is amortized
+        purge();
+        m_purgeThreshold = m_strings.size() * 2;
+    }
 
-    // Update parent
-    if (updateParent)
-        m_parentItem->updatePriority();
+    m_strings.insert(str);
+    return str;
 }
 
-void TorrentContentModelFile::setProgress(qreal progress)
+qsizetype StringPool::size() const
 {
-    m_progress = progress;
-    m_remaining = static_cast<qulonglong>(m_size * (1.0 - m_progress));
-    Q_ASSERT(m_progress <= 1.);
+    return m_strings.size();
 }
 
-void TorrentContentModelFile::setAvailability(const qreal availability)
+qint64 StringPool::memoryUsage() const
 {
-    m_availability = availability;
-    Q_ASSERT(m_availability <= 1.);
+    qint64 usage = m_strings.capacity() * sizeof(QString);
+    for (const QString &str : m_strings)
+        usage += str.capacity() * sizeof(QChar);
+    return usage;
 }
 
-TorrentContentModelItem::ItemType TorrentContentModelFile::itemType() const
+void StringPool::purge()
 {
-    return FileType;
+    // The strings that aren't shared are referenced by the pool only
+    m_strings.removeIf([](const QString &str) { return str.isDetached(); });
 }
@@ -1,6 +1,6 @@
 /*
  * Bittorrent Client using Qt and libtorrent.
- * Copyright (C) 2006-2012  Christophe Dumez <chris@qbittorrent.org>
+ * Copyright (C) 2026  agent <agent@local>
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License
@@ -28,25 +28,30 @@
 
 #pragma once
 
-#include "torrentcontentmodelitem.h"
+#include <QtGlobal>
+#include <QSet>
+#include <QString>
 
-namespace BitTorrent
+// Keeps a single copy of equal strings, so the values that are repeated
+// in many objects (e.g. tracker URLs or category names) share the same data.
+// It isn't thread-safe, so it should be used from a single thread only.
+class StringPool
 {
-    enum class DownloadPriority;
-}
+    Q_DISABLE_COPY_MOVE(StringPool)
 
-class TorrentContentModelFile final : public TorrentContentModelItem
-{
 public:
-    TorrentContentModelFile(const QString &fileName, qulonglong fileSize,
-                            TorrentContentModelFolder *parent, int fileIndex);
+    StringPool() = default;
+
+    // Returns the string that shares its data with all the equal strings
+    // returned by this pool before
+    QString intern(const QString &str);
 
-    int fileIndex() const;
-    void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) override;
-    void setProgress(qreal progress);
-    void setAvailability(qreal availability);
-    ItemType itemType() const override;
+    qsizetype size() const;
+    qint64 memoryUsage() const;
 
 private:
-    int m_fileIndex;
+    void purge();
+
+    QSet<QString> m_strings;
+    qsizetype m_purgeThreshold = 0;
 };
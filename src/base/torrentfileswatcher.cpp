@@ -29,20 +29,37 @@
 
 #include "torrentfileswatcher.h"
 
+#include <algorithm>
 #include <chrono>
 
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 #include <QtAssert>
+#include <QDateTime>
+#include <QDeadlineTimer>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSet>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QVariant>
 
+#ifdef Q_OS_LINUX
+#include <QSocketNotifier>
+#endif
+
 #include "base/algorithm.h"
 #include "base/bittorrent/torrentcontentlayout.h"
 #include "base/bittorrent/session.h"
@@ -61,6 +78,15 @@ using namespace std::chrono_literals;
 
 const std::chrono::seconds WATCH_INTERVAL {10};
 const int MAX_FAILED_RETRIES = 5;
+// Changes of directory modification time can be unnoticed if they happen
+// within its resolution, which is 2 seconds in the worst case (FAT)
+const std::chrono::seconds MODIFICATION_TIME_RESOLUTION {2};
+// The number of torrent files that are loaded at once
+const int LOAD_BATCH_SIZE = 64;
+#ifdef Q_OS_LINUX
+const std::chrono::seconds FILE_SETTLE_DELAY {2};
+const uint32_t INOTIFY_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+#endif
 const QString CONF_FILE_NAME = u"watched_folders.json"_s;
 
 const QString OPTION_ADDTORRENTPARAMS = u"add_torrent_params"_s;
@@ -68,6 +94,8 @@ const QString OPTION_RECURSIVE = u"recursive"_s;
 
 namespace
 {
+    using LoadTorrentResult = nonstd::expected<BitTorrent::TorrentDescriptor, QString>;
+
     TorrentFilesWatcher::WatchedFolderOptions parseWatchedFolderOptions(const QJsonObject &jsonObj)
     {
         TorrentFilesWatcher::WatchedFolderOptions options;
@@ -82,6 +110,28 @@ namespace
         return {{OPTION_ADDTORRENTPARAMS, BitTorrent::serializeAddTorrentParams(options.addTorrentParams)},
                 {OPTION_RECURSIVE, options.recursive}};
     }
+
+    BitTorrent::AddTorrentParams makeAddTorrentParams(const Path &folderPath, const Path &watchedFolderPath
+            , const TorrentFilesWatcher::WatchedFolderOptions &options)
+    {
+        BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
+        if (folderPath != watchedFolderPath)
+        {
+            const Path subdirPath = watchedFolderPath.relativePathOf(folderPath);
+            const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
+            if (useAutoTMM)
+            {
+                addTorrentParams.category = addTorrentParams.category.isEmpty()
+                        ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
+            }
+            else
+            {
+                addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
+            }
+        }
+
+        return addTorrentParams;
+    }
 }
 
 class TorrentFilesWatcher::Worker final : public QObject
@@ -91,6 +141,7 @@ class TorrentFilesWatcher::Worker final : public QObject
 
 public:
     Worker();
+    ~Worker() override;
 
 public slots:
     void setWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
@@ -100,22 +151,67 @@ signals:
     void torrentFound(const BitTorrent::TorrentDescriptor &torrentDescr, const BitTorrent::AddTorrentParams &addTorrentParams);
 
 private:
+    // Remembers the folder content that was seen by the last scan,
+    // so unchanged folders aren't listed again when they are rescanned
+    struct FolderState
+    {
+        QDateTime lastModified;
+        QDateTime lastScanned;
+        PathList subfolders;
+    };
+
     void onTimeout();
     void scheduleWatchedFolderProcessing(const Path &path);
     void processWatchedFolder(const Path &path);
     void processFolder(const Path &path, const Path &watchedFolderPath, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void processFiles(const PathList &filePaths, const Path &folderPath, const Path &watchedFolderPath
+            , const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void processMagnetFile(const Path &filePath, const BitTorrent::AddTorrentParams &addTorrentParams);
+    QVector<LoadTorrentResult> loadTorrentFiles(const PathList &filePaths);
     void processFailedTorrents();
     void addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
     void updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void startWatching(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void stopWatching(const Path &path);
 
     QFileSystemWatcher *m_watcher = nullptr;
     QTimer *m_watchTimer = nullptr;
     QHash<Path, TorrentFilesWatcher::WatchedFolderOptions> m_watchedFolders;
     QSet<Path> m_watchedByTimeoutFolders;
+    QHash<Path, FolderState> m_folderStates;
+    QThreadPool *m_loadingPool = nullptr;
 
     // Failed torrents
     QTimer *m_retryTorrentTimer = nullptr;
     QHash<Path, QHash<Path, int>> m_failedTorrents;
+
+#ifdef Q_OS_LINUX
+    struct InotifyWatch
+    {
+        Path path;
+        Path watchedFolderPath;
+    };
+
+    // Files are processed when they haven't been changed for some time
+    struct SettlingFolder
+    {
+        Path watchedFolderPath;
+        QHash<Path, QDeadlineTimer> files;
+    };
+
+    void readInotifyEvents();
+    void handleInotifyEvent(const inotify_event &event);
+    bool addInotifyWatches(const Path &path, const Path &watchedFolderPath, bool recursive);
+    void removeInotifyWatches(const Path &watchedFolderPath);
+    void scheduleFileProcessing(const Path &filePath, const Path &folderPath, const Path &watchedFolderPath);
+    void processSettledFiles();
+
+    int m_inotifyFD = -1;
+    QSocketNotifier *m_inotifyNotifier = nullptr;
+    QHash<int, InotifyWatch> m_inotifyWatches;
+    QHash<Path, SettlingFolder> m_settlingFolders;
+    QTimer *m_settleTimer = nullptr;
+#endif
 };
 
 TorrentFilesWatcher *TorrentFilesWatcher::m_instance = nullptr;
@@ -337,6 +433,7 @@ void TorrentFilesWatcher::onTorrentFound(const BitTorrent::TorrentDescriptor &to
 TorrentFilesWatcher::Worker::Worker()
     : m_watcher {new QFileSystemWatcher(this)}
     , m_watchTimer {new QTimer(this)}
+    , m_loadingPool {new QThreadPool(this)}
     , m_retryTorrentTimer {new QTimer(this)}
 {
     connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &path)
@@ -346,6 +443,35 @@ TorrentFilesWatcher::Worker::Worker()
     connect(m_watchTimer, &QTimer::timeout, this, &Worker::onTimeout);
 
     connect(m_retryTorrentTimer, &QTimer::timeout, this, &Worker::processFailedTorrents);
+
+#ifdef Q_OS_LINUX
+    m_inotifyFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFD >= 0)
+    {
+        m_inotifyNotifier = new QSocketNotifier(m_inotifyFD, QSocketNotifier::Read, this);
+        connect(m_inotifyNotifier, &QSocketNotifier::activated, this, &Worker::readInotifyEvents);
+
+        m_settleTimer = new QTimer(this);
+        m_settleTimer->setSingleShot(true);
+        connect(m_settleTimer, &QTimer::timeout, this, &Worker::processSettledFiles);
+    }
+    else
+    {
+        LogMsg(tr("Failed to initialize inotify. Watched folders will be checked periodically. Reason: %1")
+                .arg(QString::fromLocal8Bit(std::strerror(errno))), Log::WARNING);
+    }
+#endif
+}
+
+TorrentFilesWatcher::Worker::~Worker()
+{
+#ifdef Q_OS_LINUX
+    if (m_inotifyFD >= 0)
+    {
+        delete m_inotifyNotifier;
+        ::close(m_inotifyFD);
+    }
+#endif
 }
 
 void TorrentFilesWatcher::Worker::onTimeout()
@@ -365,11 +491,7 @@ void TorrentFilesWatcher::Worker::setWatchedFolder(const Path &path, const Torre
 void TorrentFilesWatcher::Worker::removeWatchedFolder(const Path &path)
 {
     m_watchedFolders.remove(path);
-
-    m_watcher->removePath(path.data());
-    m_watchedByTimeoutFolders.remove(path);
-    if (m_watchedByTimeoutFolders.isEmpty())
-        m_watchTimer->stop();
+    stopWatching(path);
 
     m_failedTorrents.remove(path);
     if (m_failedTorrents.isEmpty())
@@ -386,95 +508,165 @@ void TorrentFilesWatcher::Worker::scheduleWatchedFolderProcessing(const Path &pa
 
 void TorrentFilesWatcher::Worker::processWatchedFolder(const Path &path)
 {
-    const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(path);
-    processFolder(path, path, options);
+    const auto optionsIter = m_watchedFolders.constFind(path);
+    if (optionsIter == m_watchedFolders.cend())
+        return;
 
-    if (!m_failedTorrents.empty() && !m_retryTorrentTimer->isActive())
-        m_retryTorrentTimer->start(WATCH_INTERVAL);
+    processFolder(path, path, optionsIter.value());
 }
 
 void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &watchedFolderPath
                                               , const TorrentFilesWatcher::WatchedFolderOptions &options)
 {
-    QDirIterator dirIter {path.data(), {u"*.torrent"_s, u"*.magnet"_s}, QDir::Files};
-    while (dirIter.hasNext())
+    const QDateTime scanTime = QDateTime::currentDateTime();
+    const QDateTime lastModified = QFileInfo(path.data()).lastModified();
+    if (!lastModified.isValid())
     {
-        const Path filePath {dirIter.next()};
-        BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
-        if (path != watchedFolderPath)
+        m_folderStates.remove(path);
+        return;
+    }
+
+    PathList subfolders;
+    FolderState &folderState = m_folderStates[path];
+    // Any entry added, removed or renamed in the folder changes its modification time,
+    // so the listing of the folder can be skipped if it wasn't changed since the last scan
+    const bool isUnchanged = (folderState.lastModified == lastModified)
+            && (folderState.lastModified.secsTo(folderState.lastScanned) >= MODIFICATION_TIME_RESOLUTION.count());
+    if (isUnchanged)
+    {
+        subfolders = folderState.subfolders;
+    }
+    else
+    {
+        if (options.recursive)
         {
-            const Path subdirPath = watchedFolderPath.relativePathOf(path);
-            const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
-            if (useAutoTMM)
-            {
-                addTorrentParams.category = addTorrentParams.category.isEmpty()
-                        ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
-            }
-            else
-            {
-                addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
-            }
+            QDirIterator dirIter {path.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
+            while (dirIter.hasNext())
+                subfolders.append(Path(dirIter.next()));
         }
 
-        if (filePath.hasExtension(u".magnet"_s))
-        {
-            const int fileMaxSize = 100 * 1024 * 1024;
+        folderState = {lastModified, scanTime, subfolders};
 
-            QFile file {filePath.data()};
-            if (file.open(QIODevice::ReadOnly | QIODevice::Text))
-            {
-                if (file.size() <= fileMaxSize)
-                {
-                    while (!file.atEnd())
-                    {
-                        const auto line = QString::fromLatin1(file.readLine()).trimmed();
-                        if (const auto parseResult = BitTorrent::TorrentDescriptor::parse(line))
-                            emit torrentFound(parseResult.value(), addTorrentParams);
-                        else
-                            LogMsg(tr("Invalid Magnet URI. URI: %1. Reason: %2").arg(line, parseResult.error()), Log::WARNING);
-                    }
-
-                    file.close();
-                    Utils::Fs::removeFile(filePath);
-                }
-                else
-                {
-                    LogMsg(tr("Magnet file too big. File: %1").arg(file.errorString()), Log::WARNING);
-                }
-            }
-            else
-            {
-                LogMsg(tr("Failed to open magnet file: %1").arg(file.errorString()));
-            }
+        // Failed torrents are retried separately
+        const QHash<Path, int> failedTorrents = m_failedTorrents.value(watchedFolderPath);
+        PathList filePaths;
+        QDirIterator dirIter {path.data(), {u"*.torrent"_s, u"*.magnet"_s}, QDir::Files};
+        while (dirIter.hasNext())
+        {
+            const Path filePath {dirIter.next()};
+            if (!failedTorrents.contains(filePath))
+                filePaths.append(filePath);
         }
+
+        processFiles(filePaths, path, watchedFolderPath, options);
+    }
+
+    for (const Path &folderPath : asConst(subfolders))
+    {
+        // Skip processing of subdirectory that is explicitly set as watched folder
+        if (!m_watchedFolders.contains(folderPath))
+            processFolder(folderPath, watchedFolderPath, options);
+    }
+}
+
+void TorrentFilesWatcher::Worker::processFiles(const PathList &filePaths, const Path &folderPath, const Path &watchedFolderPath
+        , const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    if (filePaths.isEmpty())
+        return;
+
+    const BitTorrent::AddTorrentParams addTorrentParams = makeAddTorrentParams(folderPath, watchedFolderPath, options);
+
+    PathList torrentFilePaths;
+    for (const Path &filePath : filePaths)
+    {
+        if (filePath.hasExtension(u".magnet"_s))
+            processMagnetFile(filePath, addTorrentParams);
         else
+            torrentFilePaths.append(filePath);
+    }
+
+    for (qsizetype batchStart = 0; batchStart < torrentFilePaths.size(); batchStart += LOAD_BATCH_SIZE)
+    {
+        const PathList batch = torrentFilePaths.mid(batchStart, LOAD_BATCH_SIZE);
+        const QVector<LoadTorrentResult> loadResults = loadTorrentFiles(batch);
+        for (qsizetype i = 0; i < batch.size(); ++i)
         {
-            if (const auto loadResult = BitTorrent::TorrentDescriptor::loadFromFile(filePath))
+            const Path &filePath = batch[i];
+            if (const LoadTorrentResult &loadResult = loadResults[i])
             {
                 emit torrentFound(loadResult.value(), addTorrentParams);
                 Utils::Fs::removeFile(filePath);
+
+                if (const auto failedIter = m_failedTorrents.find(watchedFolderPath); failedIter != m_failedTorrents.end())
+                    failedIter->remove(filePath);
             }
             else
             {
-                if (!m_failedTorrents.value(path).contains(filePath))
-                {
-                    m_failedTorrents[path][filePath] = 0;
-                }
+                QHash<Path, int> &failedTorrents = m_failedTorrents[watchedFolderPath];
+                if (!failedTorrents.contains(filePath))
+                    failedTorrents[filePath] = 0;
             }
         }
     }
 
-    if (options.recursive)
+    if (!m_failedTorrents.empty() && !m_retryTorrentTimer->isActive())
+        m_retryTorrentTimer->start(WATCH_INTERVAL);
+}
+
+void TorrentFilesWatcher::Worker::processMagnetFile(const Path &filePath, const BitTorrent::AddTorrentParams &addTorrentParams)
+{
+    const int fileMaxSize = 100 * 1024 * 1024;
+
+    QFile file {filePath.data()};
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
-        QDirIterator dirIter {path.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
-        while (dirIter.hasNext())
+        if (file.size() <= fileMaxSize)
         {
-            const Path folderPath {dirIter.next()};
-            // Skip processing of subdirectory that is explicitly set as watched folder
-            if (!m_watchedFolders.contains(folderPath))
-                processFolder(folderPath, watchedFolderPath, options);
+            while (!file.atEnd())
+            {
+                const auto line = QString::fromLatin1(file.readLine()).trimmed();
+                if (const auto parseResult = BitTorrent::TorrentDescriptor::parse(line))
+                    emit torrentFound(parseResult.value(), addTorrentParams);
+                else
+                    LogMsg(tr("Invalid Magnet URI. URI: %1. Reason: %2").arg(line, parseResult.error()), Log::WARNING);
+            }
+
+            file.close();
+            Utils::Fs::removeFile(filePath);
         }
+        else
+        {
+            LogMsg(tr("Magnet file too big. File: %1").arg(file.errorString()), Log::WARNING);
+        }
+    }
+    else
+    {
+        LogMsg(tr("Failed to open magnet file: %1").arg(file.errorString()));
+    }
+}
+
+QVector<LoadTorrentResult> TorrentFilesWatcher::Worker::loadTorrentFiles(const PathList &filePaths)
+{
+    QVector<LoadTorrentResult> results(filePaths.size());
+    if (filePaths.size() == 1)
+    {
+        results[0] = BitTorrent::TorrentDescriptor::loadFromFile(filePaths[0]);
+        return results;
+    }
+
+    // Torrent files don't depend on each other, so they are loaded in parallel
+    LoadTorrentResult *resultsData = results.data();
+    for (qsizetype i = 0; i < filePaths.size(); ++i)
+    {
+        m_loadingPool->start([result = (resultsData + i), filePath = filePaths[i]]
+        {
+            *result = BitTorrent::TorrentDescriptor::loadFromFile(filePath);
+        });
     }
+    m_loadingPool->waitForDone();
+
+    return results;
 }
 
 void TorrentFilesWatcher::Worker::processFailedTorrents()
@@ -490,23 +682,7 @@ void TorrentFilesWatcher::Worker::processFailedTorrents()
 
             if (const auto loadResult = BitTorrent::TorrentDescriptor::loadFromFile(torrentPath))
             {
-                BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
-                if (torrentPath != watchedFolderPath)
-                {
-                    const Path subdirPath = watchedFolderPath.relativePathOf(torrentPath);
-                    const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
-                    if (useAutoTMM)
-                    {
-                        addTorrentParams.category = addTorrentParams.category.isEmpty()
-                                ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
-                    }
-                    else
-                    {
-                        addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
-                    }
-                }
-
-                emit torrentFound(loadResult.value(), addTorrentParams);
+                emit torrentFound(loadResult.value(), makeAddTorrentParams(torrentPath.parentPath(), watchedFolderPath, options));
                 Utils::Fs::removeFile(torrentPath);
 
                 return true;
@@ -537,9 +713,44 @@ void TorrentFilesWatcher::Worker::processFailedTorrents()
 }
 
 void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    m_watchedFolders[path] = options;
+    startWatching(path, options);
+
+    LogMsg(tr("Watching folder: \"%1\"").arg(path.toString()));
+}
+
+void TorrentFilesWatcher::Worker::updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    const bool recursiveModeChanged = (m_watchedFolders[path].recursive != options.recursive);
+    m_watchedFolders[path] = options;
+
+    if (recursiveModeChanged)
+    {
+        stopWatching(path);
+        startWatching(path, options);
+    }
+}
+
+void TorrentFilesWatcher::Worker::startWatching(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
 {
     // Check if the `path` points to a network file system or not
-    if (Utils::Fs::isNetworkFileSystem(path) || options.recursive)
+    const bool isNetworkFS = Utils::Fs::isNetworkFileSystem(path);
+
+#ifdef Q_OS_LINUX
+    if (!isNetworkFS && (m_inotifyFD >= 0))
+    {
+        if (addInotifyWatches(path, path, options.recursive))
+        {
+            scheduleWatchedFolderProcessing(path);
+            return;
+        }
+
+        removeInotifyWatches(path);
+    }
+#endif
+
+    if (isNetworkFS || options.recursive)
     {
         m_watchedByTimeoutFolders.insert(path);
         if (!m_watchTimer->isActive())
@@ -550,37 +761,195 @@ void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const Torre
         m_watcher->addPath(path.data());
         scheduleWatchedFolderProcessing(path);
     }
+}
 
-    m_watchedFolders[path] = options;
+void TorrentFilesWatcher::Worker::stopWatching(const Path &path)
+{
+    m_watcher->removePath(path.data());
+    m_watchedByTimeoutFolders.remove(path);
+    if (m_watchedByTimeoutFolders.isEmpty())
+        m_watchTimer->stop();
 
-    LogMsg(tr("Watching folder: \"%1\"").arg(path.toString()));
+#ifdef Q_OS_LINUX
+    if (m_inotifyFD >= 0)
+        removeInotifyWatches(path);
+#endif
+
+    Algorithm::removeIf(m_folderStates, [&path](const Path &folderPath, const FolderState &)
+    {
+        return (folderPath == path) || folderPath.hasAncestor(path);
+    });
 }
 
-void TorrentFilesWatcher::Worker::updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+#ifdef Q_OS_LINUX
+void TorrentFilesWatcher::Worker::readInotifyEvents()
 {
-    const bool recursiveModeChanged = (m_watchedFolders[path].recursive != options.recursive);
-    if (recursiveModeChanged && !Utils::Fs::isNetworkFileSystem(path))
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true)
     {
-        if (options.recursive)
+        const ssize_t length = ::read(m_inotifyFD, buffer, sizeof(buffer));
+        if (length < 0)
         {
-            m_watcher->removePath(path.data());
+            if (errno == EINTR)
+                continue;
 
-            m_watchedByTimeoutFolders.insert(path);
-            if (!m_watchTimer->isActive())
-                m_watchTimer->start(WATCH_INTERVAL);
+            // No more events are available
+            break;
         }
-        else
+
+        for (const char *ptr = buffer; ptr < (buffer + length);)
         {
-            m_watchedByTimeoutFolders.remove(path);
-            if (m_watchedByTimeoutFolders.isEmpty())
-                m_watchTimer->stop();
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+            handleInotifyEvent(*event);
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+}
 
-            m_watcher->addPath(path.data());
-            scheduleWatchedFolderProcessing(path);
+void TorrentFilesWatcher::Worker::handleInotifyEvent(const inotify_event &event)
+{
+    if (event.mask & IN_Q_OVERFLOW)
+    {
+        // Some events are lost, so the folders should be rescanned
+        QSet<Path> watchedFolderPaths;
+        for (const InotifyWatch &watch : asConst(m_inotifyWatches))
+            watchedFolderPaths.insert(watch.watchedFolderPath);
+        for (const Path &watchedFolderPath : asConst(watchedFolderPaths))
+            scheduleWatchedFolderProcessing(watchedFolderPath);
+        return;
+    }
+
+    const auto watchIter = m_inotifyWatches.constFind(event.wd);
+    if (watchIter == m_inotifyWatches.cend())
+        return;
+
+    if (event.mask & IN_IGNORED)
+    {
+        // The watch was removed or the folder was deleted
+        m_inotifyWatches.erase(watchIter);
+        return;
+    }
+
+    if (event.len == 0)
+        return;
+
+    const Path folderPath = watchIter->path;
+    const Path watchedFolderPath = watchIter->watchedFolderPath;
+    const Path entryPath = folderPath / Path(QFile::decodeName(event.name));
+
+    if (event.mask & IN_ISDIR)
+    {
+        // Skip subdirectory that is explicitly set as watched folder
+        if (!m_watchedFolders.value(watchedFolderPath).recursive || m_watchedFolders.contains(entryPath))
+            return;
+
+        addInotifyWatches(entryPath, watchedFolderPath, true);
+
+        // The folder could get some files before it started to be watched
+        QDirIterator dirIter {entryPath.data(), {u"*.torrent"_s, u"*.magnet"_s}, QDir::Files, QDirIterator::Subdirectories};
+        while (dirIter.hasNext())
+        {
+            const Path filePath {dirIter.next()};
+            scheduleFileProcessing(filePath, filePath.parentPath(), watchedFolderPath);
+        }
+    }
+    else if ((event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            && (entryPath.hasExtension(u".torrent"_s) || entryPath.hasExtension(u".magnet"_s)))
+    {
+        scheduleFileProcessing(entryPath, folderPath, watchedFolderPath);
+    }
+}
+
+bool TorrentFilesWatcher::Worker::addInotifyWatches(const Path &path, const Path &watchedFolderPath, const bool recursive)
+{
+    const int wd = ::inotify_add_watch(m_inotifyFD, QFile::encodeName(path.data()).constData(), INOTIFY_EVENTS);
+    if (wd < 0)
+    {
+        LogMsg(tr("Failed to watch folder changes. Folder: \"%1\". Reason: %2")
+                .arg(path.toString(), QString::fromLocal8Bit(std::strerror(errno))), Log::WARNING);
+        return false;
+    }
+
+    m_inotifyWatches[wd] = {path, watchedFolderPath};
+
+    if (recursive)
+    {
+        QDirIterator dirIter {path.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
+        while (dirIter.hasNext())
+        {
+            const Path folderPath {dirIter.next()};
+            // Skip subdirectory that is explicitly set as watched folder
+            if (!m_watchedFolders.contains(folderPath) && !addInotifyWatches(folderPath, watchedFolderPath, true))
+                return false;
         }
     }
 
-    m_watchedFolders[path] = options;
+    return true;
+}
+
+void TorrentFilesWatcher::Worker::removeInotifyWatches(const Path &watchedFolderPath)
+{
+    Algorithm::removeIf(m_inotifyWatches, [this, &watchedFolderPath](const int wd, const InotifyWatch &watch)
+    {
+        if (watch.watchedFolderPath != watchedFolderPath)
+            return false;
+
+        ::inotify_rm_watch(m_inotifyFD, wd);
+        return true;
+    });
+
+    Algorithm::removeIf(m_settlingFolders, [&watchedFolderPath](const Path &, const SettlingFolder &settlingFolder)
+    {
+        return (settlingFolder.watchedFolderPath == watchedFolderPath);
+    });
+}
+
+void TorrentFilesWatcher::Worker::scheduleFileProcessing(const Path &filePath, const Path &folderPath, const Path &watchedFolderPath)
+{
+    // The file can still be changed (e.g. some applications rewrite it several times),
+    // so its processing is postponed until it isn't changed for a while
+    SettlingFolder &settlingFolder = m_settlingFolders[folderPath];
+    settlingFolder.watchedFolderPath = watchedFolderPath;
+    settlingFolder.files[filePath] = QDeadlineTimer(FILE_SETTLE_DELAY);
+
+    if (!m_settleTimer->isActive())
+        m_settleTimer->start(FILE_SETTLE_DELAY);
+}
+
+void TorrentFilesWatcher::Worker::processSettledFiles()
+{
+    QDeadlineTimer nextDeadline {QDeadlineTimer::Forever};
+    for (auto folderIter = m_settlingFolders.begin(); folderIter != m_settlingFolders.end();)
+    {
+        const Path folderPath = folderIter.key();
+        const Path watchedFolderPath = folderIter->watchedFolderPath;
+        QHash<Path, QDeadlineTimer> &files = folderIter->files;
+
+        PathList settledFiles;
+        for (auto fileIter = files.begin(); fileIter != files.end();)
+        {
+            if (fileIter->hasExpired())
+            {
+                // The file could be removed or renamed in the meantime
+                if (fileIter.key().exists())
+                    settledFiles.append(fileIter.key());
+                fileIter = files.erase(fileIter);
+            }
+            else
+            {
+                nextDeadline = std::min(nextDeadline, fileIter.value());
+                ++fileIter;
+            }
+        }
+
+        folderIter = (files.isEmpty() ? m_settlingFolders.erase(folderIter) : std::next(folderIter));
+
+        processFiles(settledFiles, folderPath, watchedFolderPath, m_watchedFolders.value(watchedFolderPath));
+    }
+
+    if (!m_settlingFolders.isEmpty())
+        m_settleTimer->start(std::chrono::ceil<std::chrono::milliseconds>(nextDeadline.remainingTimeAsDuration()));
 }
+#endif
 
 #include "torrentfileswatcher.moc"
@@ -28,12 +28,18 @@
 
 #include "torrentfilter.h"
 
+#include <algorithm>
+
 #include "bittorrent/infohash.h"
+#include "bittorrent/session.h"
 #include "bittorrent/torrent.h"
+#include "bittorrent/trackerentry.h"
+#include "global.h"
 
 const std::optional<QString> TorrentFilter::AnyCategory;
 const std::optional<TorrentIDSet> TorrentFilter::AnyID;
 const std::optional<QString> TorrentFilter::AnyTag;
+const std::optional<QString> TorrentFilter::AnyTracker;
 
 const TorrentFilter TorrentFilter::DownloadingTorrent(TorrentFilter::Downloading);
 const TorrentFilter TorrentFilter::SeedingTorrent(TorrentFilter::Seeding);
@@ -50,6 +56,45 @@ const TorrentFilter TorrentFilter::MovingTorrent(TorrentFilter::Moving);
 const TorrentFilter TorrentFilter::ErroredTorrent(TorrentFilter::Errored);
 
 using BitTorrent::Torrent;
+using BitTorrent::TorrentStateFlag;
+
+namespace
+{
+    // "All" and "Stalled" filter types are not mapped since they don't correspond to a single flag
+    TorrentStateFlag stateFlagOf(const TorrentFilter::Type type)
+    {
+        switch (type)
+        {
+        case TorrentFilter::Downloading:
+            return TorrentStateFlag::Downloading;
+        case TorrentFilter::Seeding:
+            return TorrentStateFlag::Seeding;
+        case TorrentFilter::Completed:
+            return TorrentStateFlag::Completed;
+        case TorrentFilter::Paused:
+            return TorrentStateFlag::Paused;
+        case TorrentFilter::Resumed:
+            return TorrentStateFlag::Resumed;
+        case TorrentFilter::Active:
+            return TorrentStateFlag::Active;
+        case TorrentFilter::Inactive:
+            return TorrentStateFlag::Inactive;
+        case TorrentFilter::StalledUploading:
+            return TorrentStateFlag::StalledUploading;
+        case TorrentFilter::StalledDownloading:
+            return TorrentStateFlag::StalledDownloading;
+        case TorrentFilter::Checking:
+            return TorrentStateFlag::Checking;
+        case TorrentFilter::Moving:
+            return TorrentStateFlag::Moving;
+        case TorrentFilter::Errored:
+            return TorrentStateFlag::Errored;
+        default:
+            Q_ASSERT(false);
+            return {};
+        }
+    }
+}
 
 TorrentFilter::TorrentFilter(const Type type, const std::optional<TorrentIDSet> &idSet
                              , const std::optional<QString> &category, const std::optional<QString> &tag)
@@ -147,11 +192,76 @@ bool TorrentFilter::setTag(const std::optional<QString> &tag)
     return false;
 }
 
+bool TorrentFilter::setTrackerHost(const std::optional<QString> &trackerHost)
+{
+    if (m_trackerHost != trackerHost)
+    {
+        m_trackerHost = trackerHost;
+        return true;
+    }
+
+    return false;
+}
+
 bool TorrentFilter::match(const Torrent *const torrent) const
 {
     if (!torrent) return false;
 
-    return (matchState(torrent) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent));
+    return (matchState(torrent) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent)
+            && matchTracker(torrent));
+}
+
+QVector<Torrent *> TorrentFilter::findMatchingTorrents() const
+{
+    const auto *session = BitTorrent::Session::instance();
+
+    QVector<Torrent *> torrents;
+    if (m_idSet)
+    {
+        torrents.reserve(m_idSet->size());
+        for (const BitTorrent::TorrentID &id : asConst(*m_idSet))
+        {
+            if (Torrent *torrent = session->getTorrent(id))
+                torrents.append(torrent);
+        }
+    }
+    else if (m_trackerHost)
+    {
+        torrents = session->trackerHostTorrents(*m_trackerHost);
+    }
+    else if (m_tag)
+    {
+        torrents = session->taggedTorrents(*m_tag);
+    }
+    else if (m_category)
+    {
+        torrents = session->categoryTorrents(*m_category);
+        if (!m_category->isEmpty() && session->isSubcategoriesEnabled())
+        {
+            const QString subcategoryPrefix = *m_category + u'/';
+            for (const QString &category : asConst(session->categories()))
+            {
+                if (category.startsWith(subcategoryPrefix))
+                    torrents.append(session->categoryTorrents(category));
+            }
+        }
+    }
+    else if (m_type == Stalled)
+    {
+        torrents = session->stateTorrents(TorrentStateFlag::StalledUploading)
+                + session->stateTorrents(TorrentStateFlag::StalledDownloading);
+    }
+    else if (m_type != All)
+    {
+        torrents = session->stateTorrents(stateFlagOf(m_type));
+    }
+    else
+    {
+        torrents = session->torrents();
+    }
+
+    torrents.removeIf([this](const Torrent *torrent) { return !match(torrent); });
+    return torrents;
 }
 
 bool TorrentFilter::matchState(const BitTorrent::Torrent *const torrent) const
@@ -159,37 +269,11 @@ bool TorrentFilter::matchState(const BitTorrent::Torrent *const torrent) const
     switch (m_type)
     {
     case All:
-    default:
         return true;
-    case Downloading:
-        return torrent->isDownloading();
-    case Seeding:
-        return torrent->isUploading();
-    case Completed:
-        return torrent->isCompleted();
-    case Paused:
-        return torrent->isPaused();
-    case Resumed:
-        return torrent->isResumed();
-    case Active:
-        return torrent->isActive();
-    case Inactive:
-        return torrent->isInactive();
     case Stalled:
-        return (torrent->state() ==  BitTorrent::TorrentState::StalledUploading)
-                || (torrent->state() ==  BitTorrent::TorrentState::StalledDownloading);
-    case StalledUploading:
-        return torrent->state() ==  BitTorrent::TorrentState::StalledUploading;
-    case StalledDownloading:
-        return torrent->state() ==  BitTorrent::TorrentState::StalledDownloading;
-    case Checking:
-        return (torrent->state() == BitTorrent::TorrentState::CheckingUploading)
-                || (torrent->state() == BitTorrent::TorrentState::CheckingDownloading)
-                || (torrent->state() == BitTorrent::TorrentState::CheckingResumeData);
-    case Moving:
-        return torrent->isMoving();
-    case Errored:
-        return torrent->isErrored();
+        return torrent->stateFlags().testAnyFlags(TorrentStateFlag::StalledUploading | TorrentStateFlag::StalledDownloading);
+    default:
+        return torrent->stateFlags().testFlag(stateFlagOf(m_type));
     }
 }
 
@@ -216,7 +300,24 @@ bool TorrentFilter::matchTag(const BitTorrent::Torrent *const torrent) const
 
     // Empty tag is a special value to indicate we're filtering for untagged torrents.
     if (m_tag->isEmpty())
-        return torrent->tags().isEmpty();
+        return torrent->tagIDs().isEmpty();
 
     return torrent->hasTag(*m_tag);
 }
+
+bool TorrentFilter::matchTracker(const BitTorrent::Torrent *const torrent) const
+{
+    if (!m_trackerHost)
+        return true;
+
+    const QVector<BitTorrent::TrackerEntry> trackers = torrent->trackers();
+    // Empty host is a special value to indicate we're filtering for trackerless torrents.
+    if (m_trackerHost->isEmpty())
+        return trackers.isEmpty();
+
+    const auto *session = BitTorrent::Session::instance();
+    return std::any_of(trackers.cbegin(), trackers.cend(), [this, session](const BitTorrent::TrackerEntry &tracker)
+    {
+        return (session->trackerHost(tracker.url) == *m_trackerHost);
+    });
+}
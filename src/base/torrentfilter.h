@@ -32,6 +32,7 @@
 
 #include <QSet>
 #include <QString>
+#include <QVector>
 
 #include "base/bittorrent/infohash.h"
 
@@ -67,6 +68,7 @@ public:
     static const std::optional<QString> AnyCategory;
     static const std::optional<TorrentIDSet> AnyID;
     static const std::optional<QString> AnyTag;
+    static const std::optional<QString> AnyTracker;
 
     static const TorrentFilter DownloadingTorrent;
     static const TorrentFilter SeedingTorrent;
@@ -94,17 +96,24 @@ public:
     bool setTorrentIDSet(const std::optional<TorrentIDSet> &idSet);
     bool setCategory(const std::optional<QString> &category);
     bool setTag(const std::optional<QString> &tag);
+    // Tracker host: pass empty string for trackerless torrents.
+    bool setTrackerHost(const std::optional<QString> &trackerHost);
 
     bool match(const BitTorrent::Torrent *torrent) const;
+    // Only the torrents from the session index corresponding to
+    // the filter IDs, tracker host, tag, category or state (if any) are checked
+    QVector<BitTorrent::Torrent *> findMatchingTorrents() const;
 
 private:
     bool matchState(const BitTorrent::Torrent *torrent) const;
     bool matchHash(const BitTorrent::Torrent *torrent) const;
     bool matchCategory(const BitTorrent::Torrent *torrent) const;
     bool matchTag(const BitTorrent::Torrent *torrent) const;
+    bool matchTracker(const BitTorrent::Torrent *torrent) const;
 
     Type m_type {All};
     std::optional<QString> m_category;
     std::optional<QString> m_tag;
+    std::optional<QString> m_trackerHost;
     std::optional<TorrentIDSet> m_idSet;
 };
@@ -45,6 +45,9 @@ namespace Utils::Compare
     class NaturalCompare
     {
     public:
+        // Precomputed collation key, comparing keys is much cheaper than comparing strings
+        using SortKey = QCollatorSortKey;
+
         NaturalCompare()
         {
             m_collator.setNumericMode(true);
@@ -56,6 +59,16 @@ namespace Utils::Compare
             return m_collator.compare(left, right);
         }
 
+        int operator()(const SortKey &left, const SortKey &right) const
+        {
+            return left.compare(right);
+        }
+
+        SortKey sortKey(const QString &str) const
+        {
+            return m_collator.sortKey(str);
+        }
+
     private:
         QCollator m_collator;
     };
@@ -66,10 +79,18 @@ namespace Utils::Compare
     class NaturalCompare
     {
     public:
+        // No collation keys are available here so the string itself serves as a key
+        using SortKey = QString;
+
         int operator()(const QString &left, const QString &right) const
         {
             return naturalCompare(left, right, caseSensitivity);
         }
+
+        SortKey sortKey(const QString &str) const
+        {
+            return str;
+        }
     };
 #endif
 
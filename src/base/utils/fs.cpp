@@ -40,6 +40,16 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#if !defined(Q_OS_WIN)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
 #if defined(Q_OS_WIN)
 #include <Windows.h>
 #elif defined(Q_OS_MACOS) || defined(Q_OS_FREEBSD) || defined(Q_OS_OPENBSD)
@@ -64,6 +74,18 @@
 #include "base/global.h"
 #include "base/path.h"
 
+namespace
+{
+    // Returns the path itself or its closest ancestor that exists, if any
+    Path existingAncestor(const Path &path)
+    {
+        Path existingPath = path;
+        while (!existingPath.isEmpty() && !existingPath.exists())
+            existingPath = existingPath.parentPath();
+        return existingPath;
+    }
+}
+
 /**
  * This function will first check if there are only system cache files, e.g. `Thumbs.db`,
  * `.DS_Store` and/or only temp files that end with '~', e.g. `filename~`.
@@ -214,6 +236,24 @@ qint64 Utils::Fs::freeDiskSpaceOnPath(const Path &path)
     return QStorageInfo(path.data()).bytesAvailable();
 }
 
+QByteArray Utils::Fs::storageDevice(const Path &path)
+{
+    const Path existingPath = existingAncestor(path);
+    if (existingPath.isEmpty())
+        return {};
+
+    return QStorageInfo(existingPath.data()).device();
+}
+
+Path Utils::Fs::mountPoint(const Path &path)
+{
+    const Path existingPath = existingAncestor(path);
+    if (existingPath.isEmpty())
+        return {};
+
+    return Path(QStorageInfo(existingPath.data()).rootPath());
+}
+
 Path Utils::Fs::tempPath()
 {
     static const Path path = Path(QDir::tempPath()) / Path(u".qBittorrent"_s);
@@ -301,6 +341,95 @@ bool Utils::Fs::copyFile(const Path &from, const Path &to)
     return QFile::copy(from.data(), to.data());
 }
 
+Utils::Fs::CloneMethod Utils::Fs::cloneFile(const Path &from, const Path &to)
+{
+#if defined(Q_OS_LINUX)
+    if (!mkpath(to.parentPath()))
+        return CloneMethod::None;
+
+    const int sourceFD = ::open(from.toString().toLocal8Bit().constData(), (O_RDONLY | O_CLOEXEC));
+    if (sourceFD < 0)
+        return CloneMethod::None;
+
+    struct stat sourceStat {};
+    if (::fstat(sourceFD, &sourceStat) != 0)
+    {
+        ::close(sourceFD);
+        return CloneMethod::None;
+    }
+
+    const QByteArray targetPath = to.toString().toLocal8Bit();
+    const int targetFD = ::open(targetPath.constData(), (O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC), (sourceStat.st_mode & 07777));
+    if (targetFD < 0)
+    {
+        ::close(sourceFD);
+        return CloneMethod::None;
+    }
+
+    CloneMethod method = CloneMethod::None;
+    if (::ioctl(targetFD, FICLONE, sourceFD) == 0)
+    {
+        method = CloneMethod::Reflink;
+    }
+    else
+    {
+        off_t remaining = sourceStat.st_size;
+        while (remaining > 0)
+        {
+            const ssize_t copied = ::copy_file_range(sourceFD, nullptr, targetFD, nullptr, remaining, 0);
+            if (copied > 0)
+                remaining -= copied;
+            else if ((copied == 0) || (errno != EINTR))
+                break;
+        }
+
+        if (remaining == 0)
+            method = CloneMethod::CopyFileRange;
+    }
+
+    if (method != CloneMethod::None)
+    {
+        const timespec times[] {sourceStat.st_atim, sourceStat.st_mtim};
+        ::futimens(targetFD, times);
+    }
+
+    ::close(targetFD);
+    ::close(sourceFD);
+
+    if (method == CloneMethod::None)
+        ::unlink(targetPath.constData());
+
+    return method;
+#else
+    Q_UNUSED(from);
+    Q_UNUSED(to);
+    return CloneMethod::None;
+#endif
+}
+
+bool Utils::Fs::syncFile(const Path &path)
+{
+#if defined(Q_OS_WIN)
+    const std::wstring pathW = path.toString().toStdWString();
+    const HANDLE handle = ::CreateFileW(pathW.c_str(), GENERIC_WRITE, (FILE_SHARE_READ | FILE_SHARE_WRITE)
+        , nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    const bool isSynced = ::FlushFileBuffers(handle);
+    ::CloseHandle(handle);
+    return isSynced;
+#else
+    const int fd = ::open(path.toString().toLocal8Bit().constData(), (O_RDONLY | O_CLOEXEC));
+    if (fd < 0)
+        return false;
+
+    const bool isSynced = (::fsync(fd) == 0);
+    ::close(fd);
+    return isSynced;
+#endif
+}
+
 bool Utils::Fs::renameFile(const Path &from, const Path &to)
 {
     return QFile::rename(from.data(), to.data());
@@ -44,6 +44,10 @@ namespace Utils::Fs
 {
     qint64 computePathSize(const Path &path);
     qint64 freeDiskSpaceOnPath(const Path &path);
+    // Returns the device of the filesystem the path belongs to (or would belong to, if it doesn't exist yet)
+    QByteArray storageDevice(const Path &path);
+    // Returns the mount point of the filesystem the path belongs to (or would belong to, if it doesn't exist yet)
+    Path mountPoint(const Path &path);
 
     bool isRegularFile(const Path &path);
     bool isDir(const Path &path);
@@ -57,7 +61,20 @@ namespace Utils::Fs
     Path toValidPath(const QString &name, const QString &pad = u" "_s);
     Path toCanonicalPath(const Path &path);
 
+    enum class CloneMethod
+    {
+        None,
+        Reflink,
+        CopyFileRange
+    };
+
     bool copyFile(const Path &from, const Path &to);
+    // Creates a copy of the file without passing its data through user space. It is done using
+    // reflinks (so both files share the same data blocks) or copy_file_range() where available.
+    // Returns the method that succeeded, or None if the file should be copied in the usual way.
+    CloneMethod cloneFile(const Path &from, const Path &to);
+    // Makes sure that the data of the file is physically written to the storage device
+    bool syncFile(const Path &path);
     bool renameFile(const Path &from, const Path &to);
     bool removeFile(const Path &path);
     bool mkdir(const Path &dirPath);
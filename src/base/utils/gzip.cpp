@@ -33,6 +33,7 @@
 
 #include <QtAssert>
 #include <QByteArray>
+#include <QIODevice>
 
 #ifndef ZLIB_CONST
 #define ZLIB_CONST  // make z_stream.next_in const
@@ -79,6 +80,59 @@ QByteArray Utils::Gzip::compress(const QByteArray &data, const int level, bool *
     return ret;
 }
 
+bool Utils::Gzip::compress(QIODevice &source, QIODevice &target, const int level)
+{
+    const int CHUNK_SIZE = 64 * 1024;
+
+    z_stream strm {};
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    const int initResult = deflateInit2(&strm, level, Z_DEFLATED, (15 + 16), 9, Z_DEFAULT_STRATEGY);
+    if (initResult != Z_OK)
+        return false;
+
+    std::vector<char> inBuf(CHUNK_SIZE);
+    std::vector<char> outBuf(CHUNK_SIZE);
+    bool isOK = true;
+    int flush = Z_NO_FLUSH;
+    do
+    {
+        const qint64 bytesRead = source.read(inBuf.data(), CHUNK_SIZE);
+        if (bytesRead < 0)
+        {
+            isOK = false;
+            break;
+        }
+
+        // the device may return less data than requested even before its end
+        flush = source.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+        strm.next_in = reinterpret_cast<const Bytef *>(inBuf.data());
+        strm.avail_in = static_cast<uInt>(bytesRead);
+
+        // run deflate until all the input is consumed, i.e. the output buffer isn't filled up
+        do
+        {
+            strm.next_out = reinterpret_cast<Bytef *>(outBuf.data());
+            strm.avail_out = CHUNK_SIZE;
+
+            const int deflateResult = deflate(&strm, flush);
+            Q_ASSERT(deflateResult != Z_STREAM_ERROR);
+
+            const qint64 outSize = CHUNK_SIZE - strm.avail_out;
+            if (target.write(outBuf.data(), outSize) != outSize)
+            {
+                isOK = false;
+                break;
+            }
+        } while (strm.avail_out == 0);
+    } while (isOK && (flush != Z_FINISH));
+
+    deflateEnd(&strm);
+    return isOK;
+}
+
 QByteArray Utils::Gzip::decompress(const QByteArray &data, bool *ok)
 {
     if (ok) *ok = false;
@@ -30,9 +30,12 @@
 #pragma once
 
 class QByteArray;
+class QIODevice;
 
 namespace Utils::Gzip
 {
     QByteArray compress(const QByteArray &data, int level = 6, bool *ok = nullptr);
+    // Compresses the data read from "source" until its end and writes the result to "target" chunk by chunk
+    bool compress(QIODevice &source, QIODevice &target, int level = 6);
     QByteArray decompress(const QByteArray &data, bool *ok = nullptr);
 }
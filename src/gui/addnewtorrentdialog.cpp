@@ -229,6 +229,11 @@ public:
         return QVector<qreal>(filesCount(), 0);
     }
 
+    void fetchFilesProgress(std::function<void (QVector<qreal>)> resultHandler) const override
+    {
+        resultHandler(filesProgress());
+    }
+
     QVector<qreal> availableFileFractions() const override
     {
         return QVector<qreal>(filesCount(), 0);
@@ -29,6 +29,8 @@
 
 #include "logmodel.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QDateTime>
 #include <QColor>
@@ -71,16 +73,20 @@ namespace
     }
 }
 
-BaseLogModel::Message::Message(const QString &time, const QString &message, const QColor &foreground, const Log::MsgType type)
-    : m_time(time)
+BaseLogModel::Message::Message(const qint64 timestamp, const QString &message, const QColor &foreground, const Log::MsgType type)
+    : m_timestamp(timestamp)
     , m_message(message)
     , m_foreground(foreground)
     , m_type(type)
 {
 }
 
+// Time is formatted on demand since only the visible messages are usually requested,
+// but then it is kept since the same rows are requested again each time the view is repainted
 QVariant BaseLogModel::Message::time() const
 {
+    if (m_time.isEmpty())
+        m_time = QLocale::system().toString(QDateTime::fromSecsSinceEpoch(m_timestamp), QLocale::ShortFormat);
     return m_time;
 }
 
@@ -143,20 +149,27 @@ QVariant BaseLogModel::data(const QModelIndex &index, const int role) const
     }
 }
 
-void BaseLogModel::addNewMessage(const BaseLogModel::Message &message)
+void BaseLogModel::addNewMessages(const QList<Message> &messages)
 {
-    // if row is inserted on filled up buffer, the size will not change
+    // newest messages are shown on top, so only the newest ones are added if there are too many
+    const int count = std::min(static_cast<int>(messages.size()), MAX_VISIBLE_MESSAGES);
+    if (count == 0)
+        return;
+
+    // if rows are inserted on filled up buffer, the size will not change
     // but because of calling of beginInsertRows function we'll have ghost rows.
-    if (m_messages.size() == MAX_VISIBLE_MESSAGES)
+    const int size = static_cast<int>(m_messages.size());
+    const int overflow = size + count - MAX_VISIBLE_MESSAGES;
+    if (overflow > 0)
     {
-        const int lastMessage = static_cast<int>(m_messages.size()) - 1;
-        beginRemoveRows(QModelIndex(), lastMessage, lastMessage);
-        m_messages.pop_back();
+        beginRemoveRows(QModelIndex(), (size - overflow), (size - 1));
+        m_messages.erase_end(overflow);
         endRemoveRows();
     }
 
-    beginInsertRows(QModelIndex(), 0, 0);
-    m_messages.push_front(message);
+    beginInsertRows(QModelIndex(), 0, (count - 1));
+    for (auto it = (messages.cend() - count); it != messages.cend(); ++it)
+        m_messages.push_front(*it);
     endInsertRows();
 }
 
@@ -177,35 +190,51 @@ LogMessageModel::LogMessageModel(QObject *parent)
         {Log::CRITICAL, getLogCriticalColor()}
     }
 {
-    for (const Log::Msg &msg : asConst(Logger::instance()->getMessages()))
-        handleNewMessage(msg);
-    connect(Logger::instance(), &Logger::newLogMessage, this, &LogMessageModel::handleNewMessage);
+    handleNewMessages();
+    connect(Logger::instance(), &Logger::newLogMessages, this, &LogMessageModel::handleNewMessages);
 }
 
-void LogMessageModel::handleNewMessage(const Log::Msg &message)
+void LogMessageModel::handleNewMessages()
 {
-    const QString time = QLocale::system().toString(QDateTime::fromSecsSinceEpoch(message.timestamp), QLocale::ShortFormat);
-    const QString messageText = message.message;
-    const QColor foreground = m_foregroundForMessageTypes[message.type];
+    const QVector<Log::Msg> newMessages = Logger::instance()->getMessages(m_lastMessageId);
+    if (newMessages.isEmpty())
+        return;
+
+    m_lastMessageId = newMessages.last().id;
+
+    QList<Message> messages;
+    messages.reserve(newMessages.size());
+    for (const Log::Msg &msg : newMessages)
+        messages.append({msg.timestamp, msg.message, m_foregroundForMessageTypes[msg.type], msg.type});
 
-    addNewMessage({time, messageText, foreground, message.type});
+    addNewMessages(messages);
 }
 
 LogPeerModel::LogPeerModel(QObject *parent)
     : BaseLogModel(parent)
     , m_bannedPeerForeground(getPeerBannedColor())
 {
-    for (const Log::Peer &peer : asConst(Logger::instance()->getPeers()))
-        handleNewMessage(peer);
-    connect(Logger::instance(), &Logger::newLogPeer, this, &LogPeerModel::handleNewMessage);
+    handleNewPeers();
+    connect(Logger::instance(), &Logger::newLogPeers, this, &LogPeerModel::handleNewPeers);
 }
 
-void LogPeerModel::handleNewMessage(const Log::Peer &peer)
+void LogPeerModel::handleNewPeers()
 {
-    const QString time = QLocale::system().toString(QDateTime::fromSecsSinceEpoch(peer.timestamp), QLocale::ShortFormat);
-    const QString message = peer.blocked
-            ? tr("%1 was blocked. Reason: %2.", "0.0.0.0 was blocked. Reason: reason for blocking.").arg(peer.ip, peer.reason)
-            : tr("%1 was banned", "0.0.0.0 was banned").arg(peer.ip);
+    const QVector<Log::Peer> newPeers = Logger::instance()->getPeers(m_lastPeerId);
+    if (newPeers.isEmpty())
+        return;
+
+    m_lastPeerId = newPeers.last().id;
+
+    QList<Message> messages;
+    messages.reserve(newPeers.size());
+    for (const Log::Peer &peer : newPeers)
+    {
+        const QString message = peer.blocked
+                ? tr("%1 was blocked. Reason: %2.", "0.0.0.0 was blocked. Reason: reason for blocking.").arg(peer.ip, peer.reason)
+                : tr("%1 was banned", "0.0.0.0 was banned").arg(peer.ip);
+        messages.append({peer.timestamp, message, m_bannedPeerForeground, Log::NORMAL});
+    }
 
-    addNewMessage({time, message, m_bannedPeerForeground, Log::NORMAL});
+    addNewMessages(messages);
 }
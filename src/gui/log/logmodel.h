@@ -34,6 +34,7 @@
 #include <QAbstractListModel>
 #include <QColor>
 #include <QHash>
+#include <QList>
 
 #include "base/logger.h"
 
@@ -62,7 +63,7 @@ protected:
     class Message
     {
     public:
-        Message(const QString &time, const QString &message, const QColor &foreground, Log::MsgType type);
+        Message(qint64 timestamp, const QString &message, const QColor &foreground, Log::MsgType type);
 
         QVariant time() const;
         QVariant message() const;
@@ -70,13 +71,14 @@ protected:
         QVariant type() const;
 
     private:
-        QVariant m_time;
-        QVariant m_message;
-        QVariant m_foreground;
-        QVariant m_type;
+        qint64 m_timestamp = 0;
+        mutable QString m_time;
+        QString m_message;
+        QColor m_foreground;
+        Log::MsgType m_type = Log::NORMAL;
     };
 
-    void addNewMessage(const Message &message);
+    void addNewMessages(const QList<Message> &messages);
 
 private:
     boost::circular_buffer_space_optimized<Message> m_messages;
@@ -92,10 +94,11 @@ public:
     explicit LogMessageModel(QObject *parent = nullptr);
 
 private slots:
-    void handleNewMessage(const Log::Msg &message);
+    void handleNewMessages();
 
 private:
     const QHash<int, QColor> m_foregroundForMessageTypes;
+    int m_lastMessageId = -1;
 };
 
 class LogPeerModel : public BaseLogModel
@@ -107,8 +110,9 @@ public:
     explicit LogPeerModel(QObject *parent = nullptr);
 
 private slots:
-    void handleNewMessage(const Log::Peer &peer);
+    void handleNewPeers();
 
 private:
     const QColor m_bannedPeerForeground;
+    int m_lastPeerId = -1;
 };
@@ -30,6 +30,7 @@
 #include "peerlistwidget.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <QApplication>
 #include <QClipboard>
@@ -42,6 +43,7 @@
 #include <QShortcut>
 #include <QSortFilterProxyModel>
 #include <QStandardItemModel>
+#include <QThreadPool>
 #include <QVector>
 #include <QWheelEvent>
 
@@ -88,8 +90,33 @@ namespace
 
         model->setItemData(model->index(row, column), data);
     }
+
+    std::bitset<PeerListWidget::COL_COUNT> changedColumns(const BitTorrent::PeerInfo &oldPeer, const BitTorrent::PeerInfo &newPeer)
+    {
+        std::bitset<PeerListWidget::COL_COUNT> columns;
+        columns[PeerListWidget::FLAGS] = (newPeer.flags() != oldPeer.flags());
+        columns[PeerListWidget::CLIENT] = (newPeer.client() != oldPeer.client());
+        columns[PeerListWidget::PEERID_CLIENT] = (newPeer.peerIdClient() != oldPeer.peerIdClient());
+        columns[PeerListWidget::PROGRESS] = (newPeer.progress() != oldPeer.progress());
+        columns[PeerListWidget::DOWN_SPEED] = (newPeer.payloadDownSpeed() != oldPeer.payloadDownSpeed());
+        columns[PeerListWidget::UP_SPEED] = (newPeer.payloadUpSpeed() != oldPeer.payloadUpSpeed());
+        columns[PeerListWidget::TOT_DOWN] = (newPeer.totalDownload() != oldPeer.totalDownload());
+        columns[PeerListWidget::TOT_UP] = (newPeer.totalUpload() != oldPeer.totalUpload());
+        columns[PeerListWidget::RELEVANCE] = (newPeer.relevance() != oldPeer.relevance());
+        columns[PeerListWidget::DOWNLOADING_PIECE] = (newPeer.downloadingPieceIndex() != oldPeer.downloadingPieceIndex());
+        return columns;
+    }
 }
 
+struct PeerListWidget::PeerListUpdate
+{
+    QHash<PeerEndpoint, BitTorrent::PeerInfo> peers;
+    QVector<std::pair<PeerEndpoint, ColumnSet>> changedPeers;  // new peers have all the columns changed
+    QVector<PeerEndpoint> removedPeers;
+    QVector<BitTorrent::PeerInfo> I2PPeers;
+    bool hideZeroValues = false;
+};
+
 PeerListWidget::PeerListWidget(PropertiesWidget *parent)
     : QTreeView(parent)
     , m_properties(parent)
@@ -248,7 +275,9 @@ void PeerListWidget::updatePeerHostNameResolutionState()
         {
             m_resolver = new Net::ReverseResolution(this);
             connect(m_resolver, &Net::ReverseResolution::ipResolved, this, &PeerListWidget::handleResolved);
-            loadPeers(m_properties->getCurrentTorrent());
+            // host names are resolved once per IP when peers are added
+            for (auto iter = m_itemsByIP.cbegin(); iter != m_itemsByIP.cend(); ++iter)
+                m_resolver->resolve(iter.key());
         }
     }
     else
@@ -267,7 +296,13 @@ void PeerListWidget::updatePeerCountryResolutionState()
     m_resolveCountries = resolveCountries;
     if (m_resolveCountries)
     {
-        loadPeers(m_properties->getCurrentTorrent());
+        // countries are resolved once when peers are added
+        for (auto iter = m_itemsByIP.cbegin(); iter != m_itemsByIP.cend(); ++iter)
+        {
+            for (const QStandardItem *item : iter.value())
+                setPeerCountry(item->row(), iter.key());
+        }
+
         showColumn(PeerListColumns::COUNTRY);
         if (columnWidth(PeerListColumns::COUNTRY) <= 0)
             resizeColumnToContents(PeerListColumns::COUNTRY);
@@ -384,6 +419,8 @@ void PeerListWidget::clear()
     m_peerItems.clear();
     m_I2PPeerItems.clear();
     m_itemsByIP.clear();
+    m_peers.clear();
+    ++m_peersRevision;
     const int nbrows = m_listModel->rowCount();
     if (nbrows > 0)
         m_listModel->removeRows(0, nbrows);
@@ -410,128 +447,222 @@ void PeerListWidget::loadPeers(const BitTorrent::Torrent *torrent)
         if (torrent != m_properties->getCurrentTorrent())
             return;
 
-        // Remove I2P peers since they will be completely reloaded.
-        for (QStandardItem *item : asConst(m_I2PPeerItems))
-            m_listModel->removeRow(item->row());
-        m_I2PPeerItems.clear();
-
-        QSet<PeerEndpoint> existingPeers;
-        existingPeers.reserve(m_peerItems.size());
-        for (auto i = m_peerItems.cbegin(); i != m_peerItems.cend(); ++i)
-            existingPeers.insert(i.key());
-
         const bool hideZeroValues = Preferences::instance()->getHideZeroValues();
-        for (const BitTorrent::PeerInfo &peer : peers)
+        const bool forceUpdate = (hideZeroValues != m_hideZeroValues);
+
+        // Comparing a lot of peers shouldn't block GUI thread,
+        // so it is done in worker thread and only the changes are applied
+        QThreadPool::globalInstance()->start([widget = QPointer<PeerListWidget>(this), torrent, revision = m_peersRevision
+                , previousPeers = m_peers, peers, hideZeroValues, forceUpdate]
         {
-            const PeerEndpoint peerEndpoint {peer.address(), peer.connectionType()};
+            PeerListUpdate update = makePeerListUpdate(previousPeers, peers, forceUpdate);
+            update.hideZeroValues = hideZeroValues;
 
-            auto itemIter = m_peerItems.find(peerEndpoint);
-            const bool isNewPeer = (itemIter == m_peerItems.end());
-            const int row = isNewPeer ? m_listModel->rowCount() : (*itemIter)->row();
-            if (isNewPeer)
-            {
-                m_listModel->insertRow(row);
-
-                const bool useI2PSocket = peer.useI2PSocket();
-
-                const QString peerIPString = useI2PSocket ? peer.I2PAddress() : peerEndpoint.address.ip.toString();
-                setModelData(m_listModel, row, PeerListColumns::IP, peerIPString, peerIPString, {}, peerIPString);
-
-                const QString peerIPHiddenString = useI2PSocket ? QString() : peerEndpoint.address.ip.toString();
-                setModelData(m_listModel, row, PeerListColumns::IP_HIDDEN, peerIPHiddenString, peerIPHiddenString);
-
-                const QString peerPortString = useI2PSocket ? tr("N/A") : QString::number(peer.address().port);
-                setModelData(m_listModel, row, PeerListColumns::PORT, peerPortString, peer.address().port, (Qt::AlignRight | Qt::AlignVCenter));
-
-                if (useI2PSocket)
-                {
-                    m_I2PPeerItems.append(m_listModel->item(row, PeerListColumns::IP));
-                }
-                else
-                {
-                    itemIter = m_peerItems.insert(peerEndpoint, m_listModel->item(row, PeerListColumns::IP));
-                    m_itemsByIP[peerEndpoint.address.ip].insert(itemIter.value());
-                }
-            }
-            else
+            QMetaObject::invokeMethod(qApp, [widget, torrent, revision, update = std::move(update)]
             {
-                existingPeers.remove(peerEndpoint);
-            }
+                if (!widget || (torrent != widget->m_properties->getCurrentTorrent()))
+                    return;
 
-            updatePeer(row, torrent, peer, hideZeroValues);
-        }
+                // the changes are outdated if peer list was modified in the meantime
+                if (revision != widget->m_peersRevision)
+                    return;
 
-        // Remove peers that are gone
-        for (const PeerEndpoint &peerEndpoint : asConst(existingPeers))
-        {
-            QStandardItem *item = m_peerItems.take(peerEndpoint);
+                widget->applyPeerListUpdate(torrent, update);
+            }, Qt::QueuedConnection);
+        });
+    });
+}
 
-            QSet<QStandardItem *> &items = m_itemsByIP[peerEndpoint.address.ip];
-            items.remove(item);
-            if (items.isEmpty())
-                m_itemsByIP.remove(peerEndpoint.address.ip);
+PeerListWidget::PeerListUpdate PeerListWidget::makePeerListUpdate(const QHash<PeerEndpoint, BitTorrent::PeerInfo> &previousPeers
+        , const QVector<BitTorrent::PeerInfo> &peers, const bool forceUpdate)
+{
+    PeerListUpdate update;
+    update.peers.reserve(peers.size());
 
-            m_listModel->removeRow(item->row());
+    for (const BitTorrent::PeerInfo &peer : peers)
+    {
+        // I2P peers cannot be distinguished by their endpoints so they are completely reloaded
+        if (peer.useI2PSocket())
+        {
+            update.I2PPeers.append(peer);
+            continue;
         }
-    });
+
+        const PeerEndpoint peerEndpoint {peer.address(), peer.connectionType()};
+        const auto previousPeerIter = previousPeers.constFind(peerEndpoint);
+        const ColumnSet columns = (forceUpdate || (previousPeerIter == previousPeers.cend()))
+                ? ColumnSet().set() : changedColumns(previousPeerIter.value(), peer);
+        if (columns.any())
+            update.changedPeers.append({peerEndpoint, columns});
+
+        update.peers.insert(peerEndpoint, peer);
+    }
+
+    for (auto iter = previousPeers.cbegin(); iter != previousPeers.cend(); ++iter)
+    {
+        if (!update.peers.contains(iter.key()))
+            update.removedPeers.append(iter.key());
+    }
+
+    return update;
 }
 
-void PeerListWidget::updatePeer(const int row, const BitTorrent::Torrent *torrent, const BitTorrent::PeerInfo &peer, const bool hideZeroValues)
+void PeerListWidget::applyPeerListUpdate(const BitTorrent::Torrent *torrent, const PeerListUpdate &update)
 {
-    const Qt::Alignment intDataTextAlignment = Qt::AlignRight | Qt::AlignVCenter;
+    ++m_peersRevision;
+    m_peers = update.peers;
+    m_hideZeroValues = update.hideZeroValues;
+
+    // Remove I2P peers since they will be completely reloaded.
+    for (QStandardItem *item : asConst(m_I2PPeerItems))
+        m_listModel->removeRow(item->row());
+    m_I2PPeerItems.clear();
+
+    // Remove peers that are gone
+    for (const PeerEndpoint &peerEndpoint : update.removedPeers)
+    {
+        QStandardItem *item = m_peerItems.take(peerEndpoint);
 
-    const QString client = peer.client().toHtmlEscaped();
-    setModelData(m_listModel, row, PeerListColumns::CLIENT, client, client, {}, client);
+        QSet<QStandardItem *> &items = m_itemsByIP[peerEndpoint.address.ip];
+        items.remove(item);
+        if (items.isEmpty())
+            m_itemsByIP.remove(peerEndpoint.address.ip);
+
+        m_listModel->removeRow(item->row());
+    }
+
+    for (const auto &[peerEndpoint, columns] : update.changedPeers)
+    {
+        const BitTorrent::PeerInfo &peer = update.peers.find(peerEndpoint).value();
+        if (const QStandardItem *item = m_peerItems.value(peerEndpoint))
+            updatePeer(item->row(), torrent, peer, update.hideZeroValues, columns);
+        else
+            addPeer(torrent, peerEndpoint, peer, update.hideZeroValues);
+    }
 
-    const QString peerIdClient = peer.peerIdClient().toHtmlEscaped();
-    setModelData(m_listModel, row, PeerListColumns::PEERID_CLIENT, peerIdClient, peerIdClient);
+    for (const BitTorrent::PeerInfo &peer : update.I2PPeers)
+        addPeer(torrent, {peer.address(), peer.connectionType()}, peer, update.hideZeroValues);
+}
 
-    const QString downSpeed = (hideZeroValues && (peer.payloadDownSpeed() <= 0))
-            ? QString() : Utils::Misc::friendlyUnit(peer.payloadDownSpeed(), true);
-    setModelData(m_listModel, row, PeerListColumns::DOWN_SPEED, downSpeed, peer.payloadDownSpeed(), intDataTextAlignment);
+void PeerListWidget::addPeer(const BitTorrent::Torrent *torrent, const PeerEndpoint &peerEndpoint, const BitTorrent::PeerInfo &peer, const bool hideZeroValues)
+{
+    const int row = m_listModel->rowCount();
+    m_listModel->insertRow(row);
 
-    const QString upSpeed = (hideZeroValues && (peer.payloadUpSpeed() <= 0))
-            ? QString() : Utils::Misc::friendlyUnit(peer.payloadUpSpeed(), true);
-    setModelData(m_listModel, row, PeerListColumns::UP_SPEED, upSpeed, peer.payloadUpSpeed(), intDataTextAlignment);
+    const bool useI2PSocket = peer.useI2PSocket();
 
-    const QString totalDown = (hideZeroValues && (peer.totalDownload() <= 0))
-            ? QString() : Utils::Misc::friendlyUnit(peer.totalDownload());
-    setModelData(m_listModel, row, PeerListColumns::TOT_DOWN, totalDown, peer.totalDownload(), intDataTextAlignment);
+    const QString peerIPString = useI2PSocket ? peer.I2PAddress() : peerEndpoint.address.ip.toString();
+    setModelData(m_listModel, row, PeerListColumns::IP, peerIPString, peerIPString, {}, peerIPString);
 
-    const QString totalUp = (hideZeroValues && (peer.totalUpload() <= 0))
-            ? QString() : Utils::Misc::friendlyUnit(peer.totalUpload());
-    setModelData(m_listModel, row, PeerListColumns::TOT_UP, totalUp, peer.totalUpload(), intDataTextAlignment);
+    const QString peerIPHiddenString = useI2PSocket ? QString() : peerEndpoint.address.ip.toString();
+    setModelData(m_listModel, row, PeerListColumns::IP_HIDDEN, peerIPHiddenString, peerIPHiddenString);
 
-    setModelData(m_listModel, row, PeerListColumns::CONNECTION, peer.connectionType(), peer.connectionType());
-    setModelData(m_listModel, row, PeerListColumns::FLAGS, peer.flags(), peer.flags(), {}, peer.flagsDescription());
-    setModelData(m_listModel, row, PeerListColumns::PROGRESS, (Utils::String::fromDouble(peer.progress() * 100, 1) + u'%')
-            , peer.progress(), intDataTextAlignment);
-    setModelData(m_listModel, row, PeerListColumns::RELEVANCE, (Utils::String::fromDouble(peer.relevance() * 100, 1) + u'%')
-            , peer.relevance(), intDataTextAlignment);
+    const QString peerPortString = useI2PSocket ? tr("N/A") : QString::number(peer.address().port);
+    setModelData(m_listModel, row, PeerListColumns::PORT, peerPortString, peer.address().port, (Qt::AlignRight | Qt::AlignVCenter));
 
-    const PathList filePaths = torrent->info().filesForPiece(peer.downloadingPieceIndex());
-    QStringList downloadingFiles;
-    downloadingFiles.reserve(filePaths.size());
-    for (const Path &filePath : filePaths)
-        downloadingFiles.append(filePath.toString());
+    updatePeer(row, torrent, peer, hideZeroValues, ColumnSet().set());
 
-    const QString downloadingFilesDisplayValue = downloadingFiles.join(u';');
-    setModelData(m_listModel, row, PeerListColumns::DOWNLOADING_PIECE, downloadingFilesDisplayValue
-            , downloadingFilesDisplayValue, {}, downloadingFiles.join(u'\n'));
+    if (useI2PSocket)
+    {
+        m_I2PPeerItems.append(m_listModel->item(row, PeerListColumns::IP));
+        return;
+    }
 
-    if (!peer.useI2PSocket() && m_resolver)
-        m_resolver->resolve(peer.address().ip);
+    QStandardItem *item = m_listModel->item(row, PeerListColumns::IP);
+    m_peerItems.insert(peerEndpoint, item);
+    m_itemsByIP[peerEndpoint.address.ip].insert(item);
 
+    // Country and host name don't change so they are resolved only once
     if (m_resolveCountries)
+        setPeerCountry(row, peerEndpoint.address.ip);
+    if (m_resolver)
+        m_resolver->resolve(peerEndpoint.address.ip);
+}
+
+void PeerListWidget::updatePeer(const int row, const BitTorrent::Torrent *torrent, const BitTorrent::PeerInfo &peer
+        , const bool hideZeroValues, const ColumnSet &columns)
+{
+    const Qt::Alignment intDataTextAlignment = Qt::AlignRight | Qt::AlignVCenter;
+
+    if (columns[PeerListColumns::CLIENT])
     {
-        const QIcon icon = UIThemeManager::instance()->getFlagIcon(peer.country());
-        if (!icon.isNull())
-        {
-            m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), icon, Qt::DecorationRole);
-            const QString countryName = Net::GeoIPManager::CountryName(peer.country());
-            m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), countryName, Qt::ToolTipRole);
-        }
+        const QString client = peer.client().toHtmlEscaped();
+        setModelData(m_listModel, row, PeerListColumns::CLIENT, client, client, {}, client);
+    }
+
+    if (columns[PeerListColumns::PEERID_CLIENT])
+    {
+        const QString peerIdClient = peer.peerIdClient().toHtmlEscaped();
+        setModelData(m_listModel, row, PeerListColumns::PEERID_CLIENT, peerIdClient, peerIdClient);
+    }
+
+    if (columns[PeerListColumns::DOWN_SPEED])
+    {
+        const QString downSpeed = (hideZeroValues && (peer.payloadDownSpeed() <= 0))
+                ? QString() : Utils::Misc::friendlyUnit(peer.payloadDownSpeed(), true);
+        setModelData(m_listModel, row, PeerListColumns::DOWN_SPEED, downSpeed, peer.payloadDownSpeed(), intDataTextAlignment);
+    }
+
+    if (columns[PeerListColumns::UP_SPEED])
+    {
+        const QString upSpeed = (hideZeroValues && (peer.payloadUpSpeed() <= 0))
+                ? QString() : Utils::Misc::friendlyUnit(peer.payloadUpSpeed(), true);
+        setModelData(m_listModel, row, PeerListColumns::UP_SPEED, upSpeed, peer.payloadUpSpeed(), intDataTextAlignment);
+    }
+
+    if (columns[PeerListColumns::TOT_DOWN])
+    {
+        const QString totalDown = (hideZeroValues && (peer.totalDownload() <= 0))
+                ? QString() : Utils::Misc::friendlyUnit(peer.totalDownload());
+        setModelData(m_listModel, row, PeerListColumns::TOT_DOWN, totalDown, peer.totalDownload(), intDataTextAlignment);
+    }
+
+    if (columns[PeerListColumns::TOT_UP])
+    {
+        const QString totalUp = (hideZeroValues && (peer.totalUpload() <= 0))
+                ? QString() : Utils::Misc::friendlyUnit(peer.totalUpload());
+        setModelData(m_listModel, row, PeerListColumns::TOT_UP, totalUp, peer.totalUpload(), intDataTextAlignment);
+    }
+
+    if (columns[PeerListColumns::CONNECTION])
+        setModelData(m_listModel, row, PeerListColumns::CONNECTION, peer.connectionType(), peer.connectionType());
+    if (columns[PeerListColumns::FLAGS])
+        setModelData(m_listModel, row, PeerListColumns::FLAGS, peer.flags(), peer.flags(), {}, peer.flagsDescription());
+    if (columns[PeerListColumns::PROGRESS])
+    {
+        setModelData(m_listModel, row, PeerListColumns::PROGRESS, (Utils::String::fromDouble(peer.progress() * 100, 1) + u'%')
+                , peer.progress(), intDataTextAlignment);
     }
+    if (columns[PeerListColumns::RELEVANCE])
+    {
+        setModelData(m_listModel, row, PeerListColumns::RELEVANCE, (Utils::String::fromDouble(peer.relevance() * 100, 1) + u'%')
+                , peer.relevance(), intDataTextAlignment);
+    }
+
+    if (columns[PeerListColumns::DOWNLOADING_PIECE])
+    {
+        const PathList filePaths = torrent->info().filesForPiece(peer.downloadingPieceIndex());
+        QStringList downloadingFiles;
+        downloadingFiles.reserve(filePaths.size());
+        for (const Path &filePath : filePaths)
+            downloadingFiles.append(filePath.toString());
+
+        const QString downloadingFilesDisplayValue = downloadingFiles.join(u';');
+        setModelData(m_listModel, row, PeerListColumns::DOWNLOADING_PIECE, downloadingFilesDisplayValue
+                , downloadingFilesDisplayValue, {}, downloadingFiles.join(u'\n'));
+    }
+}
+
+void PeerListWidget::setPeerCountry(const int row, const QHostAddress &ip)
+{
+    const QString country = Net::GeoIPManager::instance()->lookup(ip);
+    const QIcon icon = UIThemeManager::instance()->getFlagIcon(country);
+    if (icon.isNull())
+        return;
+
+    m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), icon, Qt::DecorationRole);
+    const QString countryName = Net::GeoIPManager::CountryName(country);
+    m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), countryName, Qt::ToolTipRole);
 }
 
 int PeerListWidget::visibleColumnsCount() const
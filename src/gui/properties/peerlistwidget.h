@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <bitset>
+
 #include <QHash>
 #include <QSet>
 #include <QTreeView>
+#include <QVector>
 
 class QHostAddress;
 class QStandardItem;
@@ -98,7 +101,15 @@ private slots:
     void handleResolved(const QHostAddress &ip, const QString &hostname) const;
 
 private:
-    void updatePeer(int row, const BitTorrent::Torrent *torrent, const BitTorrent::PeerInfo &peer, bool hideZeroValues);
+    using ColumnSet = std::bitset<COL_COUNT>;
+    struct PeerListUpdate;
+
+    static PeerListUpdate makePeerListUpdate(const QHash<PeerEndpoint, BitTorrent::PeerInfo> &previousPeers
+            , const QVector<BitTorrent::PeerInfo> &peers, bool forceUpdate);
+    void applyPeerListUpdate(const BitTorrent::Torrent *torrent, const PeerListUpdate &update);
+    void addPeer(const BitTorrent::Torrent *torrent, const PeerEndpoint &peerEndpoint, const BitTorrent::PeerInfo &peer, bool hideZeroValues);
+    void updatePeer(int row, const BitTorrent::Torrent *torrent, const BitTorrent::PeerInfo &peer, bool hideZeroValues, const ColumnSet &columns);
+    void setPeerCountry(int row, const QHostAddress &ip);
     int visibleColumnsCount() const;
 
     void wheelEvent(QWheelEvent *event) override;
@@ -110,5 +121,8 @@ private:
     QHash<PeerEndpoint, QStandardItem *> m_peerItems;
     QList<QStandardItem *> m_I2PPeerItems;
     QHash<QHostAddress, QSet<QStandardItem *>> m_itemsByIP;  // must be kept in sync with `m_peerItems`
+    QHash<PeerEndpoint, BitTorrent::PeerInfo> m_peers;  // last applied peers, new ones are compared against them
+    quint64 m_peersRevision = 0;
+    bool m_hideZeroValues = false;
     bool m_resolveCountries;
 };
@@ -608,9 +608,9 @@ void AutomatedRssDownloader::updateMatchingArticles()
             if (!feed) continue; // feed doesn't exist
 
             QStringList matchingArticles;
-            for (const auto *article : asConst(feed->articles()))
-                if (rule.matches(article->data()))
-                    matchingArticles << article->title();
+            const QList<RSS::Article *> articles = rule.findMatchingArticles(feed);
+            for (const auto *article : articles)
+                matchingArticles << article->title();
             if (!matchingArticles.isEmpty())
                 addFeedArticlesToTree(feed, matchingArticles);
         }
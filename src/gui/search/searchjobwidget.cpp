@@ -517,20 +517,18 @@ void SearchJobWidget::appendSearchResults(const QVector<SearchResult> &results)
 {
     for (const SearchResult &result : results)
     {
-        // Add item to search result list
-        int row = m_searchListModel->rowCount();
-        m_searchListModel->insertRow(row);
+        // The row is filled before it is added, so the proxy model sorts and filters
+        // it only once instead of doing it on every change of its data
+        QList<QStandardItem *> row;
+        row.resize(SearchSortModel::NB_SEARCH_COLUMNS);
 
-        const auto setModelData = [this, row] (const int column, const QString &displayData
-                                               , const QVariant &underlyingData, const Qt::Alignment textAlignmentData = {})
+        const auto setModelData = [&row] (const int column, const QString &displayData
+                                          , const QVariant &underlyingData, const Qt::Alignment textAlignmentData = {})
         {
-            const QMap<int, QVariant> data =
-            {
-                {Qt::DisplayRole, displayData},
-                {SearchSortModel::UnderlyingDataRole, underlyingData},
-                {Qt::TextAlignmentRole, QVariant {textAlignmentData}}
-            };
-            m_searchListModel->setItemData(m_searchListModel->index(row, column), data);
+            auto *item = new QStandardItem(displayData);
+            item->setData(underlyingData, SearchSortModel::UnderlyingDataRole);
+            item->setData(QVariant {textAlignmentData}, Qt::TextAlignmentRole);
+            row[column] = item;
         };
 
         setModelData(SearchSortModel::NAME, result.fileName, result.fileName);
@@ -540,6 +538,9 @@ void SearchJobWidget::appendSearchResults(const QVector<SearchResult> &results)
         setModelData(SearchSortModel::SIZE, Utils::Misc::friendlyUnit(result.fileSize), result.fileSize, (Qt::AlignRight | Qt::AlignVCenter));
         setModelData(SearchSortModel::SEEDS, QString::number(result.nbSeeders), result.nbSeeders, (Qt::AlignRight | Qt::AlignVCenter));
         setModelData(SearchSortModel::LEECHES, QString::number(result.nbLeechers), result.nbLeechers, (Qt::AlignRight | Qt::AlignVCenter));
+
+        // Add item to search result list
+        m_searchListModel->appendRow(row);
     }
 
     updateResultsCount();
@@ -31,6 +31,7 @@
 #include <algorithm>
 
 #include "base/bittorrent/cachestatus.h"
+#include "base/bittorrent/diskiostatus.h"
 #include "base/bittorrent/session.h"
 #include "base/bittorrent/sessionstatus.h"
 #include "base/bittorrent/torrent.h"
@@ -42,6 +43,36 @@
 
 #define SETTINGS_KEY(name) u"StatisticsDialog/" name
 
+namespace
+{
+    const int MAX_DISK_IO_TORRENTS = 10;
+
+    enum DiskIOColumn
+    {
+        DISK_IO_NAME,
+        DISK_IO_READ,
+        DISK_IO_WRITTEN,
+        DISK_IO_READ_LATENCY,
+        DISK_IO_WRITE_LATENCY
+    };
+
+    QString latencyString(const qint64 microseconds)
+    {
+        if (microseconds < 1000)
+            return StatsDialog::tr("%1 µs", "18 microseconds").arg(microseconds);
+        return StatsDialog::tr("%1 ms", "18 milliseconds").arg(microseconds / 1000);
+    }
+
+    QString latencyPercentilesString(const BitTorrent::LatencyHistogram &histogram)
+    {
+        if (BitTorrent::latencyPercentile(histogram, 100) == 0)
+            return u"-"_s;
+
+        return u"%1 / %2"_s.arg(latencyString(BitTorrent::latencyPercentile(histogram, 50))
+                , latencyString(BitTorrent::latencyPercentile(histogram, 99)));
+    }
+}
+
 StatsDialog::StatsDialog(QWidget *parent)
     : QDialog(parent)
     , m_ui(new Ui::StatsDialog)
@@ -114,4 +145,52 @@ void StatsDialog::update()
 
     // Total connected peers
     m_ui->labelPeers->setText(QString::number(ss.peersCount));
+
+    updateDiskIOStats();
+}
+
+void StatsDialog::updateDiskIOStats()
+{
+    struct TorrentDiskIO
+    {
+        const BitTorrent::Torrent *torrent = nullptr;
+        BitTorrent::DiskIOStatus status;
+    };
+
+    QList<TorrentDiskIO> torrentsDiskIO;
+    for (const BitTorrent::Torrent *torrent : asConst(BitTorrent::Session::instance()->torrents()))
+    {
+        const BitTorrent::DiskIOStatus status = torrent->diskIOStatus();
+        if ((status.bytesRead > 0) || (status.bytesWritten > 0))
+            torrentsDiskIO.append({torrent, status});
+    }
+
+    const int count = std::min<int>(torrentsDiskIO.size(), MAX_DISK_IO_TORRENTS);
+    std::partial_sort(torrentsDiskIO.begin(), (torrentsDiskIO.begin() + count), torrentsDiskIO.end()
+            , [](const TorrentDiskIO &left, const TorrentDiskIO &right)
+    {
+        return (left.status.bytesRead + left.status.bytesWritten) > (right.status.bytesRead + right.status.bytesWritten);
+    });
+
+    // existing items are reused to keep the selection
+    QTreeWidget *tree = m_ui->treeDiskIO;
+    while (tree->topLevelItemCount() > count)
+        delete tree->takeTopLevelItem(tree->topLevelItemCount() - 1);
+    while (tree->topLevelItemCount() < count)
+    {
+        auto *item = new QTreeWidgetItem(tree);
+        for (const int column : {DISK_IO_READ, DISK_IO_WRITTEN, DISK_IO_READ_LATENCY, DISK_IO_WRITE_LATENCY})
+            item->setTextAlignment(column, (Qt::AlignRight | Qt::AlignVCenter));
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const TorrentDiskIO &torrentDiskIO = torrentsDiskIO[i];
+        QTreeWidgetItem *item = tree->topLevelItem(i);
+        item->setText(DISK_IO_NAME, torrentDiskIO.torrent->name());
+        item->setText(DISK_IO_READ, Utils::Misc::friendlyUnit(torrentDiskIO.status.bytesRead));
+        item->setText(DISK_IO_WRITTEN, Utils::Misc::friendlyUnit(torrentDiskIO.status.bytesWritten));
+        item->setText(DISK_IO_READ_LATENCY, latencyPercentilesString(torrentDiskIO.status.readLatency));
+        item->setText(DISK_IO_WRITE_LATENCY, latencyPercentilesString(torrentDiskIO.status.writeLatency));
+    }
 }
@@ -50,6 +50,8 @@ private slots:
     void update();
 
 private:
+    void updateDiskIOStats();
+
     Ui::StatsDialog *m_ui = nullptr;
     SettingValue<QSize> m_storeDialogSize;
 };
@@ -30,12 +30,17 @@
 #include "torrentcontentmodel.h"
 
 #include <algorithm>
+#include <cmath>
 
+#include <QCoreApplication>
 #include <QFileIconProvider>
 #include <QFileInfo>
+#include <QHash>
 #include <QIcon>
 #include <QPointer>
 #include <QScopeGuard>
+#include <QSet>
+#include <QThreadPool>
 
 #if defined(Q_OS_WIN)
 #include <Windows.h>
@@ -56,7 +61,6 @@
 #include "base/global.h"
 #include "base/path.h"
 #include "base/utils/fs.h"
-#include "torrentcontentmodelfile.h"
 #include "torrentcontentmodelfolder.h"
 #include "torrentcontentmodelitem.h"
 #include "uithememanager.h"
@@ -67,6 +71,10 @@
 
 namespace
 {
+    // File rows aren't backed by tree items, so their indexes refer to the parent folder item
+    // marked with the lowest bit (which is always unset in pointers to properly aligned objects)
+    const quintptr FILE_ROW_MARK = 1;
+
     class UnifiedFileIconProvider : public QFileIconProvider
     {
     public:
@@ -209,17 +217,46 @@ void TorrentContentModel::updateFilesProgress()
 {
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
-    const QVector<qreal> &filesProgress = m_contentHandler->filesProgress();
-    Q_ASSERT(m_filesIndex.size() == filesProgress.size());
+    // don't pile up the requests if previous one isn't processed yet
+    if (m_isFilesProgressUpdating)
+        return;
+
+    m_isFilesProgressUpdating = true;
+
+    m_contentHandler->fetchFilesProgress([this, generation = m_contentGeneration](const QVector<qreal> &filesProgress)
+    {
+        // the result of the request for the previous content handler must not affect the current one
+        if (generation != m_contentGeneration)
+            return;
+
+        findChangedFilesAsync(m_filesProgress, filesProgress
+                , [this, generation, filesProgress](const QVector<int> &changedIndexes)
+        {
+            if (generation != m_contentGeneration)
+                return;
+
+            m_isFilesProgressUpdating = false;
+            applyFilesProgress(filesProgress, changedIndexes);
+        });
+    });
+}
+
+void TorrentContentModel::applyFilesProgress(const QVector<qreal> &filesProgress, const QVector<int> &changedIndexes)
+{
+    Q_ASSERT(m_files.size() == filesProgress.size());
     // XXX: Why is this necessary?
-    if (m_filesIndex.size() != filesProgress.size()) [[unlikely]]
+    if (m_files.size() != filesProgress.size()) [[unlikely]]
         return;
 
-    for (int i = 0; i < filesProgress.size(); ++i)
-        m_filesIndex[i]->setProgress(filesProgress[i]);
-    // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    m_rootItem->recalculateAvailability();
+    for (const int fileIndex : changedIndexes)
+    {
+        // Folders progress is updated along with the file one
+        const TorrentContentModelItem::Statistics oldStatistics = fileStatistics(fileIndex);
+        m_filesProgress[fileIndex] = filesProgress[fileIndex];
+        m_files[fileIndex].parent->updateStatistics(oldStatistics, fileStatistics(fileIndex));
+    }
+
+    notifyFilesUpdated(changedIndexes, {TorrentContentModelItem::COL_PROGRESS, TorrentContentModelItem::COL_REMAINING});
 }
 
 void TorrentContentModel::updateFilesPriorities()
@@ -227,34 +264,98 @@ void TorrentContentModel::updateFilesPriorities()
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
     const QVector<BitTorrent::DownloadPriority> fprio = m_contentHandler->filePriorities();
-    Q_ASSERT(m_filesIndex.size() == fprio.size());
+    Q_ASSERT(m_files.size() == fprio.size());
     // XXX: Why is this necessary?
-    if (m_filesIndex.size() != fprio.size())
+    if (m_files.size() != fprio.size())
         return;
 
+    QVector<int> changedIndexes;
     for (int i = 0; i < fprio.size(); ++i)
-        m_filesIndex[i]->setPriority(static_cast<BitTorrent::DownloadPriority>(fprio[i]));
+    {
+        if (m_files[i].priority == fprio[i])
+            continue;
+
+        setFilePriority(i, fprio[i]);
+        changedIndexes.append(i);
+    }
+
+    notifyFilesUpdated(changedIndexes, {TorrentContentModelItem::COL_NAME, (TorrentContentModelItem::NB_COL - 1)});
 }
 
 void TorrentContentModel::updateFilesAvailability()
 {
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
-    using HandlerPtr = QPointer<BitTorrent::TorrentContentHandler>;
-    m_contentHandler->fetchAvailableFileFractions([this, handler = HandlerPtr(m_contentHandler)](const QVector<qreal> &availableFileFractions)
+    if (m_isFilesAvailabilityUpdating)
+        return;
+
+    m_isFilesAvailabilityUpdating = true;
+
+    m_contentHandler->fetchAvailableFileFractions([this, generation = m_contentGeneration](const QVector<qreal> &availableFileFractions)
     {
-        if (handler != m_contentHandler)
+        if (generation != m_contentGeneration)
             return;
 
-        Q_ASSERT(m_filesIndex.size() == availableFileFractions.size());
-        // XXX: Why is this necessary?
-        if (m_filesIndex.size() != availableFileFractions.size()) [[unlikely]]
-            return;
+        findChangedFilesAsync(m_filesAvailability, availableFileFractions
+                , [this, generation, availableFileFractions](const QVector<int> &changedIndexes)
+        {
+            if (generation != m_contentGeneration)
+                return;
+
+            m_isFilesAvailabilityUpdating = false;
+            applyFilesAvailability(availableFileFractions, changedIndexes);
+        });
+    });
+}
+
+void TorrentContentModel::applyFilesAvailability(const QVector<qreal> &filesAvailability, const QVector<int> &changedIndexes)
+{
+    Q_ASSERT(m_files.size() == filesAvailability.size());
+    // XXX: Why is this necessary?
+    if (m_files.size() != filesAvailability.size()) [[unlikely]]
+        return;
 
-        for (int i = 0; i < m_filesIndex.size(); ++i)
-            m_filesIndex[i]->setAvailability(availableFileFractions[i]);
-        // Update folders progress in the tree
-        m_rootItem->recalculateProgress();
+    for (const int fileIndex : changedIndexes)
+    {
+        const TorrentContentModelItem::Statistics oldStatistics = fileStatistics(fileIndex);
+        m_filesAvailability[fileIndex] = filesAvailability[fileIndex];
+        m_files[fileIndex].parent->updateStatistics(oldStatistics, fileStatistics(fileIndex));
+    }
+
+    notifyFilesUpdated(changedIndexes, {TorrentContentModelItem::COL_AVAILABILITY, TorrentContentModelItem::COL_AVAILABILITY});
+}
+
+void TorrentContentModel::findChangedFilesAsync(QVector<qreal> previousValues, QVector<qreal> values
+        , std::function<void (QVector<int>)> resultHandler)
+{
+    // Comparing values of huge amount of files shouldn't block GUI thread,
+    // so it is done in worker thread and only the result is passed back
+    QThreadPool::globalInstance()->start([model = QPointer<TorrentContentModel>(this)
+            , previousValues = std::move(previousValues), values = std::move(values)
+            , resultHandler = std::move(resultHandler)]() mutable
+    {
+        QVector<int> changedIndexes;
+        if (previousValues.size() != values.size())
+        {
+            changedIndexes.reserve(values.size());
+            for (int i = 0; i < values.size(); ++i)
+                changedIndexes.append(i);
+        }
+        else
+        {
+            for (int i = 0; i < values.size(); ++i)
+            {
+                if (values[i] != previousValues[i])
+                    changedIndexes.append(i);
+            }
+        }
+
+        QMetaObject::invokeMethod(qApp, [model = std::move(model), changedIndexes = std::move(changedIndexes)
+                , resultHandler = std::move(resultHandler)]
+        {
+            if (model)
+                resultHandler(changedIndexes);
+        }, Qt::QueuedConnection);
     });
 }
 
@@ -262,34 +363,98 @@ bool TorrentContentModel::setItemPriority(const QModelIndex &index, BitTorrent::
 {
     Q_ASSERT(index.isValid());
 
-    auto *item = static_cast<TorrentContentModelItem *>(index.internalPointer());
-    const BitTorrent::DownloadPriority currentPriority = item->priority();
-    if (currentPriority == priority)
-        return false;
+    if (const int fileIndex = getFileIndex(index); fileIndex >= 0)
+    {
+        if (m_files[fileIndex].priority == priority)
+            return false;
 
-    item->setPriority(priority);
-    m_contentHandler->prioritizeFiles(getFilePriorities());
+        // Folders statistics are updated along with the priorities
+        setFilePriority(fileIndex, priority);
+    }
+    else
+    {
+        TorrentContentModelFolder *folder = folderItem(index);
+        // Folder priority is derived from the priorities of its files so "Mixed" one cannot be applied
+        if ((folder->priority() == priority) || (priority == BitTorrent::DownloadPriority::Mixed))
+            return false;
+
+        QVector<TorrentContentModelFolder *> folders {folder};
+        while (!folders.isEmpty())
+        {
+            const TorrentContentModelFolder *currentFolder = folders.takeLast();
+            for (const int childFileIndex : currentFolder->childFiles())
+                setFilePriority(childFileIndex, priority);
+            folders.append(currentFolder->childFolders());
+        }
+    }
 
-    // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    m_rootItem->recalculateAvailability();
+    m_contentHandler->prioritizeFiles(getFilePriorities());
 
     const QVector<ColumnInterval> columns =
     {
         {TorrentContentModelItem::COL_NAME, TorrentContentModelItem::COL_NAME},
-        {TorrentContentModelItem::COL_PRIO, TorrentContentModelItem::COL_PRIO}
+        {TorrentContentModelItem::COL_PROGRESS, TorrentContentModelItem::COL_AVAILABILITY}
     };
     notifySubtreeUpdated(index, columns);
 
     return true;
 }
 
+void TorrentContentModel::setFilePriority(const int fileIndex, const BitTorrent::DownloadPriority priority)
+{
+    Q_ASSERT(priority != BitTorrent::DownloadPriority::Mixed);
+
+    FileEntry &file = m_files[fileIndex];
+    if (file.priority == priority)
+        return;
+
+    const TorrentContentModelItem::Statistics oldStatistics = fileStatistics(fileIndex);
+    const BitTorrent::DownloadPriority oldPriority = file.priority;
+    file.priority = priority;
+    file.parent->updateStatistics(oldStatistics, fileStatistics(fileIndex));
+    file.parent->updateChildPriority(oldPriority, priority);
+}
+
+TorrentContentModelItem::Statistics TorrentContentModel::fileStatistics(const int fileIndex) const
+{
+    const FileEntry &file = m_files[fileIndex];
+    if (file.priority == BitTorrent::DownloadPriority::Ignored)
+        return {};
+
+    const qreal fileAvailability = (file.size > 0) ? m_filesAvailability[fileIndex] : 0;
+    const bool isAvailabilityKnown = (fileAvailability >= 0);
+
+    TorrentContentModelItem::Statistics result;
+    result.wantedSize = static_cast<qlonglong>(file.size);
+    result.remaining = static_cast<qlonglong>(file.size * (1.0 - m_filesProgress[fileIndex]));
+    result.availableSize = isAvailabilityKnown ? std::llround(fileAvailability * file.size) : 0;
+    result.availabilityKnownCount = isAvailabilityKnown ? 1 : 0;
+    return result;
+}
+
+TorrentContentModelItem::Data TorrentContentModel::fileData(const int fileIndex, const int column) const
+{
+    const FileEntry &file = m_files[fileIndex];
+    const qreal progress = m_filesProgress[fileIndex];
+
+    TorrentContentModelItem::Data data;
+    // file name is the only value that isn't cheap to obtain
+    if (column == TorrentContentModelItem::COL_NAME)
+        data.name = m_renamedFileNames.value(fileIndex, m_contentHandler->filePath(fileIndex).filename());
+    data.size = file.size;
+    data.remaining = static_cast<qulonglong>(file.size * (1.0 - progress));
+    data.priority = file.priority;
+    data.progress = progress;
+    data.availability = m_filesAvailability[fileIndex];
+    return data;
+}
+
 QVector<BitTorrent::DownloadPriority> TorrentContentModel::getFilePriorities() const
 {
     QVector<BitTorrent::DownloadPriority> prio;
-    prio.reserve(m_filesIndex.size());
-    for (const TorrentContentModelFile *file : asConst(m_filesIndex))
-        prio.push_back(file->priority());
+    prio.reserve(m_files.size());
+    for (const FileEntry &file : asConst(m_files))
+        prio.push_back(file.priority);
     return prio;
 }
 
@@ -318,13 +483,12 @@ bool TorrentContentModel::setData(const QModelIndex &index, const QVariant &valu
 
     if (role == Qt::EditRole)
     {
-        auto *item = static_cast<TorrentContentModelItem *>(index.internalPointer());
-
         switch (index.column())
         {
         case TorrentContentModelItem::COL_NAME:
             {
-                const QString currentName = item->name();
+                const int fileIndex = getFileIndex(index);
+                const QString currentName = index.data().toString();
                 const QString newName = value.toString();
                 if (currentName != newName)
                 {
@@ -334,7 +498,7 @@ bool TorrentContentModel::setData(const QModelIndex &index, const QVariant &valu
                         const Path oldPath = parentPath / Path(currentName);
                         const Path newPath = parentPath / Path(newName);
 
-                        if (item->itemType() == TorrentContentModelItem::FileType)
+                        if (fileIndex >= 0)
                             m_contentHandler->renameFile(oldPath, newPath);
                         else
                             m_contentHandler->renameFolder(oldPath, newPath);
@@ -345,7 +509,10 @@ bool TorrentContentModel::setData(const QModelIndex &index, const QVariant &valu
                         return false;
                     }
 
-                    item->setName(newName);
+                    if (fileIndex >= 0)
+                        m_renamedFileNames[fileIndex] = newName;
+                    else
+                        folderItem(index)->setName(newName);
                     emit dataChanged(index, index);
                     return true;
                 }
@@ -369,16 +536,33 @@ bool TorrentContentModel::setData(const QModelIndex &index, const QVariant &valu
 
 TorrentContentModelItem::ItemType TorrentContentModel::itemType(const QModelIndex &index) const
 {
-    return static_cast<const TorrentContentModelItem *>(index.internalPointer())->itemType();
+    return (getFileIndex(index) >= 0) ? TorrentContentModelItem::FileType : TorrentContentModelItem::FolderType;
 }
 
 int TorrentContentModel::getFileIndex(const QModelIndex &index) const
 {
-    auto *item = static_cast<TorrentContentModelItem *>(index.internalPointer());
-    if (item->itemType() == TorrentContentModelItem::FileType)
-        return static_cast<TorrentContentModelFile *>(item)->fileIndex();
+    if (!index.isValid() || !(index.internalId() & FILE_ROW_MARK))
+        return -1;
+
+    const auto *parentItem = reinterpret_cast<const TorrentContentModelFolder *>(index.internalId() & ~FILE_ROW_MARK);
+    return parentItem->childFileIndex(index.row());
+}
+
+TorrentContentModelFolder *TorrentContentModel::folderItem(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return m_rootItem;
+
+    if (index.internalId() & FILE_ROW_MARK)
+        return nullptr;
 
-    return -1;
+    return static_cast<TorrentContentModelFolder *>(index.internalPointer());
+}
+
+int TorrentContentModel::fileRow(const int fileIndex) const
+{
+    const FileEntry &file = m_files[fileIndex];
+    return file.parent->childFileRow(file.position);
 }
 
 Path TorrentContentModel::getItemPath(const QModelIndex &index) const
@@ -394,7 +578,8 @@ QVariant TorrentContentModel::data(const QModelIndex &index, const int role) con
     if (!index.isValid())
         return {};
 
-    auto *item = static_cast<TorrentContentModelItem *>(index.internalPointer());
+    const int fileIndex = getFileIndex(index);
+    const TorrentContentModelFolder *folder = (fileIndex < 0) ? folderItem(index) : nullptr;
 
     switch (role)
     {
@@ -402,35 +587,29 @@ QVariant TorrentContentModel::data(const QModelIndex &index, const int role) con
         if (index.column() != TorrentContentModelItem::COL_NAME)
             return {};
 
-        if (item->itemType() == TorrentContentModelItem::FolderType)
+        if (folder)
             return m_fileIconProvider->icon(QFileIconProvider::Folder);
 
-        return m_fileIconProvider->icon(QFileInfo(item->name()));
+        return m_fileIconProvider->icon(QFileInfo(fileData(fileIndex, TorrentContentModelItem::COL_NAME).name));
 
     case Qt::CheckStateRole:
-        if (index.column() != TorrentContentModelItem::COL_NAME)
-            return {};
-
-        if (item->priority() == BitTorrent::DownloadPriority::Ignored)
-            return Qt::Unchecked;
-
-        if (item->priority() == BitTorrent::DownloadPriority::Mixed)
         {
-            Q_ASSERT(item->itemType() == TorrentContentModelItem::FolderType);
+            if (index.column() != TorrentContentModelItem::COL_NAME)
+                return {};
 
-            const auto *folder = static_cast<TorrentContentModelFolder *>(item);
-            const auto childItems = folder->children();
-            const bool hasIgnored = std::any_of(childItems.cbegin(), childItems.cend()
-                         , [](const TorrentContentModelItem *childItem)
+            const BitTorrent::DownloadPriority priority = folder ? folder->priority() : m_files[fileIndex].priority;
+            if (priority == BitTorrent::DownloadPriority::Ignored)
+                return Qt::Unchecked;
+
+            if (priority == BitTorrent::DownloadPriority::Mixed)
             {
-                return (childItem->priority() == BitTorrent::DownloadPriority::Ignored);
-            });
+                Q_ASSERT(folder);
+                return folder->hasIgnoredChildren() ? Qt::PartiallyChecked : Qt::Checked;
+            }
 
-            return hasIgnored ? Qt::PartiallyChecked : Qt::Checked;
+            return Qt::Checked;
         }
 
-        return Qt::Checked;
-
     case Qt::TextAlignmentRole:
         if ((index.column() == TorrentContentModelItem::COL_SIZE)
             || (index.column() == TorrentContentModelItem::COL_REMAINING))
@@ -442,10 +621,14 @@ QVariant TorrentContentModel::data(const QModelIndex &index, const int role) con
 
     case Qt::DisplayRole:
     case Qt::ToolTipRole:
-        return item->displayData(index.column());
+        return folder
+                ? folder->displayData(index.column())
+                : TorrentContentModelItem::displayData(fileData(fileIndex, index.column()), index.column());
 
     case Roles::UnderlyingDataRole:
-        return item->underlyingData(index.column());
+        return folder
+                ? folder->underlyingData(index.column())
+                : TorrentContentModelItem::underlyingData(fileData(fileIndex, index.column()), index.column());
 
     default:
         break;
@@ -494,22 +677,17 @@ QVariant TorrentContentModel::headerData(int section, Qt::Orientation orientatio
 
 QModelIndex TorrentContentModel::index(const int row, const int column, const QModelIndex &parent) const
 {
-    if (column >= columnCount())
+    if ((row < 0) || (column < 0) || (column >= columnCount()))
         return {};
 
-    const TorrentContentModelFolder *parentItem = parent.isValid()
-        ? static_cast<TorrentContentModelFolder *>(parent.internalPointer())
-        : m_rootItem;
-    Q_ASSERT(parentItem);
-
-    if (row >= parentItem->childCount())
+    const TorrentContentModelFolder *parentItem = folderItem(parent);
+    if (!parentItem || (row >= parentItem->childCount()))
         return {};
 
-    TorrentContentModelItem *childItem = parentItem->child(row);
-    if (childItem)
-        return createIndex(row, column, childItem);
+    if (const TorrentContentModelFolder *childFolder = parentItem->childFolder(row))
+        return createIndex(row, column, childFolder);
 
-    return {};
+    return createIndex(row, column, (reinterpret_cast<quintptr>(parentItem) | FILE_ROW_MARK));
 }
 
 QModelIndex TorrentContentModel::parent(const QModelIndex &index) const
@@ -517,12 +695,10 @@ QModelIndex TorrentContentModel::parent(const QModelIndex &index) const
     if (!index.isValid())
         return {};
 
-    const auto *item = static_cast<TorrentContentModelItem *>(index.internalPointer());
-    if (!item)
-        return {};
-
-    TorrentContentModelItem *parentItem = item->parent();
-    if (parentItem == m_rootItem)
+    const TorrentContentModelFolder *parentItem = (index.internalId() & FILE_ROW_MARK)
+            ? reinterpret_cast<const TorrentContentModelFolder *>(index.internalId() & ~FILE_ROW_MARK)
+            : static_cast<const TorrentContentModelFolder *>(index.internalPointer())->parent();
+    if (!parentItem || (parentItem == m_rootItem))
         return {};
 
     // From https://doc.qt.io/qt-6/qabstractitemmodel.html#parent:
@@ -534,9 +710,7 @@ QModelIndex TorrentContentModel::parent(const QModelIndex &index) const
 
 int TorrentContentModel::rowCount(const QModelIndex &parent) const
 {
-    const TorrentContentModelFolder *parentItem = parent.isValid()
-        ? dynamic_cast<TorrentContentModelFolder *>(static_cast<TorrentContentModelItem *>(parent.internalPointer()))
-        : m_rootItem;
+    const TorrentContentModelFolder *parentItem = folderItem(parent);
     return parentItem ? parentItem->childCount() : 0;
 }
 
@@ -545,8 +719,24 @@ void TorrentContentModel::populate()
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
     const int filesCount = m_contentHandler->filesCount();
-    m_filesIndex.reserve(filesCount);
 
+    // Initial values are applied at once since the model is being reset anyway
+    QVector<BitTorrent::DownloadPriority> filePriorities = m_contentHandler->filePriorities();
+    if (filePriorities.size() != filesCount) [[unlikely]]
+        filePriorities = QVector<BitTorrent::DownloadPriority>(filesCount, BitTorrent::DownloadPriority::Normal);
+
+    m_filesProgress = m_contentHandler->filesProgress();
+    if (m_filesProgress.size() != filesCount) [[unlikely]]
+        m_filesProgress = QVector<qreal>(filesCount, 0);
+
+    // -1 means "no data"
+    m_filesAvailability = QVector<qreal>(filesCount, -1);
+
+    m_files.resize(filesCount);
+
+    // The same folder names are often repeated in different parts of the tree
+    // (e.g. "Subs", "Extras") so they share the same string data
+    QSet<QString> folderNames;
     QHash<TorrentContentModelFolder *, QHash<QString, TorrentContentModelFolder *>> folderMap;
     QVector<QString> lastParentPath;
     TorrentContentModelFolder *lastParent = m_rootItem;
@@ -557,7 +747,7 @@ void TorrentContentModel::populate()
 
         // Iterate of parts of the path to create necessary folders
         QList<QStringView> pathFolders = QStringView(path).split(u'/', Qt::SkipEmptyParts);
-        const QString fileName = pathFolders.takeLast().toString();
+        pathFolders.removeLast();
 
         if (!std::equal(lastParentPath.begin(), lastParentPath.end()
                         , pathFolders.begin(), pathFolders.end()))
@@ -569,28 +759,28 @@ void TorrentContentModel::populate()
             lastParent = m_rootItem;
             for (const QStringView pathPart : asConst(pathFolders))
             {
-                const QString folderName = pathPart.toString();
+                const QString folderName = *folderNames.insert(pathPart.toString());
                 lastParentPath.push_back(folderName);
 
                 TorrentContentModelFolder *&newParent = folderMap[lastParent][folderName];
                 if (!newParent)
                 {
                     newParent = new TorrentContentModelFolder(folderName, lastParent);
-                    lastParent->appendChild(newParent);
+                    lastParent->appendChildFolder(newParent);
                 }
 
                 lastParent = newParent;
             }
         }
 
-        // Actually create the file
-        auto *fileItem = new TorrentContentModelFile(fileName, m_contentHandler->fileSize(i), lastParent, i);
-        lastParent->appendChild(fileItem);
-        m_filesIndex.push_back(fileItem);
+        // Files are only registered in their folders, their names are provided by content handler on demand
+        FileEntry &file = m_files[i];
+        file.parent = lastParent;
+        file.size = m_contentHandler->fileSize(i);
+        file.priority = filePriorities[i];
+        file.position = lastParent->appendChildFile(i, file.size, file.priority, fileStatistics(i));
     }
 
-    updateFilesProgress();
-    updateFilesPriorities();
     updateFilesAvailability();
 }
 
@@ -599,16 +789,39 @@ void TorrentContentModel::setContentHandler(BitTorrent::TorrentContentHandler *c
     beginResetModel();
     [[maybe_unused]] const auto modelResetGuard = qScopeGuard([this] { endResetModel(); });
 
+    ++m_contentGeneration;
     if (m_contentHandler)
     {
-        m_filesIndex.clear();
+        m_contentHandler->disconnect(this);
+        m_files.clear();
+        m_renamedFileNames.clear();
+        m_filesProgress.clear();
+        m_filesAvailability.clear();
+        m_isFilesProgressUpdating = false;
+        m_isFilesAvailabilityUpdating = false;
         m_rootItem->deleteAllChildren();
     }
 
     m_contentHandler = contentHandler;
 
-    if (m_contentHandler && m_contentHandler->hasMetadata())
-        populate();
+    if (m_contentHandler)
+    {
+        // the name set by the model is only needed until the actual one is reported
+        connect(m_contentHandler, &BitTorrent::TorrentContentHandler::fileRenamed, this, &TorrentContentModel::handleFileRenamed);
+        connect(m_contentHandler, &BitTorrent::TorrentContentHandler::fileRenameFailed, this, &TorrentContentModel::handleFileRenamed);
+
+        if (m_contentHandler->hasMetadata())
+            populate();
+    }
+}
+
+void TorrentContentModel::handleFileRenamed(const int fileIndex)
+{
+    m_renamedFileNames.remove(fileIndex);
+    if (fileIndex >= m_files.size()) [[unlikely]]
+        return;
+
+    notifyFilesUpdated({fileIndex}, {TorrentContentModelItem::COL_NAME, TorrentContentModelItem::COL_NAME});
 }
 
 BitTorrent::TorrentContentHandler *TorrentContentModel::contentHandler() const
@@ -621,20 +834,12 @@ void TorrentContentModel::refresh()
     if (!m_contentHandler || !m_contentHandler->hasMetadata())
         return;
 
-    if (!m_filesIndex.isEmpty())
+    if (!m_files.isEmpty())
     {
-        updateFilesProgress();
+        // Only the changed files and their parent folders are reported
         updateFilesPriorities();
+        updateFilesProgress();
         updateFilesAvailability();
-
-        const QVector<ColumnInterval> columns =
-        {
-            {TorrentContentModelItem::COL_NAME, TorrentContentModelItem::COL_NAME},
-            {TorrentContentModelItem::COL_PROGRESS, TorrentContentModelItem::COL_PROGRESS},
-            {TorrentContentModelItem::COL_PRIO, TorrentContentModelItem::COL_PRIO},
-            {TorrentContentModelItem::COL_AVAILABILITY, TorrentContentModelItem::COL_AVAILABILITY}
-        };
-        notifySubtreeUpdated(index(0, 0), columns);
     }
     else
     {
@@ -644,6 +849,46 @@ void TorrentContentModel::refresh()
     }
 }
 
+void TorrentContentModel::notifyFilesUpdated(const QVector<int> &fileIndexes, const ColumnInterval &columns)
+{
+    // The files and all their ancestor folders are affected,
+    // the affected rows are collected per parent folder
+    QHash<const TorrentContentModelFolder *, QVector<int>> affectedRows;
+    QSet<const TorrentContentModelFolder *> visitedFolders;
+    for (const int fileIndex : fileIndexes)
+    {
+        const TorrentContentModelFolder *folder = m_files[fileIndex].parent;
+        affectedRows[folder].append(fileRow(fileIndex));
+
+        // once an already visited folder is met its ancestors are visited as well
+        for (; !folder->isRootItem() && !visitedFolders.contains(folder); folder = folder->parent())
+        {
+            visitedFolders.insert(folder);
+            affectedRows[folder->parent()].append(folder->row());
+        }
+    }
+
+    for (auto it = affectedRows.begin(); it != affectedRows.end(); ++it)
+    {
+        const TorrentContentModelFolder *parentItem = it.key();
+        const QModelIndex parentIndex = parentItem->isRootItem()
+                ? QModelIndex() : createIndex(parentItem->row(), 0, parentItem);
+
+        // report each run of adjacent rows at once
+        QVector<int> &rows = it.value();
+        std::sort(rows.begin(), rows.end());
+        for (qsizetype i = 0; i < rows.size();)
+        {
+            const int firstRow = rows[i];
+            int lastRow = firstRow;
+            while ((++i < rows.size()) && (rows[i] == (lastRow + 1)))
+                lastRow = rows[i];
+
+            emit dataChanged(index(firstRow, columns.first(), parentIndex), index(lastRow, columns.last(), parentIndex));
+        }
+    }
+}
+
 void TorrentContentModel::notifySubtreeUpdated(const QModelIndex &index, const QVector<ColumnInterval> &columns)
 {
     // For best performance, `columns` entries should be arranged from left to right
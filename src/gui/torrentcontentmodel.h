@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QVector>
 
 #include "base/indexrange.h"
@@ -40,8 +43,6 @@ class QFileIconProvider;
 class QModelIndex;
 class QVariant;
 
-class TorrentContentModelFile;
-
 namespace BitTorrent
 {
     class TorrentContentHandler;
@@ -86,15 +87,46 @@ signals:
 private:
     using ColumnInterval = IndexInterval<int>;
 
+    // Files aren't backed by tree items (that would take too much memory
+    // for torrents having a lot of files), their data is stored compactly instead
+    struct FileEntry
+    {
+        TorrentContentModelFolder *parent = nullptr;
+        qulonglong size = 0;
+        int position = 0;  // position among the files of parent folder
+        BitTorrent::DownloadPriority priority = BitTorrent::DownloadPriority::Normal;
+    };
+
+    TorrentContentModelFolder *folderItem(const QModelIndex &index) const;
+    int fileRow(int fileIndex) const;
+    TorrentContentModelItem::Data fileData(int fileIndex, int column) const;
+    TorrentContentModelItem::Statistics fileStatistics(int fileIndex) const;
+    void setFilePriority(int fileIndex, BitTorrent::DownloadPriority priority);
+
     void populate();
+    void handleFileRenamed(int fileIndex);
     void updateFilesProgress();
     void updateFilesPriorities();
     void updateFilesAvailability();
+    void applyFilesProgress(const QVector<qreal> &filesProgress, const QVector<int> &changedIndexes);
+    void applyFilesAvailability(const QVector<qreal> &filesAvailability, const QVector<int> &changedIndexes);
+    void findChangedFilesAsync(QVector<qreal> previousValues, QVector<qreal> values
+            , std::function<void (QVector<int>)> resultHandler);
     bool setItemPriority(const QModelIndex &index, BitTorrent::DownloadPriority priority);
+    void notifyFilesUpdated(const QVector<int> &fileIndexes, const ColumnInterval &columns);
     void notifySubtreeUpdated(const QModelIndex &index, const QVector<ColumnInterval> &columns);
 
     BitTorrent::TorrentContentHandler *m_contentHandler = nullptr;
     TorrentContentModelFolder *m_rootItem = nullptr;
-    QVector<TorrentContentModelFile *> m_filesIndex;
+    QVector<FileEntry> m_files;
+    // file names are provided by content handler, but renaming can be applied asynchronously
+    QHash<int, QString> m_renamedFileNames;
+    // last applied values, new ones are compared against them to find out changed files
+    QVector<qreal> m_filesProgress;
+    QVector<qreal> m_filesAvailability;
+    // changed along with content handler, so the results of the pending requests can be recognized as outdated
+    quint64 m_contentGeneration = 0;
+    bool m_isFilesProgressUpdating = false;
+    bool m_isFilesAvailabilityUpdating = false;
     QFileIconProvider *m_fileIconProvider = nullptr;
 };
@@ -28,10 +28,6 @@
 
 #include "torrentcontentmodelfolder.h"
 
-#include <QVariant>
-
-#include "base/global.h"
-
 TorrentContentModelFolder::TorrentContentModelFolder(const QString &name, TorrentContentModelFolder *parent)
     : TorrentContentModelItem(parent)
 {
@@ -48,7 +44,7 @@ TorrentContentModelFolder::TorrentContentModelFolder(const QVector<QString> &dat
 
 TorrentContentModelFolder::~TorrentContentModelFolder()
 {
-    qDeleteAll(m_childItems);
+    qDeleteAll(m_childFolders);
 }
 
 TorrentContentModelItem::ItemType TorrentContentModelFolder::itemType() const
@@ -59,31 +55,91 @@ TorrentContentModelItem::ItemType TorrentContentModelFolder::itemType() const
 void TorrentContentModelFolder::deleteAllChildren()
 {
     Q_ASSERT(isRootItem());
-    qDeleteAll(m_childItems);
-    m_childItems.clear();
+    qDeleteAll(m_childFolders);
+    m_childFolders.clear();
+    m_childFiles.clear();
+    m_childPriorities.clear();
+}
+
+const QVector<TorrentContentModelFolder *> &TorrentContentModelFolder::childFolders() const
+{
+    return m_childFolders;
+}
+
+const QVector<int> &TorrentContentModelFolder::childFiles() const
+{
+    return m_childFiles;
+}
+
+void TorrentContentModelFolder::appendChildFolder(TorrentContentModelFolder *folder)
+{
+    Q_ASSERT(folder);
+    folder->m_row = m_childFolders.size();
+    m_childFolders.append(folder);
+    addChildPriority(folder->priority());
+    updatePriority();
+}
+
+int TorrentContentModelFolder::appendChildFile(const int fileIndex, const qulonglong fileSize
+        , const BitTorrent::DownloadPriority priority, const Statistics &statistics)
+{
+    Q_ASSERT(priority != BitTorrent::DownloadPriority::Mixed);
+
+    m_childFiles.append(fileIndex);
+    increaseSize(fileSize);
+    updateStatistics({}, statistics);
+    addChildPriority(priority);
+    updatePriority();
+    return (m_childFiles.size() - 1);
 }
 
-const QVector<TorrentContentModelItem *> &TorrentContentModelFolder::children() const
+TorrentContentModelFolder *TorrentContentModelFolder::childFolder(const int row) const
 {
-    return m_childItems;
+    return m_childFolders.value(row, nullptr);
 }
 
-void TorrentContentModelFolder::appendChild(TorrentContentModelItem *item)
+int TorrentContentModelFolder::childFileIndex(const int row) const
 {
-    Q_ASSERT(item);
-    m_childItems.append(item);
-    // Update own size
-    if (item->itemType() == FileType)
-        increaseSize(item->size());
+    return m_childFiles.value((row - m_childFolders.size()), -1);
 }
 
-TorrentContentModelItem *TorrentContentModelFolder::child(int row) const
+int TorrentContentModelFolder::childFileRow(const int filePosition) const
 {
-    return m_childItems.value(row, nullptr);
+    Q_ASSERT((filePosition >= 0) && (filePosition < m_childFiles.size()));
+    return m_childFolders.size() + filePosition;
 }
+
 int TorrentContentModelFolder::childCount() const
 {
-    return m_childItems.count();
+    return m_childFolders.size() + m_childFiles.size();
+}
+
+bool TorrentContentModelFolder::hasIgnoredChildren() const
+{
+    return m_childPriorities.contains(BitTorrent::DownloadPriority::Ignored);
+}
+
+void TorrentContentModelFolder::updateChildPriority(const BitTorrent::DownloadPriority oldPriority, const BitTorrent::DownloadPriority newPriority)
+{
+    if (oldPriority == newPriority)
+        return;
+
+    removeChildPriority(oldPriority);
+    addChildPriority(newPriority);
+    updatePriority();
+}
+
+void TorrentContentModelFolder::addChildPriority(const BitTorrent::DownloadPriority priority)
+{
+    ++m_childPriorities[priority];
+}
+
+void TorrentContentModelFolder::removeChildPriority(const BitTorrent::DownloadPriority priority)
+{
+    const auto iter = m_childPriorities.find(priority);
+    Q_ASSERT(iter != m_childPriorities.end());
+    if (--iter.value() == 0)
+        m_childPriorities.erase(iter);
 }
 
 // Only non-root folders use this function
@@ -92,99 +148,57 @@ void TorrentContentModelFolder::updatePriority()
     if (isRootItem())
         return;
 
-    Q_ASSERT(!m_childItems.isEmpty());
+    Q_ASSERT(!m_childPriorities.isEmpty());
 
     // If all children have the same priority
     // then the folder should have the same
     // priority
-    const BitTorrent::DownloadPriority prio = m_childItems.first()->priority();
-    for (int i = 1; i < m_childItems.size(); ++i)
-    {
-        if (m_childItems.at(i)->priority() != prio)
-        {
-            setPriority(BitTorrent::DownloadPriority::Mixed);
-            return;
-        }
-    }
-    // All child items have the same priority
-    // Update own if necessary
-    setPriority(prio);
-}
-
-void TorrentContentModelFolder::setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent)
-{
+    const BitTorrent::DownloadPriority newPriority = (m_childPriorities.size() == 1)
+            ? m_childPriorities.firstKey() : BitTorrent::DownloadPriority::Mixed;
     if (m_priority == newPriority)
         return;
 
+    const BitTorrent::DownloadPriority oldPriority = m_priority;
     m_priority = newPriority;
-
-    // Update parent priority
-    if (updateParent)
-        m_parentItem->updatePriority();
-
-    // Update children
-    if (m_priority != BitTorrent::DownloadPriority::Mixed)
-    {
-        for (TorrentContentModelItem *child : asConst(m_childItems))
-            child->setPriority(m_priority, false);
-    }
+    m_parentItem->updateChildPriority(oldPriority, newPriority);
 }
 
-void TorrentContentModelFolder::recalculateProgress()
+TorrentContentModelItem::Statistics TorrentContentModelFolder::statistics() const
 {
-    qreal tProgress = 0;
-    qulonglong tSize = 0;
-    qulonglong tRemaining = 0;
-    for (TorrentContentModelItem *child : asConst(m_childItems))
-    {
-        if (child->priority() == BitTorrent::DownloadPriority::Ignored)
-            continue;
-
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder *>(child)->recalculateProgress();
-        tProgress += child->progress() * child->size();
-        tSize += child->size();
-        tRemaining += child->remaining();
-    }
-
-    if (!isRootItem() && (tSize > 0))
-    {
-        m_progress = tProgress / tSize;
-        m_remaining = tRemaining;
-        Q_ASSERT(m_progress <= 1.);
-    }
+    return m_statistics;
 }
 
-void TorrentContentModelFolder::recalculateAvailability()
+// Statistics of wanted files are accumulated through the whole tree, so changing
+// a single file updates only its ancestors instead of recalculating all folders
+void TorrentContentModelFolder::updateStatistics(const Statistics &oldStatistics, const Statistics &newStatistics)
 {
-    qreal tAvailability = 0;
-    qulonglong tSize = 0;
-    bool foundAnyData = false;
-    for (TorrentContentModelItem *child : asConst(m_childItems))
-    {
-        if (child->priority() == BitTorrent::DownloadPriority::Ignored)
-            continue;
-
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder*>(child)->recalculateAvailability();
-        const qreal childAvailability = child->availability();
-        if (childAvailability >= 0)
-        { // -1 means "no data"
-            tAvailability += childAvailability * child->size();
-            foundAnyData = true;
-        }
-        tSize += child->size();
-    }
+    if (isRootItem())
+        return;
+
+    m_statistics.wantedSize += (newStatistics.wantedSize - oldStatistics.wantedSize);
+    m_statistics.remaining += (newStatistics.remaining - oldStatistics.remaining);
+    m_statistics.availableSize += (newStatistics.availableSize - oldStatistics.availableSize);
+    m_statistics.availabilityKnownCount += (newStatistics.availabilityKnownCount - oldStatistics.availabilityKnownCount);
 
-    if (!isRootItem() && (tSize > 0) && foundAnyData)
+    if (m_statistics.wantedSize > 0)
     {
-        m_availability = tAvailability / tSize;
+        m_remaining = m_statistics.remaining;
+        m_progress = 1 - (static_cast<qreal>(m_statistics.remaining) / m_statistics.wantedSize);
+        Q_ASSERT(m_progress <= 1.);
+
+        // -1 means "no data"
+        m_availability = (m_statistics.availabilityKnownCount > 0)
+                ? (static_cast<qreal>(m_statistics.availableSize) / m_statistics.wantedSize)
+                : -1.;
         Q_ASSERT(m_availability <= 1.);
     }
     else
     {
+        m_remaining = 0;
         m_availability = -1.;
     }
+
+    m_parentItem->updateStatistics(oldStatistics, newStatistics);
 }
 
 void TorrentContentModelFolder::increaseSize(qulonglong delta)
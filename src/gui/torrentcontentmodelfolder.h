@@ -28,12 +28,9 @@
 
 #pragma once
 
-#include "torrentcontentmodelitem.h"
+#include <QMap>
 
-namespace BitTorrent
-{
-    enum class DownloadPriority;
-}
+#include "torrentcontentmodelitem.h"
 
 class TorrentContentModelFolder final : public TorrentContentModelItem
 {
@@ -47,20 +44,33 @@ public:
     ~TorrentContentModelFolder() override;
 
     ItemType itemType() const override;
+    Statistics statistics() const override;
 
     void increaseSize(qulonglong delta);
-    void recalculateProgress();
-    void recalculateAvailability();
-    void updatePriority();
-
-    void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) override;
+    void updateStatistics(const Statistics &oldStatistics, const Statistics &newStatistics);
+    void updateChildPriority(BitTorrent::DownloadPriority oldPriority, BitTorrent::DownloadPriority newPriority);
+    bool hasIgnoredChildren() const;
 
+    // Child folders go first, then the files follow.
+    // Files aren't backed by items, they are referred by their indexes instead.
     void deleteAllChildren();
-    const QVector<TorrentContentModelItem*> &children() const;
-    void appendChild(TorrentContentModelItem *item);
-    TorrentContentModelItem *child(int row) const;
+    const QVector<TorrentContentModelFolder *> &childFolders() const;
+    const QVector<int> &childFiles() const;
+    void appendChildFolder(TorrentContentModelFolder *folder);
+    int appendChildFile(int fileIndex, qulonglong fileSize, BitTorrent::DownloadPriority priority, const Statistics &statistics);
+    TorrentContentModelFolder *childFolder(int row) const;
+    int childFileIndex(int row) const;
+    int childFileRow(int filePosition) const;
     int childCount() const;
 
 private:
-    QVector<TorrentContentModelItem *> m_childItems;
+    void addChildPriority(BitTorrent::DownloadPriority priority);
+    void removeChildPriority(BitTorrent::DownloadPriority priority);
+    void updatePriority();
+
+    QVector<TorrentContentModelFolder *> m_childFolders;
+    QVector<int> m_childFiles;
+    // number of children having each priority
+    QMap<BitTorrent::DownloadPriority, int> m_childPriorities;
+    Statistics m_statistics;
 };
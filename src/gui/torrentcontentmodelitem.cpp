@@ -102,12 +102,25 @@ QString TorrentContentModelItem::displayData(const int column) const
     if (isRootItem())
         return m_itemData.value(column);
 
+    return displayData({m_name, m_size, m_remaining, m_priority, m_progress, m_availability}, column);
+}
+
+QVariant TorrentContentModelItem::underlyingData(const int column) const
+{
+    if (isRootItem())
+        return m_itemData.value(column);
+
+    return underlyingData({m_name, m_size, m_remaining, m_priority, m_progress, m_availability}, column);
+}
+
+QString TorrentContentModelItem::displayData(const Data &data, const int column)
+{
     switch (column)
     {
     case COL_NAME:
-        return m_name;
+        return data.name;
     case COL_PRIO:
-        switch (m_priority)
+        switch (data.priority)
         {
         case BitTorrent::DownloadPriority::Mixed:
             return tr("Mixed", "Mixed (priorities");
@@ -121,16 +134,16 @@ QString TorrentContentModelItem::displayData(const int column) const
             return tr("Normal", "Normal (priority)");
         }
     case COL_PROGRESS:
-        return (m_progress >= 1)
+        return (data.progress >= 1)
                ? u"100%"_s
-               : (Utils::String::fromDouble((m_progress * 100), 1) + u'%');
+               : (Utils::String::fromDouble((data.progress * 100), 1) + u'%');
     case COL_SIZE:
-        return Utils::Misc::friendlyUnit(m_size);
+        return Utils::Misc::friendlyUnit(data.size);
     case COL_REMAINING:
-        return Utils::Misc::friendlyUnit(remaining());
+        return Utils::Misc::friendlyUnit((data.priority == BitTorrent::DownloadPriority::Ignored) ? 0 : data.remaining);
     case COL_AVAILABILITY:
         {
-            const qreal avail = availability();
+            const qreal avail = (data.size > 0) ? data.availability : 0;
             if (avail < 0)
                 return tr("N/A");
 
@@ -145,25 +158,22 @@ QString TorrentContentModelItem::displayData(const int column) const
     }
 }
 
-QVariant TorrentContentModelItem::underlyingData(const int column) const
+QVariant TorrentContentModelItem::underlyingData(const Data &data, const int column)
 {
-    if (isRootItem())
-        return m_itemData.value(column);
-
     switch (column)
     {
     case COL_NAME:
-        return m_name;
+        return data.name;
     case COL_PRIO:
-        return static_cast<int>(m_priority);
+        return static_cast<int>(data.priority);
     case COL_PROGRESS:
-        return progress() * 100;
+        return ((data.size > 0) ? data.progress : 1) * 100;
     case COL_SIZE:
-        return m_size;
+        return data.size;
     case COL_REMAINING:
-        return remaining();
+        return (data.priority == BitTorrent::DownloadPriority::Ignored) ? 0 : data.remaining;
     case COL_AVAILABILITY:
-        return availability();
+        return (data.size > 0) ? data.availability : 0;
     default:
         Q_ASSERT(false);
         return {};
@@ -172,9 +182,7 @@ QVariant TorrentContentModelItem::underlyingData(const int column) const
 
 int TorrentContentModelItem::row() const
 {
-    if (m_parentItem)
-        return m_parentItem->children().indexOf(const_cast<TorrentContentModelItem *>(this));
-    return 0;
+    return m_row;
 }
 
 TorrentContentModelFolder *TorrentContentModelItem::parent() const
@@ -41,6 +41,8 @@ class TorrentContentModelItem
 {
     Q_DECLARE_TR_FUNCTIONS(TorrentContentModelItem)
 
+    friend class TorrentContentModelFolder;
+
 public:
     enum TreeItemColumns
     {
@@ -59,6 +61,30 @@ public:
         FolderType
     };
 
+    // Amounts of wanted files data that are accumulated by parent folders
+    struct Statistics
+    {
+        qlonglong wantedSize = 0;
+        qlonglong remaining = 0;
+        qlonglong availableSize = 0;
+        int availabilityKnownCount = 0;
+    };
+
+    // Files aren't backed by tree items, so their data is provided by the model
+    // and formatted the same way as the data of items
+    struct Data
+    {
+        QString name;
+        qulonglong size = 0;
+        qulonglong remaining = 0;
+        BitTorrent::DownloadPriority priority = BitTorrent::DownloadPriority::Normal;
+        qreal progress = 0;
+        qreal availability = -1;
+    };
+
+    static QString displayData(const Data &data, int column);
+    static QVariant underlyingData(const Data &data, int column);
+
     explicit TorrentContentModelItem(TorrentContentModelFolder *parent);
     virtual ~TorrentContentModelItem();
 
@@ -76,7 +102,8 @@ public:
     qreal availability() const;
 
     BitTorrent::DownloadPriority priority() const;
-    virtual void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) = 0;
+
+    virtual Statistics statistics() const = 0;
 
     int columnCount() const;
     QString displayData(int column) const;
@@ -85,6 +112,7 @@ public:
 
 protected:
     TorrentContentModelFolder *m_parentItem = nullptr;
+    int m_row = 0;
     // Root item members
     QVector<QString> m_itemData;
     // Non-root item members
@@ -389,22 +389,18 @@ void CategoryFilterModel::populate()
     m_rootItem->clear();
 
     const auto *session = BitTorrent::Session::instance();
-    const auto torrents = session->torrents();
     m_isSubcategoriesEnabled = session->isSubcategoriesEnabled();
 
     const QString UID_ALL;
     const QString UID_UNCATEGORIZED(QChar(1));
 
     // All torrents
-    m_rootItem->addChild(UID_ALL, new CategoryModelItem(nullptr, tr("All"), torrents.count()));
+    m_rootItem->addChild(UID_ALL, new CategoryModelItem(nullptr, tr("All"), session->torrentsCount()));
 
     // Uncategorized torrents
-    using Torrent = BitTorrent::Torrent;
-    const int torrentsCount = std::count_if(torrents.begin(), torrents.end()
-                                            , [](Torrent *torrent) { return torrent->category().isEmpty(); });
-    m_rootItem->addChild(UID_UNCATEGORIZED, new CategoryModelItem(nullptr, tr("Uncategorized"), torrentsCount));
+    m_rootItem->addChild(UID_UNCATEGORIZED, new CategoryModelItem(nullptr, tr("Uncategorized")
+            , session->categoryTorrents({}).count()));
 
-    using BitTorrent::Torrent;
     if (m_isSubcategoriesEnabled)
     {
         for (const QString &categoryName : asConst(session->categories()))
@@ -414,23 +410,16 @@ void CategoryFilterModel::populate()
             {
                 const QString subcatName = shortName(subcat);
                 if (!parent->hasChild(subcatName))
-                {
-                    const int torrentsCount = std::count_if(torrents.cbegin(), torrents.cend()
-                            , [subcat](Torrent *torrent) { return torrent->category() == subcat; });
-                    new CategoryModelItem(parent, subcatName, torrentsCount);
-                }
+                    new CategoryModelItem(parent, subcatName, session->categoryTorrents(subcat).count());
                 parent = parent->child(subcatName);
             }
         }
     }
     else
     {
+        // Torrents can belong to a category only directly when subcategories are disabled
         for (const QString &categoryName : asConst(session->categories()))
-        {
-            const int torrentsCount = std::count_if(torrents.begin(), torrents.end()
-                    , [categoryName](Torrent *torrent) { return torrent->belongsToCategory(categoryName); });
-            new CategoryModelItem(m_rootItem, categoryName, torrentsCount);
-        }
+            new CategoryModelItem(m_rootItem, categoryName, session->categoryTorrents(categoryName).count());
     }
 }
 
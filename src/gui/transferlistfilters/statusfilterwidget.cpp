@@ -33,6 +33,7 @@
 #include <QMenu>
 
 #include "base/bittorrent/session.h"
+#include "base/bittorrent/torrent.h"
 #include "base/global.h"
 #include "base/preferences.h"
 #include "base/torrentfilter.h"
@@ -86,10 +87,9 @@ StatusFilterWidget::StatusFilterWidget(QWidget *parent, TransferListWidget *tran
     errored->setData(Qt::DisplayRole, tr("Errored (0)"));
     errored->setData(Qt::DecorationRole, UIThemeManager::instance()->getIcon(u"error"_s));
 
-    const QVector<BitTorrent::Torrent *> torrents = BitTorrent::Session::instance()->torrents();
-    update(torrents);
+    handleTorrentsUpdated();
     connect(BitTorrent::Session::instance(), &BitTorrent::Session::torrentsUpdated
-            , this, &StatusFilterWidget::update);
+            , this, &StatusFilterWidget::handleTorrentsUpdated);
 
     const Preferences *const pref = Preferences::instance();
     connect(pref, &Preferences::changed, this, &StatusFilterWidget::configure);
@@ -124,38 +124,23 @@ QSize StatusFilterWidget::sizeHint() const
         static_cast<int>((sizeHintForRow(0) + 2 * spacing()) * (numVisibleItems + 0.5))};
 }
 
-void StatusFilterWidget::updateTorrentStatus(const BitTorrent::Torrent *torrent)
+void StatusFilterWidget::updateCounters()
 {
-    TorrentFilterBitset &torrentStatus = m_torrentsStatus[torrent];
-
-    const auto update = [torrent, &torrentStatus](const TorrentFilter::Type status, int &counter)
-    {
-        const bool hasStatus = torrentStatus[status];
-        const bool needStatus = TorrentFilter(status).match(torrent);
-        if (needStatus && !hasStatus)
-        {
-            ++counter;
-            torrentStatus.set(status);
-        }
-        else if (!needStatus && hasStatus)
-        {
-            --counter;
-            torrentStatus.reset(status);
-        }
-    };
-
-    update(TorrentFilter::Downloading, m_nbDownloading);
-    update(TorrentFilter::Seeding, m_nbSeeding);
-    update(TorrentFilter::Completed, m_nbCompleted);
-    update(TorrentFilter::Resumed, m_nbResumed);
-    update(TorrentFilter::Paused, m_nbPaused);
-    update(TorrentFilter::Active, m_nbActive);
-    update(TorrentFilter::Inactive, m_nbInactive);
-    update(TorrentFilter::StalledUploading, m_nbStalledUploading);
-    update(TorrentFilter::StalledDownloading, m_nbStalledDownloading);
-    update(TorrentFilter::Checking, m_nbChecking);
-    update(TorrentFilter::Moving, m_nbMoving);
-    update(TorrentFilter::Errored, m_nbErrored);
+    using BitTorrent::TorrentStateFlag;
+
+    const auto *session = BitTorrent::Session::instance();
+    m_nbDownloading = session->stateTorrentsCount(TorrentStateFlag::Downloading);
+    m_nbSeeding = session->stateTorrentsCount(TorrentStateFlag::Seeding);
+    m_nbCompleted = session->stateTorrentsCount(TorrentStateFlag::Completed);
+    m_nbResumed = session->stateTorrentsCount(TorrentStateFlag::Resumed);
+    m_nbPaused = session->stateTorrentsCount(TorrentStateFlag::Paused);
+    m_nbActive = session->stateTorrentsCount(TorrentStateFlag::Active);
+    m_nbInactive = session->stateTorrentsCount(TorrentStateFlag::Inactive);
+    m_nbStalledUploading = session->stateTorrentsCount(TorrentStateFlag::StalledUploading);
+    m_nbStalledDownloading = session->stateTorrentsCount(TorrentStateFlag::StalledDownloading);
+    m_nbChecking = session->stateTorrentsCount(TorrentStateFlag::Checking);
+    m_nbMoving = session->stateTorrentsCount(TorrentStateFlag::Moving);
+    m_nbErrored = session->stateTorrentsCount(TorrentStateFlag::Errored);
 
     m_nbStalled = m_nbStalledUploading + m_nbStalledDownloading;
 }
@@ -199,11 +184,9 @@ void StatusFilterWidget::hideZeroItems()
         setCurrentRow(TorrentFilter::All, QItemSelectionModel::SelectCurrent);
 }
 
-void StatusFilterWidget::update(const QVector<BitTorrent::Torrent *> &torrents)
+void StatusFilterWidget::handleTorrentsUpdated()
 {
-    for (const BitTorrent::Torrent *torrent : torrents)
-        updateTorrentStatus(torrent);
-
+    updateCounters();
     updateTexts();
 
     if (Preferences::instance()->getHideZeroStatusFilters())
@@ -233,45 +216,16 @@ void StatusFilterWidget::applyFilter(int row)
     transferList()->applyStatusFilter(row);
 }
 
-void StatusFilterWidget::handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &torrents)
+void StatusFilterWidget::handleTorrentsLoaded([[maybe_unused]] const QVector<BitTorrent::Torrent *> &torrents)
 {
-    for (const BitTorrent::Torrent *torrent : torrents)
-        updateTorrentStatus(torrent);
-
+    updateCounters();
     updateTexts();
 }
 
-void StatusFilterWidget::torrentAboutToBeDeleted(BitTorrent::Torrent *const torrent)
+void StatusFilterWidget::torrentAboutToBeDeleted([[maybe_unused]] BitTorrent::Torrent *const torrent)
 {
-    const TorrentFilterBitset status = m_torrentsStatus.take(torrent);
-
-    if (status[TorrentFilter::Downloading])
-        --m_nbDownloading;
-    if (status[TorrentFilter::Seeding])
-        --m_nbSeeding;
-    if (status[TorrentFilter::Completed])
-        --m_nbCompleted;
-    if (status[TorrentFilter::Resumed])
-        --m_nbResumed;
-    if (status[TorrentFilter::Paused])
-        --m_nbPaused;
-    if (status[TorrentFilter::Active])
-        --m_nbActive;
-    if (status[TorrentFilter::Inactive])
-        --m_nbInactive;
-    if (status[TorrentFilter::StalledUploading])
-        --m_nbStalledUploading;
-    if (status[TorrentFilter::StalledDownloading])
-        --m_nbStalledDownloading;
-    if (status[TorrentFilter::Checking])
-        --m_nbChecking;
-    if (status[TorrentFilter::Moving])
-        --m_nbMoving;
-    if (status[TorrentFilter::Errored])
-        --m_nbErrored;
-
-    m_nbStalled = m_nbStalledUploading + m_nbStalledDownloading;
-
+    // The torrent is already removed from the session indexes
+    updateCounters();
     updateTexts();
 }
 
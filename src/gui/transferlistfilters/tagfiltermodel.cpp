@@ -202,7 +202,7 @@ void TagFilterModel::tagRemoved(const QString &tag)
 
 void TagFilterModel::torrentTagAdded(BitTorrent::Torrent *const torrent, const QString &tag)
 {
-    if (torrent->tags().count() == 1)
+    if (torrent->tagIDs().size() == 1)
         untaggedItem()->decreaseTorrentsCount();
 
     const int row = findRow(tag);
@@ -216,7 +216,7 @@ void TagFilterModel::torrentTagAdded(BitTorrent::Torrent *const torrent, const Q
 
 void TagFilterModel::torrentTagRemoved(BitTorrent::Torrent *const torrent, const QString &tag)
 {
-    if (torrent->tags().empty())
+    if (torrent->tagIDs().isEmpty())
         untaggedItem()->increaseTorrentsCount();
 
     const int row = findRow(tag);
@@ -248,7 +248,7 @@ void TagFilterModel::torrentAboutToBeRemoved(BitTorrent::Torrent *const torrent)
 {
     allTagsItem()->decreaseTorrentsCount();
 
-    if (torrent->tags().isEmpty())
+    if (torrent->tagIDs().isEmpty())
         untaggedItem()->decreaseTorrentsCount();
 
     for (TagModelItem *item : asConst(findItems(torrent->tags())))
@@ -266,24 +266,15 @@ QString TagFilterModel::tagDisplayName(const QString &tag)
 
 void TagFilterModel::populate()
 {
-    using Torrent = BitTorrent::Torrent;
-
     const auto *session = BitTorrent::Session::instance();
-    const auto torrents = session->torrents();
 
     // All torrents
-    addToModel(getSpecialAllTag(), torrents.count());
+    addToModel(getSpecialAllTag(), session->torrentsCount());
 
-    const int untaggedCount = std::count_if(torrents.cbegin(), torrents.cend(),
-                                             [](Torrent *torrent) { return torrent->tags().isEmpty(); });
-    addToModel(getSpecialUntaggedTag(), untaggedCount);
+    addToModel(getSpecialUntaggedTag(), session->taggedTorrents({}).count());
 
     for (const QString &tag : asConst(session->tags()))
-    {
-        const int count = std::count_if(torrents.cbegin(), torrents.cend(),
-                                        [tag](Torrent *torrent) { return torrent->hasTag(tag); });
-        addToModel(tag, count);
-    }
+        addToModel(tag, session->taggedTorrents(tag).count());
 }
 
 void TagFilterModel::addToModel(const QString &tag, int count)
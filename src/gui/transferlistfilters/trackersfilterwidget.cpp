@@ -34,8 +34,8 @@
 #include <QMenu>
 #include <QUrl>
 
-#include "base/algorithm.h"
 #include "base/bittorrent/session.h"
+#include "base/bittorrent/torrent.h"
 #include "base/global.h"
 #include "base/net/downloadmanager.h"
 #include "base/preferences.h"
@@ -60,18 +60,6 @@ namespace
         return !scheme.isEmpty() ? scheme : u"http"_s;
     }
 
-    QString getHost(const QString &url)
-    {
-        // We want the hostname.
-        // If failed to parse the domain, original input should be returned
-
-        const QString host = QUrl(url).host();
-        if (host.isEmpty())
-            return url;
-
-        return host;
-    }
-
     QString getFaviconHost(const QString &trackerHost)
     {
         if (!QHostAddress(trackerHost).isNull())
@@ -81,6 +69,15 @@ namespace
     }
 
     const QString NULL_HOST = u""_s;
+
+    QSet<BitTorrent::TorrentID> torrentIDs(const QVector<BitTorrent::Torrent *> &torrents)
+    {
+        QSet<BitTorrent::TorrentID> ids;
+        ids.reserve(torrents.size());
+        for (const BitTorrent::Torrent *torrent : torrents)
+            ids.insert(torrent->id());
+        return ids;
+    }
 }
 
 TrackersFilterWidget::TrackersFilterWidget(QWidget *parent, TransferListWidget *transferList, const bool downloadFavicon)
@@ -100,7 +97,7 @@ TrackersFilterWidget::TrackersFilterWidget(QWidget *parent, TransferListWidget *
     warningTracker->setData(Qt::DisplayRole, tr("Warning (0)"));
     warningTracker->setData(Qt::DecorationRole, UIThemeManager::instance()->getIcon(u"tracker-warning"_s, u"dialog-warning"_s));
 
-    m_trackers[NULL_HOST] = {{}, noTracker};
+    m_trackers[NULL_HOST] = noTracker;
 
     handleTorrentsLoaded(BitTorrent::Session::instance()->torrents());
 
@@ -114,107 +111,72 @@ TrackersFilterWidget::~TrackersFilterWidget()
         Utils::Fs::removeFile(iconPath);
 }
 
-void TrackersFilterWidget::addTrackers(const BitTorrent::Torrent *torrent, const QVector<BitTorrent::TrackerEntry> &trackers)
+void TrackersFilterWidget::addTrackers([[maybe_unused]] const BitTorrent::Torrent *torrent, const QVector<BitTorrent::TrackerEntry> &trackers)
 {
-    const BitTorrent::TorrentID torrentID = torrent->id();
     for (const BitTorrent::TrackerEntry &tracker : trackers)
-        addItems(tracker.url, {torrentID});
+        updateItem(tracker.url);
 }
 
 void TrackersFilterWidget::removeTrackers(const BitTorrent::Torrent *torrent, const QStringList &trackers)
 {
     const BitTorrent::TorrentID torrentID = torrent->id();
     for (const QString &tracker : trackers)
-        removeItem(tracker, torrentID);
-}
-
-void TrackersFilterWidget::refreshTrackers(const BitTorrent::Torrent *torrent)
-{
-    const BitTorrent::TorrentID torrentID = torrent->id();
-
-    m_errors.remove(torrentID);
-    m_warnings.remove(torrentID);
-
-    Algorithm::removeIf(m_trackers, [this, &torrentID](const QString &host, TrackerData &trackerData)
     {
-        QSet<BitTorrent::TorrentID> &torrentIDs = trackerData.torrents;
-        if (!torrentIDs.remove(torrentID))
-            return false;
-
-        QListWidgetItem *trackerItem = trackerData.item;
-
-        if (!host.isEmpty() && torrentIDs.isEmpty())
-        {
-            if (currentItem() == trackerItem)
-                setCurrentRow(0, QItemSelectionModel::SelectCurrent);
-            delete trackerItem;
-            return true;
-        }
-
-        trackerItem->setText(u"%1 (%2)"_s.arg((host.isEmpty() ? tr("Trackerless") : host), QString::number(torrentIDs.size())));
-        return false;
-    });
-
-    const QVector<BitTorrent::TrackerEntry> trackerEntries = torrent->trackers();
-    const bool isTrackerless = trackerEntries.isEmpty();
-    if (isTrackerless)
-    {
-        addItems(NULL_HOST, {torrentID});
-    }
-    else
-    {
-        for (const BitTorrent::TrackerEntry &trackerEntry : trackerEntries)
-            addItems(trackerEntry.url, {torrentID});
+        removeTrackerStatus(torrentID, tracker);
+        updateItem(tracker);
     }
-
-    updateGeometry();
 }
 
-void TrackersFilterWidget::changeTrackerless(const BitTorrent::Torrent *torrent, const bool trackerless)
+void TrackersFilterWidget::changeTrackerless([[maybe_unused]] const BitTorrent::Torrent *torrent, [[maybe_unused]] const bool trackerless)
 {
-    if (trackerless)
-        addItems(NULL_HOST, {torrent->id()});
-    else
-        removeItem(NULL_HOST, torrent->id());
+    updateItem(NULL_HOST);
 }
 
-void TrackersFilterWidget::addItems(const QString &trackerURL, const QVector<BitTorrent::TorrentID> &torrents)
+void TrackersFilterWidget::updateItem(const QString &trackerURL)
 {
-    const QString host = getHost(trackerURL);
-    auto trackersIt = m_trackers.find(host);
-    const bool exists = (trackersIt != m_trackers.end());
-    QListWidgetItem *trackerItem = nullptr;
+    // The torrents are counted by the session, so only the item itself is maintained here
+    const auto *session = BitTorrent::Session::instance();
+    const QString host = trackerURL.isEmpty() ? NULL_HOST : session->trackerHost(trackerURL);
+    const qsizetype torrentsCount = session->trackerHostTorrentsCount(host);
 
-    if (exists)
+    QListWidgetItem *trackerItem = m_trackers.value(host);
+    if (host == NULL_HOST)
     {
-        trackerItem = trackersIt->item;
+        trackerItem->setText(tr("Trackerless (%1)").arg(torrentsCount));
+        if (currentItem() == trackerItem)
+            applyFilter(currentRow());
+        return;
     }
-    else
-    {
-        trackerItem = new QListWidgetItem();
-        trackerItem->setData(Qt::DecorationRole, UIThemeManager::instance()->getIcon(u"trackers"_s, u"network-server"_s));
-
-        const TrackerData trackerData {{}, trackerItem};
-        trackersIt = m_trackers.insert(host, trackerData);
 
-        const QString scheme = getScheme(trackerURL);
-        downloadFavicon(host, u"%1://%2/favicon.ico"_s.arg((scheme.startsWith(u"http") ? scheme : u"http"_s), getFaviconHost(host)));
+    if (torrentsCount == 0)
+    {
+        if (trackerItem)
+        {
+            if (currentItem() == trackerItem)
+                setCurrentRow(0, QItemSelectionModel::SelectCurrent);
+            delete trackerItem;
+            m_trackers.remove(host);
+            updateGeometry();
+        }
+        return;
     }
 
-    Q_ASSERT(trackerItem);
-
-    QSet<BitTorrent::TorrentID> &torrentIDs = trackersIt->torrents;
-    for (const BitTorrent::TorrentID &torrentID : torrents)
-        torrentIDs.insert(torrentID);
-
-    trackerItem->setText(u"%1 (%2)"_s.arg(((host == NULL_HOST) ? tr("Trackerless") : host), QString::number(torrentIDs.size())));
-    if (exists)
+    if (trackerItem)
     {
-        if (item(currentRow()) == trackerItem)
+        trackerItem->setText(u"%1 (%2)"_s.arg(host, QString::number(torrentsCount)));
+        if (currentItem() == trackerItem)
             applyFilter(currentRow());
         return;
     }
 
+    trackerItem = new QListWidgetItem();
+    trackerItem->setData(Qt::DecorationRole, UIThemeManager::instance()->getIcon(u"trackers"_s, u"network-server"_s));
+    trackerItem->setText(u"%1 (%2)"_s.arg(host, QString::number(torrentsCount)));
+    m_trackers.insert(host, trackerItem);
+
+    const QString scheme = getScheme(trackerURL);
+    downloadFavicon(host, u"%1://%2/favicon.ico"_s.arg((scheme.startsWith(u"http") ? scheme : u"http"_s), getFaviconHost(host)));
+
     Q_ASSERT(count() >= 4);
     const Utils::Compare::NaturalLessThan<Qt::CaseSensitive> naturalLessThan {};
     int insPos = count();
@@ -230,71 +192,36 @@ void TrackersFilterWidget::addItems(const QString &trackerURL, const QVector<Bit
     updateGeometry();
 }
 
-void TrackersFilterWidget::removeItem(const QString &trackerURL, const BitTorrent::TorrentID &id)
+void TrackersFilterWidget::removeTrackerStatus(const BitTorrent::TorrentID &id, const QString &trackerURL)
 {
-    const QString host = getHost(trackerURL);
-
-    QSet<BitTorrent::TorrentID> torrentIDs = m_trackers.value(host).torrents;
-    torrentIDs.remove(id);
-
-    QListWidgetItem *trackerItem = nullptr;
-
-    if (!host.isEmpty())
+    // Remove from 'Error' and 'Warning' view
+    const auto errorHashesIt = m_errors.find(id);
+    if (errorHashesIt != m_errors.end())
     {
-        // Remove from 'Error' and 'Warning' view
-        const auto errorHashesIt = m_errors.find(id);
-        if (errorHashesIt != m_errors.end())
+        QSet<QString> &errored = errorHashesIt.value();
+        errored.remove(trackerURL);
+        if (errored.isEmpty())
         {
-            QSet<QString> &errored = errorHashesIt.value();
-            errored.remove(trackerURL);
-            if (errored.isEmpty())
-            {
-                m_errors.erase(errorHashesIt);
-                item(ERROR_ROW)->setText(tr("Error (%1)").arg(m_errors.size()));
-                if (currentRow() == ERROR_ROW)
-                    applyFilter(ERROR_ROW);
-            }
-        }
-
-        const auto warningHashesIt = m_warnings.find(id);
-        if (warningHashesIt != m_warnings.end())
-        {
-            QSet<QString> &warned = *warningHashesIt;
-            warned.remove(trackerURL);
-            if (warned.isEmpty())
-            {
-                m_warnings.erase(warningHashesIt);
-                item(WARNING_ROW)->setText(tr("Warning (%1)").arg(m_warnings.size()));
-                if (currentRow() == WARNING_ROW)
-                    applyFilter(WARNING_ROW);
-            }
+            m_errors.erase(errorHashesIt);
+            item(ERROR_ROW)->setText(tr("Error (%1)").arg(m_errors.size()));
+            if (currentRow() == ERROR_ROW)
+                applyFilter(ERROR_ROW);
         }
+    }
 
-        trackerItem = m_trackers.value(host).item;
-
-        if (torrentIDs.isEmpty())
+    const auto warningHashesIt = m_warnings.find(id);
+    if (warningHashesIt != m_warnings.end())
+    {
+        QSet<QString> &warned = *warningHashesIt;
+        warned.remove(trackerURL);
+        if (warned.isEmpty())
         {
-            if (currentItem() == trackerItem)
-                setCurrentRow(0, QItemSelectionModel::SelectCurrent);
-            delete trackerItem;
-            m_trackers.remove(host);
-            updateGeometry();
-            return;
+            m_warnings.erase(warningHashesIt);
+            item(WARNING_ROW)->setText(tr("Warning (%1)").arg(m_warnings.size()));
+            if (currentRow() == WARNING_ROW)
+                applyFilter(WARNING_ROW);
         }
-
-        if (trackerItem)
-            trackerItem->setText(u"%1 (%2)"_s.arg(host, QString::number(torrentIDs.size())));
     }
-    else
-    {
-        trackerItem = item(TRACKERLESS_ROW);
-        trackerItem->setText(tr("Trackerless (%1)").arg(torrentIDs.size()));
-    }
-
-    m_trackers.insert(host, {torrentIDs, trackerItem});
-
-    if (currentItem() == trackerItem)
-        applyFilter(currentRow());
 }
 
 void TrackersFilterWidget::setDownloadTrackerFavicon(bool value)
@@ -437,7 +364,7 @@ void TrackersFilterWidget::handleFavicoDownloadFinished(const Net::DownloadResul
 
         matchedTrackerFound = true;
 
-        QListWidgetItem *trackerItem = item(rowFromTracker(trackerHost));
+        QListWidgetItem *trackerItem = m_trackers.value(trackerHost);
         Q_ASSERT(trackerItem);
         if (!trackerItem) [[unlikely]]
             continue;
@@ -476,25 +403,18 @@ void TrackersFilterWidget::applyFilter(const int row)
 
 void TrackersFilterWidget::handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &torrents)
 {
-    QHash<QString, QVector<BitTorrent::TorrentID>> torrentsPerTracker;
+    // The items are updated once per tracker host
+    const auto *session = BitTorrent::Session::instance();
+    QHash<QString, QString> trackerURLs;  // <tracker host, tracker URL>
     for (const BitTorrent::Torrent *torrent : torrents)
     {
-        const BitTorrent::TorrentID torrentID = torrent->id();
-        const QVector<BitTorrent::TrackerEntry> trackers = torrent->trackers();
-        for (const BitTorrent::TrackerEntry &tracker : trackers)
-            torrentsPerTracker[tracker.url].append(torrentID);
-
-        // Check for trackerless torrent
-        if (trackers.isEmpty())
-            torrentsPerTracker[NULL_HOST].append(torrentID);
+        for (const BitTorrent::TrackerEntry &tracker : asConst(torrent->trackers()))
+            trackerURLs.insert(session->trackerHost(tracker.url), tracker.url);
     }
 
-    for (auto it = torrentsPerTracker.cbegin(); it != torrentsPerTracker.cend(); ++it)
-    {
-        const QString &trackerURL = it.key();
-        const QVector<BitTorrent::TorrentID> &torrents = it.value();
-        addItems(trackerURL, torrents);
-    }
+    for (const QString &trackerURL : asConst(trackerURLs))
+        updateItem(trackerURL);
+    updateItem(NULL_HOST);
 
     m_totalTorrents += torrents.count();
     item(ALL_ROW)->setText(tr("All (%1)", "this is for the tracker filter").arg(m_totalTorrents));
@@ -502,14 +422,18 @@ void TrackersFilterWidget::handleTorrentsLoaded(const QVector<BitTorrent::Torren
 
 void TrackersFilterWidget::torrentAboutToBeDeleted(BitTorrent::Torrent *const torrent)
 {
+    // The torrent is already removed from the session index at this point
     const BitTorrent::TorrentID torrentID = torrent->id();
     const QVector<BitTorrent::TrackerEntry> trackers = torrent->trackers();
     for (const BitTorrent::TrackerEntry &tracker : trackers)
-        removeItem(tracker.url, torrentID);
+    {
+        removeTrackerStatus(torrentID, tracker.url);
+        updateItem(tracker.url);
+    }
 
     // Check for trackerless torrent
     if (trackers.isEmpty())
-        removeItem(NULL_HOST, torrentID);
+        updateItem(NULL_HOST);
 
     item(ALL_ROW)->setText(tr("All (%1)", "this is for the tracker filter").arg(--m_totalTorrents));
 }
@@ -524,28 +448,17 @@ QString TrackersFilterWidget::trackerFromRow(int row) const
     return parts.join(u' ');
 }
 
-int TrackersFilterWidget::rowFromTracker(const QString &tracker) const
-{
-    Q_ASSERT(!tracker.isEmpty());
-    for (int i = 4; i < count(); ++i)
-    {
-        if (tracker == trackerFromRow(i))
-            return i;
-    }
-    return -1;
-}
-
 QSet<BitTorrent::TorrentID> TrackersFilterWidget::getTorrentIDs(const int row) const
 {
     switch (row)
     {
     case TRACKERLESS_ROW:
-        return m_trackers.value(NULL_HOST).torrents;
+        return torrentIDs(BitTorrent::Session::instance()->trackerHostTorrents(NULL_HOST));
     case ERROR_ROW:
         return {m_errors.keyBegin(), m_errors.keyEnd()};
     case WARNING_ROW:
         return {m_warnings.keyBegin(), m_warnings.keyEnd()};
     default:
-        return m_trackers.value(trackerFromRow(row)).torrents;
+        return torrentIDs(BitTorrent::Session::instance()->trackerHostTorrents(trackerFromRow(row)));
     }
 }
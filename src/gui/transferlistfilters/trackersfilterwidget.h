@@ -54,7 +54,6 @@ public:
 
     void addTrackers(const BitTorrent::Torrent *torrent, const QVector<BitTorrent::TrackerEntry> &trackers);
     void removeTrackers(const BitTorrent::Torrent *torrent, const QStringList &trackers);
-    void refreshTrackers(const BitTorrent::Torrent *torrent);
     void changeTrackerless(const BitTorrent::Torrent *torrent, bool trackerless);
     void handleTrackerEntriesUpdated(const BitTorrent::Torrent *torrent
             , const QHash<QString, BitTorrent::TrackerEntry> &updatedTrackerEntries);
@@ -71,20 +70,14 @@ private:
     void handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &torrents) override;
     void torrentAboutToBeDeleted(BitTorrent::Torrent *torrent) override;
 
-    void addItems(const QString &trackerURL, const QVector<BitTorrent::TorrentID> &torrents);
-    void removeItem(const QString &trackerURL, const BitTorrent::TorrentID &id);
+    // Empty tracker URL means the trackerless item
+    void updateItem(const QString &trackerURL);
+    void removeTrackerStatus(const BitTorrent::TorrentID &id, const QString &trackerURL);
     QString trackerFromRow(int row) const;
-    int rowFromTracker(const QString &tracker) const;
     QSet<BitTorrent::TorrentID> getTorrentIDs(int row) const;
     void downloadFavicon(const QString &trackerHost, const QString &faviconURL);
 
-    struct TrackerData
-    {
-        QSet<BitTorrent::TorrentID> torrents;
-        QListWidgetItem *item = nullptr;
-    };
-
-    QHash<QString, TrackerData> m_trackers;   // <tracker host, tracker data>
+    QHash<QString, QListWidgetItem *> m_trackers;   // <tracker host, item>
     QHash<BitTorrent::TorrentID, QSet<QString>> m_errors;  // <torrent ID, tracker hosts>
     QHash<BitTorrent::TorrentID, QSet<QString>> m_warnings;  // <torrent ID, tracker hosts>
     PathList m_iconPaths;
@@ -186,11 +186,6 @@ void TransferListFiltersWidget::removeTrackers(const BitTorrent::Torrent *torren
     m_trackersFilterWidget->removeTrackers(torrent, trackers);
 }
 
-void TransferListFiltersWidget::refreshTrackers(const BitTorrent::Torrent *torrent)
-{
-    m_trackersFilterWidget->refreshTrackers(torrent);
-}
-
 void TransferListFiltersWidget::changeTrackerless(const BitTorrent::Torrent *torrent, const bool trackerless)
 {
     m_trackersFilterWidget->changeTrackerless(torrent, trackerless);
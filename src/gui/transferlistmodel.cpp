@@ -29,9 +29,12 @@
 
 #include "transferlistmodel.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QDateTime>
 #include <QDebug>
+#include <QMap>
 
 #include "base/bittorrent/infohash.h"
 #include "base/bittorrent/session.h"
@@ -126,6 +129,12 @@ TransferListModel::TransferListModel(QObject *parent)
     configure();
     connect(Preferences::instance(), &Preferences::changed, this, &TransferListModel::configure);
 
+    QList<int> allColumns;
+    allColumns.reserve(NB_COLUMNS);
+    for (int column = 0; column < NB_COLUMNS; ++column)
+        allColumns.append(column);
+    setWatchedColumns(allColumns);
+
     // Load the torrents
     using namespace BitTorrent;
     addTorrents(Session::instance()->torrents());
@@ -587,10 +596,13 @@ bool TransferListModel::setData(const QModelIndex &index, const QVariant &value,
 
 void TransferListModel::addTorrents(const QVector<BitTorrent::Torrent *> &torrents)
 {
+    if (torrents.isEmpty())
+        return;
+
     qsizetype row = m_torrentList.size();
     const qsizetype total = row + torrents.size();
 
-    beginInsertRows({}, row, total);
+    beginInsertRows({}, row, (total - 1));
 
     m_torrentList.reserve(total);
     for (BitTorrent::Torrent *torrent : torrents)
@@ -599,6 +611,7 @@ void TransferListModel::addTorrents(const QVector<BitTorrent::Torrent *> &torren
 
         m_torrentList.append(torrent);
         m_torrentMap[torrent] = row++;
+        updateColumnValues(torrent);
     }
 
     endInsertRows();
@@ -619,6 +632,65 @@ BitTorrent::Torrent *TransferListModel::torrentHandle(const QModelIndex &index)
     return m_torrentList.value(index.row());
 }
 
+void TransferListModel::setWatchedColumns(const QList<int> &columns)
+{
+    QList<int> watchedColumns = columns;
+    // Torrent filters depend on these columns, so their changes are always reported
+    watchedColumns.append({TR_STATUS, TR_UPSPEED, TR_CATEGORY, TR_TAGS});
+    std::sort(watchedColumns.begin(), watchedColumns.end());
+    watchedColumns.erase(std::unique(watchedColumns.begin(), watchedColumns.end()), watchedColumns.end());
+
+    if (watchedColumns == m_watchedColumns)
+        return;
+
+    m_watchedColumns = watchedColumns;
+
+    // Columns that become watched are fetched by the view anyway, so there is nothing to report
+    m_columnValues.clear();
+    for (BitTorrent::Torrent *const torrent : asConst(m_torrentList))
+        updateColumnValues(torrent);
+}
+
+QVariant TransferListModel::columnValue(const BitTorrent::Torrent *torrent, const int column) const
+{
+    switch (column)
+    {
+    case TR_STATUS:
+        return QVariantList {internalValue(torrent, column, false), torrent->error()};
+    case TR_PEERS:
+    case TR_SEEDS:
+    case TR_TIME_ELAPSED:
+        return QVariantList {internalValue(torrent, column, false), internalValue(torrent, column, true)};
+    default:
+        return internalValue(torrent, column, false);
+    }
+}
+
+TransferListModel::ColumnSet TransferListModel::updateColumnValues(BitTorrent::Torrent *const torrent)
+{
+    ColumnSet changedColumns;
+
+    QVariantList &values = m_columnValues[torrent];
+    const bool isNew = values.isEmpty();
+    values.resize(m_watchedColumns.size());
+    for (qsizetype i = 0; i < m_watchedColumns.size(); ++i)
+    {
+        const int column = m_watchedColumns[i];
+        QVariant value = columnValue(torrent, column);
+        if (isNew || (value != values[i]))
+        {
+            values[i] = std::move(value);
+            changedColumns.set(column);
+        }
+    }
+
+    // Row color and icon as well as hiding of zero values depend on torrent state
+    if (changedColumns.test(TR_STATUS))
+        changedColumns.set();
+
+    return changedColumns;
+}
+
 void TransferListModel::handleTorrentAboutToBeRemoved(BitTorrent::Torrent *const torrent)
 {
     const int row = m_torrentMap.value(torrent, -1);
@@ -627,6 +699,7 @@ void TransferListModel::handleTorrentAboutToBeRemoved(BitTorrent::Torrent *const
     beginRemoveRows({}, row, row);
     m_torrentList.removeAt(row);
     m_torrentMap.remove(torrent);
+    m_columnValues.remove(torrent);
     for (int &value : m_torrentMap)
     {
         if (value > row)
@@ -640,28 +713,62 @@ void TransferListModel::handleTorrentStatusUpdated(BitTorrent::Torrent *const to
     const int row = m_torrentMap.value(torrent, -1);
     Q_ASSERT(row >= 0);
 
+    updateColumnValues(torrent);
     emit dataChanged(index(row, 0), index(row, columnCount() - 1));
 }
 
 void TransferListModel::handleTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents)
 {
-    const int columns = (columnCount() - 1);
+    QMap<int, ColumnSet> changedRows;
+    for (BitTorrent::Torrent *const torrent : torrents)
+    {
+        const int row = m_torrentMap.value(torrent, -1);
+        Q_ASSERT(row >= 0);
 
-    if (torrents.size() <= (m_torrentList.size() * 0.5))
+        const ColumnSet changedColumns = updateColumnValues(torrent);
+        if (changedColumns.any())
+            changedRows.insert(row, changedColumns);
+    }
+
+    // Report each contiguous range of changed columns, so the views and proxies
+    // (e.g. sort model) don't have to process the columns that aren't changed
+    const auto reportChanges = [this](const int firstRow, const int lastRow, const ColumnSet &columns)
     {
-        for (BitTorrent::Torrent *const torrent : torrents)
+        for (int column = 0; column < NB_COLUMNS; ++column)
         {
-            const int row = m_torrentMap.value(torrent, -1);
-            Q_ASSERT(row >= 0);
+            if (!columns.test(column))
+                continue;
+
+            const int firstColumn = column;
+            while (((column + 1) < NB_COLUMNS) && columns.test(column + 1))
+                ++column;
 
-            emit dataChanged(index(row, 0), index(row, columns));
+            emit dataChanged(index(firstRow, firstColumn), index(lastRow, column));
         }
-    }
-    else
+    };
+
+    // Adjacent rows having the same changed columns are reported together
+    int firstRow = -1;
+    int lastRow = -1;
+    ColumnSet columns;
+    for (auto it = changedRows.cbegin(); it != changedRows.cend(); ++it)
     {
-        // save the overhead when more than half of the torrent list needs update
-        emit dataChanged(index(0, 0), index((rowCount() - 1), columns));
+        if ((it.key() == (lastRow + 1)) && (it.value() == columns))
+        {
+            lastRow = it.key();
+            continue;
+        }
+
+        if (firstRow >= 0)
+            reportChanges(firstRow, lastRow, columns);
+
+        firstRow = it.key();
+        lastRow = it.key();
+        columns = it.value();
     }
+
+    if (firstRow >= 0)
+        reportChanges(firstRow, lastRow, columns);
 }
 
 void TransferListModel::configure()
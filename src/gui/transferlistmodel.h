@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <bitset>
+
 #include <QAbstractListModel>
 #include <QColor>
 #include <QHash>
@@ -105,6 +107,10 @@ public:
 
     BitTorrent::Torrent *torrentHandle(const QModelIndex &index) const;
 
+    // Only changes of watched columns (and the columns the torrent filters depend on)
+    // are reported when torrents are updated
+    void setWatchedColumns(const QList<int> &columns);
+
 private slots:
     void addTorrents(const QVector<BitTorrent::Torrent *> &torrents);
     void handleTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent);
@@ -112,13 +118,19 @@ private slots:
     void handleTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents);
 
 private:
+    using ColumnSet = std::bitset<NB_COLUMNS>;
+
     void configure();
+    QVariant columnValue(const BitTorrent::Torrent *torrent, int column) const;
+    ColumnSet updateColumnValues(BitTorrent::Torrent *torrent);
     QString displayValue(const BitTorrent::Torrent *torrent, int column) const;
     QVariant internalValue(const BitTorrent::Torrent *torrent, int column, bool alt) const;
     QIcon getIconByState(BitTorrent::TorrentState state) const;
 
     QList<BitTorrent::Torrent *> m_torrentList;  // maps row number to torrent handle
     QHash<BitTorrent::Torrent *, int> m_torrentMap;  // maps torrent handle to row number
+    QList<int> m_watchedColumns;
+    QHash<BitTorrent::Torrent *, QVariantList> m_columnValues;  // last reported values of watched columns
     const QHash<BitTorrent::TorrentState, QString> m_statusStrings;
     // row text colors
     const QHash<BitTorrent::TorrentState, QColor> m_stateThemeColors;
@@ -28,6 +28,7 @@
 
 #include "transferlistsortmodel.h"
 
+#include <algorithm>
 #include <type_traits>
 
 #include <QDateTime>
@@ -46,17 +47,8 @@ namespace
         return (left < right) ? -1 : 1;
     }
 
-    int customCompare(const QDateTime &left, const QDateTime &right)
-    {
-        const bool isLeftValid = left.isValid();
-        const bool isRightValid = right.isValid();
-
-        if (isLeftValid == isRightValid)
-            return threeWayCompare(left, right);
-        return isLeftValid ? -1 : 1;
-    }
-
-    int customCompare(const TagSet &left, const TagSet &right, const Utils::Compare::NaturalCompare<Qt::CaseInsensitive> &compare)
+    template <typename Key>
+    int customCompare(const QList<Key> &left, const QList<Key> &right, const Utils::Compare::NaturalCompare<Qt::CaseInsensitive> &compare)
     {
         for (auto leftIter = left.cbegin(), rightIter = right.cbegin();
             (leftIter != left.cend()) && (rightIter != right.cend());
@@ -99,6 +91,31 @@ TransferListSortModel::TransferListSortModel(QObject *parent)
     setSortRole(TransferListModel::UnderlyingDataRole);
 }
 
+void TransferListSortModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (QAbstractItemModel *oldModel = this->sourceModel())
+    {
+        disconnect(oldModel, &QAbstractItemModel::dataChanged, this, &TransferListSortModel::handleSourceDataChanged);
+        disconnect(oldModel, &QAbstractItemModel::rowsInserted, this, &TransferListSortModel::handleSourceRowsInserted);
+        disconnect(oldModel, &QAbstractItemModel::rowsRemoved, this, &TransferListSortModel::handleSourceRowsRemoved);
+        disconnect(oldModel, &QAbstractItemModel::modelReset, this, &TransferListSortModel::rebuildSortKeys);
+        disconnect(oldModel, &QAbstractItemModel::layoutChanged, this, &TransferListSortModel::rebuildSortKeys);
+    }
+
+    // Connect before the base class does so the sort keys are up to date when it re-sorts affected rows
+    if (sourceModel)
+    {
+        connect(sourceModel, &QAbstractItemModel::dataChanged, this, &TransferListSortModel::handleSourceDataChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &TransferListSortModel::handleSourceRowsInserted);
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &TransferListSortModel::handleSourceRowsRemoved);
+        connect(sourceModel, &QAbstractItemModel::modelReset, this, &TransferListSortModel::rebuildSortKeys);
+        connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &TransferListSortModel::rebuildSortKeys);
+    }
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+    rebuildSortKeys();
+}
+
 void TransferListSortModel::sort(const int column, const Qt::SortOrder order)
 {
     if ((m_lastSortColumn != column) && (m_lastSortColumn != -1))
@@ -109,9 +126,15 @@ void TransferListSortModel::sort(const int column, const Qt::SortOrder order)
     m_lastSortColumn = column;
     m_lastSortOrder = ((order == Qt::AscendingOrder) ? 0 : 1);
 
+    rebuildSortKeys();
     QSortFilterProxyModel::sort(column, order);
 }
 
+int TransferListSortModel::subSortColumn() const
+{
+    return m_subSortColumn.get();
+}
+
 void TransferListSortModel::setStatusFilter(TorrentFilter::Type filter)
 {
     if (m_filter.setType(filter))
@@ -154,77 +177,261 @@ void TransferListSortModel::disableTrackerFilter()
         invalidateFilter();
 }
 
-int TransferListSortModel::compare(const QModelIndex &left, const QModelIndex &right) const
+TransferListSortModel::SortKey TransferListSortModel::makeSortKey(const BitTorrent::Torrent *torrent, const int column) const
 {
-    const int compareColumn = left.column();
-    const QVariant leftValue = left.data(TransferListModel::UnderlyingDataRole);
-    const QVariant rightValue = right.data(TransferListModel::UnderlyingDataRole);
+    if (!torrent)
+        return {};
+
+    const auto dateSortKey = [](const QDateTime &dateTime) -> qint64
+    {
+        // invalid dates are placed after valid ones the same way as negative numbers
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : -1;
+    };
 
-    switch (compareColumn)
+    switch (column)
     {
     case TransferListModel::TR_CATEGORY:
+        return m_naturalCompare.sortKey(torrent->category());
     case TransferListModel::TR_DOWNLOAD_PATH:
+        return m_naturalCompare.sortKey(torrent->downloadPath().data());
     case TransferListModel::TR_NAME:
+        return m_naturalCompare.sortKey(torrent->name());
     case TransferListModel::TR_SAVE_PATH:
+        return m_naturalCompare.sortKey(torrent->savePath().data());
     case TransferListModel::TR_TRACKER:
-        return m_naturalCompare(leftValue.toString(), rightValue.toString());
+        return m_naturalCompare.sortKey(torrent->currentTracker());
 
     case TransferListModel::TR_INFOHASH_V1:
-        return threeWayCompare(leftValue.value<SHA1Hash>(), rightValue.value<SHA1Hash>());
-
+        return torrent->infoHash().v1();
     case TransferListModel::TR_INFOHASH_V2:
-        return threeWayCompare(leftValue.value<SHA256Hash>(), rightValue.value<SHA256Hash>());
+        return torrent->infoHash().v2();
 
     case TransferListModel::TR_TAGS:
-        return customCompare(leftValue.value<TagSet>(), rightValue.value<TagSet>(), m_naturalCompare);
+        {
+            const TagSet &tags = torrent->tags();
+            QList<NaturalSortKey> tagKeys;
+            tagKeys.reserve(tags.size());
+            for (const QString &tag : tags)
+                tagKeys.append(m_naturalCompare.sortKey(tag));
+            return tagKeys;
+        }
 
     case TransferListModel::TR_AMOUNT_DOWNLOADED:
+        return qint64 {torrent->totalDownload()};
     case TransferListModel::TR_AMOUNT_DOWNLOADED_SESSION:
+        return qint64 {torrent->totalPayloadDownload()};
     case TransferListModel::TR_AMOUNT_LEFT:
+        return qint64 {torrent->remainingSize()};
     case TransferListModel::TR_AMOUNT_UPLOADED:
+        return qint64 {torrent->totalUpload()};
     case TransferListModel::TR_AMOUNT_UPLOADED_SESSION:
+        return qint64 {torrent->totalPayloadUpload()};
     case TransferListModel::TR_COMPLETED:
+        return qint64 {torrent->completedSize()};
     case TransferListModel::TR_ETA:
+        return qint64 {torrent->eta()};
     case TransferListModel::TR_LAST_ACTIVITY:
+        return qint64 {torrent->timeSinceActivity()};
     case TransferListModel::TR_SIZE:
+        return qint64 {torrent->wantedSize()};
     case TransferListModel::TR_TIME_ELAPSED:
+        return qint64 {torrent->activeTime()};
     case TransferListModel::TR_TOTAL_SIZE:
-        return customCompare(leftValue.toLongLong(), rightValue.toLongLong());
+        return qint64 {torrent->totalSize()};
 
     case TransferListModel::TR_AVAILABILITY:
+        return qreal {torrent->distributedCopies()};
     case TransferListModel::TR_PROGRESS:
+        return qreal {torrent->progress()};
     case TransferListModel::TR_RATIO:
+        return qreal {torrent->realRatio()};
     case TransferListModel::TR_RATIO_LIMIT:
-        return customCompare(leftValue.toReal(), rightValue.toReal());
+        return qreal {torrent->maxRatio()};
 
     case TransferListModel::TR_STATUS:
-        return threeWayCompare(leftValue.toInt(), rightValue.toInt());
+        return static_cast<qint64>(torrent->state());
 
     case TransferListModel::TR_ADD_DATE:
+        return dateSortKey(torrent->addedTime());
     case TransferListModel::TR_SEED_DATE:
+        return dateSortKey(torrent->completedTime());
     case TransferListModel::TR_SEEN_COMPLETE_DATE:
-        return customCompare(leftValue.toDateTime(), rightValue.toDateTime());
+        return dateSortKey(torrent->lastSeenComplete());
 
     case TransferListModel::TR_DLLIMIT:
+        return qint64 {torrent->downloadLimit()};
     case TransferListModel::TR_DLSPEED:
+        return qint64 {torrent->downloadPayloadRate()};
     case TransferListModel::TR_QUEUE_POSITION:
+        return qint64 {torrent->queuePosition()};
     case TransferListModel::TR_UPLIMIT:
+        return qint64 {torrent->uploadLimit()};
     case TransferListModel::TR_UPSPEED:
-        return customCompare(leftValue.toInt(), rightValue.toInt());
+        return qint64 {torrent->uploadPayloadRate()};
 
     case TransferListModel::TR_PEERS:
+        return std::pair {torrent->leechsCount(), torrent->totalLeechersCount()};
     case TransferListModel::TR_SEEDS:
-        {
-            // Active peers/seeds take precedence over total peers/seeds
-            const auto activeL = leftValue.toInt();
-            const auto activeR = rightValue.toInt();
-            if (activeL != activeR)
-                return threeWayCompare(activeL, activeR);
-
-            const auto totalL = left.data(TransferListModel::AdditionalUnderlyingDataRole).toInt();
-            const auto totalR = right.data(TransferListModel::AdditionalUnderlyingDataRole).toInt();
-            return threeWayCompare(totalL, totalR);
-        }
+        return std::pair {torrent->seedsCount(), torrent->totalSeedsCount()};
+
+    default:
+        Q_ASSERT_X(false, Q_FUNC_INFO, "Missing sort key case");
+        break;
+    }
+
+    return {};
+}
+
+TransferListSortModel::SortKey TransferListSortModel::makeSortKey(const int sourceRow, const int column) const
+{
+    const auto *model = qobject_cast<TransferListModel *>(sourceModel());
+    if (!model) return {};
+
+    return makeSortKey(model->torrentHandle(model->index(sourceRow)), column);
+}
+
+void TransferListSortModel::rebuildSortKeys()
+{
+    m_sortKeysColumn = m_lastSortColumn;
+    fillSortKeys(m_sortKeys, m_sortKeysColumn);
+
+    m_subSortKeysColumn = (m_subSortColumn != m_sortKeysColumn) ? m_subSortColumn.get() : -1;
+    fillSortKeys(m_subSortKeys, m_subSortKeysColumn);
+}
+
+void TransferListSortModel::fillSortKeys(QList<SortKey> &keys, const int column) const
+{
+    keys.clear();
+
+    const auto *model = qobject_cast<TransferListModel *>(sourceModel());
+    if (!model || (column < 0))
+        return;
+
+    const int rowCount = model->rowCount();
+    keys.reserve(rowCount);
+    for (int row = 0; row < rowCount; ++row)
+        keys.append(makeSortKey(model->torrentHandle(model->index(row)), column));
+}
+
+void TransferListSortModel::handleSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    // Keys are updated before the base class reacts to the change so it sorts the changed rows by actual keys
+    const auto updateKeys = [this, &topLeft, &bottomRight](QList<SortKey> &keys, const int column)
+    {
+        if ((column < topLeft.column()) || (column > bottomRight.column()))
+            return;
+
+        for (int row = topLeft.row(); (row <= bottomRight.row()) && (row < keys.size()); ++row)
+            keys[row] = makeSortKey(row, column);
+    };
+
+    updateKeys(m_sortKeys, m_sortKeysColumn);
+    updateKeys(m_subSortKeys, m_subSortKeysColumn);
+}
+
+void TransferListSortModel::handleSourceRowsInserted([[maybe_unused]] const QModelIndex &parent, const int first, const int last)
+{
+    const auto insertKeys = [this, first, last](QList<SortKey> &keys, const int column)
+    {
+        if (column < 0)
+            return;
+
+        keys.insert(first, ((last - first) + 1), SortKey {});
+        for (int row = first; row <= last; ++row)
+            keys[row] = makeSortKey(row, column);
+    };
+
+    insertKeys(m_sortKeys, m_sortKeysColumn);
+    insertKeys(m_subSortKeys, m_subSortKeysColumn);
+}
+
+void TransferListSortModel::handleSourceRowsRemoved([[maybe_unused]] const QModelIndex &parent, const int first, const int last)
+{
+    const auto removeKeys = [first, last](QList<SortKey> &keys)
+    {
+        if (first < keys.size())
+            keys.remove(first, (std::min<qsizetype>(last, (keys.size() - 1)) - first) + 1);
+    };
+
+    removeKeys(m_sortKeys);
+    removeKeys(m_subSortKeys);
+}
+
+int TransferListSortModel::compare(const int column, const int leftRow, const int rightRow) const
+{
+    if (column == m_sortKeysColumn)
+    {
+        Q_ASSERT((leftRow < m_sortKeys.size()) && (rightRow < m_sortKeys.size()));
+        return compareSortKeys(column, m_sortKeys[leftRow], m_sortKeys[rightRow]);
+    }
+
+    if (column == m_subSortKeysColumn)
+    {
+        Q_ASSERT((leftRow < m_subSortKeys.size()) && (rightRow < m_subSortKeys.size()));
+        return compareSortKeys(column, m_subSortKeys[leftRow], m_subSortKeys[rightRow]);
+    }
+
+    return compareSortKeys(column, makeSortKey(leftRow, column), makeSortKey(rightRow, column));
+}
+
+int TransferListSortModel::compareSortKeys(const int column, const SortKey &left, const SortKey &right) const
+{
+    // keys of removed torrents are empty
+    if (std::holds_alternative<std::monostate>(left) || std::holds_alternative<std::monostate>(right))
+        return threeWayCompare(left.index(), right.index());
+
+    switch (column)
+    {
+    case TransferListModel::TR_CATEGORY:
+    case TransferListModel::TR_DOWNLOAD_PATH:
+    case TransferListModel::TR_NAME:
+    case TransferListModel::TR_SAVE_PATH:
+    case TransferListModel::TR_TRACKER:
+        return m_naturalCompare(std::get<NaturalSortKey>(left), std::get<NaturalSortKey>(right));
+
+    case TransferListModel::TR_INFOHASH_V1:
+        return threeWayCompare(std::get<SHA1Hash>(left), std::get<SHA1Hash>(right));
+
+    case TransferListModel::TR_INFOHASH_V2:
+        return threeWayCompare(std::get<SHA256Hash>(left), std::get<SHA256Hash>(right));
+
+    case TransferListModel::TR_TAGS:
+        return customCompare(std::get<QList<NaturalSortKey>>(left), std::get<QList<NaturalSortKey>>(right), m_naturalCompare);
+
+    case TransferListModel::TR_ADD_DATE:
+    case TransferListModel::TR_AMOUNT_DOWNLOADED:
+    case TransferListModel::TR_AMOUNT_DOWNLOADED_SESSION:
+    case TransferListModel::TR_AMOUNT_LEFT:
+    case TransferListModel::TR_AMOUNT_UPLOADED:
+    case TransferListModel::TR_AMOUNT_UPLOADED_SESSION:
+    case TransferListModel::TR_COMPLETED:
+    case TransferListModel::TR_DLLIMIT:
+    case TransferListModel::TR_DLSPEED:
+    case TransferListModel::TR_ETA:
+    case TransferListModel::TR_LAST_ACTIVITY:
+    case TransferListModel::TR_QUEUE_POSITION:
+    case TransferListModel::TR_SEED_DATE:
+    case TransferListModel::TR_SEEN_COMPLETE_DATE:
+    case TransferListModel::TR_SIZE:
+    case TransferListModel::TR_TIME_ELAPSED:
+    case TransferListModel::TR_TOTAL_SIZE:
+    case TransferListModel::TR_UPLIMIT:
+    case TransferListModel::TR_UPSPEED:
+        return customCompare(std::get<qint64>(left), std::get<qint64>(right));
+
+    case TransferListModel::TR_AVAILABILITY:
+    case TransferListModel::TR_PROGRESS:
+    case TransferListModel::TR_RATIO:
+    case TransferListModel::TR_RATIO_LIMIT:
+        return customCompare(std::get<qreal>(left), std::get<qreal>(right));
+
+    case TransferListModel::TR_STATUS:
+        return threeWayCompare(std::get<qint64>(left), std::get<qint64>(right));
+
+    case TransferListModel::TR_PEERS:
+    case TransferListModel::TR_SEEDS:
+        // Active peers/seeds take precedence over total peers/seeds
+        return threeWayCompare(std::get<std::pair<int, int>>(left), std::get<std::pair<int, int>>(right));
 
     default:
         Q_ASSERT_X(false, Q_FUNC_INFO, "Missing comparison case");
@@ -238,10 +445,10 @@ bool TransferListSortModel::lessThan(const QModelIndex &left, const QModelIndex
 {
     Q_ASSERT(left.column() == right.column());
 
-    const int result = compare(left, right);
+    const int result = compare(left.column(), left.row(), right.row());
     if (result == 0)
     {
-        const int subResult = compare(left.sibling(left.row(), m_subSortColumn), right.sibling(right.row(), m_subSortColumn));
+        const int subResult = compare(m_subSortColumn, left.row(), right.row());
         // Qt inverses lessThan() result when ordered descending.
         // For sub-sorting we have to do it manually.
         // When both are ordered descending subResult must be double-inversed, which is the same as no inversion.
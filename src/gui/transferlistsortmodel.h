@@ -28,15 +28,20 @@
 
 #pragma once
 
+#include <utility>
+#include <variant>
+
+#include <QList>
 #include <QSortFilterProxyModel>
 
+#include "base/bittorrent/infohash.h"
 #include "base/settingvalue.h"
 #include "base/torrentfilter.h"
 #include "base/utils/compare.h"
 
 namespace BitTorrent
 {
-    class InfoHash;
+    class Torrent;
 }
 
 class TransferListSortModel final : public QSortFilterProxyModel
@@ -47,7 +52,9 @@ class TransferListSortModel final : public QSortFilterProxyModel
 public:
     explicit TransferListSortModel(QObject *parent = nullptr);
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
     void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    int subSortColumn() const;
 
     void setStatusFilter(TorrentFilter::Type filter);
     void setCategoryFilter(const QString &category);
@@ -58,7 +65,22 @@ public:
     void disableTrackerFilter();
 
 private:
-    int compare(const QModelIndex &left, const QModelIndex &right) const;
+    using NaturalSortKey = Utils::Compare::NaturalCompare<Qt::CaseInsensitive>::SortKey;
+    // Typed sort key of a single cell, the stored alternative depends on the column
+    using SortKey = std::variant<std::monostate, qint64, qreal, std::pair<int, int>
+        , NaturalSortKey, QList<NaturalSortKey>, SHA1Hash, SHA256Hash>;
+
+    SortKey makeSortKey(const BitTorrent::Torrent *torrent, int column) const;
+    SortKey makeSortKey(int sourceRow, int column) const;
+    void rebuildSortKeys();
+    void fillSortKeys(QList<SortKey> &keys, int column) const;
+
+    void handleSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void handleSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void handleSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+
+    int compare(int column, int leftRow, int rightRow) const;
+    int compareSortKeys(int column, const SortKey &left, const SortKey &right) const;
 
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
@@ -70,5 +92,11 @@ private:
     int m_lastSortColumn = -1;
     int m_lastSortOrder = 0;
 
+    // Sort keys of the primary and secondary sort columns, indexed by source row
+    QList<SortKey> m_sortKeys;
+    int m_sortKeysColumn = -1;
+    QList<SortKey> m_subSortKeys;
+    int m_subSortKeysColumn = -1;
+
     Utils::Compare::NaturalCompare<Qt::CaseInsensitive> m_naturalCompare;
 };
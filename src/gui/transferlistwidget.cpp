@@ -212,6 +212,11 @@ TransferListWidget::TransferListWidget(QWidget *parent, MainWindow *mainWindow)
     connect(header(), &QHeaderView::sectionMoved, this, &TransferListWidget::saveSettings);
     connect(header(), &QHeaderView::sectionResized, this, &TransferListWidget::saveSettings);
     connect(header(), &QHeaderView::sortIndicatorChanged, this, &TransferListWidget::saveSettings);
+    // sections are also resized when they get hidden or shown
+    connect(header(), &QHeaderView::sectionResized, this, &TransferListWidget::updateWatchedColumns);
+    // the view re-sorts the model before this is invoked, so the secondary sort column is already updated
+    connect(header(), &QHeaderView::sortIndicatorChanged, this, &TransferListWidget::updateWatchedColumns);
+    updateWatchedColumns();
 
     const auto *editHotkey = new QShortcut(Qt::Key_F2, this, nullptr, nullptr, Qt::WidgetShortcut);
     connect(editHotkey, &QShortcut::activated, this, &TransferListWidget::renameSelectedTorrent);
@@ -1034,7 +1039,7 @@ void TransferListWidget::displayListMenu()
         if (firstCategory != torrent->category())
             allSameCategory = false;
 
-        const TagSet torrentTags = torrent->tags();
+        const TagSet &torrentTags = torrent->tags();
         tagsInAny.unite(torrentTags);
 
         if (first)
@@ -1322,6 +1327,7 @@ void TransferListWidget::applyTrackerFilter(const QSet<BitTorrent::TorrentID> &t
 void TransferListWidget::applyFilter(const QString &name, const TransferListModel::Column &type)
 {
     m_sortFilterModel->setFilterKeyColumn(type);
+    updateWatchedColumns();
     const QString pattern = (Preferences::instance()->getRegexAsFilteringPatternForTransferList()
                 ? name : Utils::String::wildcardToRegexPattern(name));
     m_sortFilterModel->setFilterRegularExpression(QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption));
@@ -1343,6 +1349,20 @@ void TransferListWidget::saveSettings()
     Preferences::instance()->setTransHeaderState(header()->saveState());
 }
 
+void TransferListWidget::updateWatchedColumns()
+{
+    // Changes of hidden columns don't need to be reported unless they are used for sorting or filtering
+    QList<int> columns {m_sortFilterModel->sortColumn(), m_sortFilterModel->subSortColumn(), m_sortFilterModel->filterKeyColumn()};
+    for (int i = 0; i < TransferListModel::NB_COLUMNS; ++i)
+    {
+        if (!isColumnHidden(i))
+            columns.append(i);
+    }
+
+    columns.removeAll(-1);
+    m_listModel->setWatchedColumns(columns);
+}
+
 bool TransferListWidget::loadSettings()
 {
     return header()->restoreState(Preferences::instance()->getTransHeaderState());
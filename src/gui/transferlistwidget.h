@@ -118,6 +118,7 @@ private slots:
 
 private:
     void wheelEvent(QWheelEvent *event) override;
+    void updateWatchedColumns();
     QModelIndex mapToSource(const QModelIndex &index) const;
     QModelIndexList mapToSource(const QModelIndexList &indexes) const;
     QModelIndex mapFromSource(const QModelIndex &index) const;
@@ -1,4 +1,4 @@
-#VERSION: 1.44
+#VERSION: 1.46
 
 # Author:
 #  Fabien Devaux <fab AT gnux DOT info>
@@ -58,9 +58,11 @@ CATEGORIES = {'all', 'movies', 'tv', 'music', 'games', 'anime', 'software', 'pic
 ################################################################################
 
 
-def initialize_engines():
+def initialize_engines(requested_engines=None):
     """ Import available engines
 
+        Only the requested engines are imported, if any
+
         Return list of available engines
     """
     supported_engines = []
@@ -70,6 +72,8 @@ def initialize_engines():
         engi = path.basename(engine).split('.')[0].strip()
         if len(engi) == 0 or engi.startswith('_'):
             continue
+        if requested_engines is not None and engi not in requested_engines:
+            continue
         try:
             # import engines.[engine]
             engine_module = importlib.import_module("engines." + engi)
@@ -148,7 +152,14 @@ def main(args):
     if current_path not in sys.path:
         sys.path.append(current_path)
 
-    supported_engines = initialize_engines()
+    # qbt runs a separate process for each engine, so only the requested ones are imported
+    requested_engines = None
+    if len(args) >= 3 and args[0] != "--capabilities":
+        requested_engines = set(e.lower() for e in args[0].strip().split(','))
+        if 'all' in requested_engines:
+            requested_engines = None
+
+    supported_engines = initialize_engines(requested_engines)
 
     if not args:
         raise SystemExit("./nova2.py [all|engine1[,engine2]*] <category> <keywords>\n"
@@ -182,7 +193,8 @@ def main(args):
         raise SystemExit(" - ".join(('Invalid category', cat)))
 
     what = urllib.parse.quote(' '.join(args[2:]))
-    if THREADED:
+    # qbt runs a separate process for each engine, so there is no need to spawn another one
+    if THREADED and (len(engines_list) > 1):
         # child process spawning is controlled min(number of searches, number of cpu)
         with Pool(min(len(engines_list), MAX_THREADS)) as pool:
             pool.map(run_search, ([globals()[engine], what, cat] for engine in engines_list))
@@ -1,4 +1,4 @@
-#VERSION: 1.46
+#VERSION: 1.47
 
 # Redistribution and use in source and binary forms, with or without
 # modification, are permitted provided that the following conditions are met:
@@ -25,19 +25,37 @@
 # POSSIBILITY OF SUCH DAMAGE.
 
 
+import json
+
+
 def prettyPrinter(dictionary):
     dictionary['size'] = anySizeToBytes(dictionary['size'])
-    outtext = "|".join((dictionary["link"], dictionary["name"].replace("|", " "),
-                        str(dictionary["size"]), str(dictionary["seeds"]),
-                        str(dictionary["leech"]), dictionary["engine_url"]))
+    result = {
+        'link': dictionary['link'],
+        'name': dictionary['name'],
+        'size': dictionary['size'],
+        'seeds': anyNumberToInt(dictionary['seeds']),
+        'leech': anyNumberToInt(dictionary['leech']),
+        'engine_url': dictionary['engine_url']
+    }
     if 'desc_link' in dictionary:
-        outtext = "|".join((outtext, dictionary["desc_link"]))
+        result['desc_link'] = dictionary['desc_link']
+
+    # one JSON object per line
+    outtext = json.dumps(result)
 
     # fd 1 is stdout
     with open(1, 'w', encoding='utf-8', closefd=False) as utf8stdout:
         print(outtext, file=utf8stdout)
 
 
+def anyNumberToInt(number):
+    try:
+        return int(number)
+    except (TypeError, ValueError):
+        return -1
+
+
 def anySizeToBytes(size_string):
     """
     Convert a string like '1 KB' to '1024' (bytes)
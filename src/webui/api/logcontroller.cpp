@@ -44,8 +44,26 @@ const QString KEY_LOG_PEER_IP = u"ip"_s;
 const QString KEY_LOG_PEER_BLOCKED = u"blocked"_s;
 const QString KEY_LOG_PEER_REASON = u"reason"_s;
 
+namespace
+{
+    const int MAX_PAGE_SIZE = 5000;
+
+    // Returns -1 (i.e. no limit) if "limit" isn't passed, so the clients that don't use it
+    // keep getting all the entries following the cursor, as they did before paging was added
+    int pageSize(const QString &param)
+    {
+        bool ok = false;
+        const int limit = param.toInt(&ok);
+        if (!ok)
+            return -1;
+
+        return ((limit > 0) && (limit < MAX_PAGE_SIZE)) ? limit : MAX_PAGE_SIZE;
+    }
+}
+
 // Returns the log in JSON format.
-// The return value is an array of dictionaries.
+// The return value is an array of dictionaries, ordered from older to newer ones.
+// Use the id of the last one as 'last_known_id' to get the next ones.
 // The dictionary keys are:
 //   - "id": id of the message
 //   - "timestamp": milliseconds since epoch
@@ -57,6 +75,8 @@ const QString KEY_LOG_PEER_REASON = u"reason"_s;
 //   - warning (bool): include warning messages (default true)
 //   - critical (bool): include critical messages (default true)
 //   - last_known_id (int): exclude messages with id <= 'last_known_id' (default -1)
+//   - limit (int): max number of messages returned, i.e. the oldest ones following 'last_known_id'
+//     (max value is 5000; if not passed, all the messages following 'last_known_id' are returned)
 void LogController::mainAction()
 {
     using Utils::String::parseBool;
@@ -71,17 +91,20 @@ void LogController::mainAction()
     if (!ok)
         lastKnownId = -1;
 
-    Logger *const logger = Logger::instance();
-    QJsonArray msgList;
+    const int limit = pageSize(params()[u"limit"_s]);
 
-    for (const Log::Msg &msg : asConst(logger->getMessages(lastKnownId)))
-    {
-        if (!(((msg.type == Log::NORMAL) && isNormal)
-              || ((msg.type == Log::INFO) && isInfo)
-              || ((msg.type == Log::WARNING) && isWarning)
-              || ((msg.type == Log::CRITICAL) && isCritical)))
-            continue;
+    Log::MsgTypes types;
+    types.setFlag(Log::NORMAL, isNormal);
+    types.setFlag(Log::INFO, isInfo);
+    types.setFlag(Log::WARNING, isWarning);
+    types.setFlag(Log::CRITICAL, isCritical);
 
+    // messages are filtered while they are still in the log buffer, so only the requested ones are copied
+    const QVector<Log::Msg> messages = Logger::instance()->getMessages(lastKnownId, types, limit);
+
+    QJsonArray msgList;
+    for (const Log::Msg &msg : messages)
+    {
         msgList.append(QJsonObject
         {
             {KEY_LOG_ID, msg.id},
@@ -95,7 +118,8 @@ void LogController::mainAction()
 }
 
 // Returns the peer log in JSON format.
-// The return value is an array of dictionaries.
+// The return value is an array of dictionaries, ordered from older to newer ones.
+// Use the id of the last one as 'last_known_id' to get the next ones.
 // The dictionary keys are:
 //   - "id": id of the message
 //   - "timestamp": milliseconds since epoch
@@ -104,6 +128,8 @@ void LogController::mainAction()
 //   - "reason": reason of the block
 // GET params:
 //   - last_known_id (int): exclude messages with id <= 'last_known_id' (default -1)
+//   - limit (int): max number of messages returned, i.e. the oldest ones following 'last_known_id'
+//     (max value is 5000; if not passed, all the messages following 'last_known_id' are returned)
 void LogController::peersAction()
 {
     bool ok = false;
@@ -111,10 +137,11 @@ void LogController::peersAction()
     if (!ok)
         lastKnownId = -1;
 
-    Logger *const logger = Logger::instance();
-    QJsonArray peerList;
+    const int limit = pageSize(params()[u"limit"_s]);
+    const QVector<Log::Peer> peers = Logger::instance()->getPeers(lastKnownId, limit);
 
-    for (const Log::Peer &peer : asConst(logger->getPeers(lastKnownId)))
+    QJsonArray peerList;
+    for (const Log::Peer &peer : peers)
     {
         peerList.append(QJsonObject
         {
@@ -195,11 +195,9 @@ void RSSController::matchingArticlesAction()
         if (!feed) continue; // feed doesn't exist
 
         QJsonArray matchingArticles;
-        for (const RSS::Article *article : feed->articles())
-        {
-            if (rule.matches(article->data()))
-                matchingArticles << article->title();
-        }
+        const QList<RSS::Article *> articles = rule.findMatchingArticles(feed);
+        for (const RSS::Article *article : articles)
+            matchingArticles << article->title();
         if (!matchingArticles.isEmpty())
             jsonObj.insert(feed->name(), matchingArticles);
     }
@@ -29,6 +29,7 @@
 #include "searchcontroller.h"
 
 #include <limits>
+#include <optional>
 
 #include <QHash>
 #include <QJsonArray>
@@ -75,6 +76,23 @@ namespace
 
         return categoriesInfo;
     }
+
+    std::optional<SearchResultStore::SortColumn> parseSortColumn(const QString &name)
+    {
+        if (name.isEmpty())
+            return SearchResultStore::SortColumn::None;
+        if (name == u"fileName")
+            return SearchResultStore::SortColumn::FileName;
+        if (name == u"fileSize")
+            return SearchResultStore::SortColumn::FileSize;
+        if (name == u"nbSeeders")
+            return SearchResultStore::SortColumn::NbSeeders;
+        if (name == u"nbLeechers")
+            return SearchResultStore::SortColumn::NbLeechers;
+        if (name == u"siteUrl")
+            return SearchResultStore::SortColumn::SiteUrl;
+        return std::nullopt;
+    }
 }
 
 void SearchController::startAction()
@@ -106,6 +124,9 @@ void SearchController::startAction()
 
     if (m_activeSearches.size() >= MAX_CONCURRENT_SEARCHES)
         throw APIError(APIErrorType::Conflict, tr("Unable to create more than %1 concurrent searches.").arg(MAX_CONCURRENT_SEARCHES));
+    // searches of all the users share the same machine
+    if (SearchPluginManager::instance()->activeSearchCount() >= MAX_TOTAL_CONCURRENT_SEARCHES)
+        throw APIError(APIErrorType::Conflict, tr("Too many searches are running. Try again later."));
 
     const auto id = generateSearchId();
     const std::shared_ptr<SearchHandler> searchHandler {SearchPluginManager::instance()->startSearch(pattern, category, pluginsToUse)};
@@ -163,6 +184,15 @@ void SearchController::statusAction()
     setResult(statusArray);
 }
 
+// GET params:
+//   - id (int): search id
+//   - sort (string): fileName, fileSize, nbSeeders, nbLeechers or siteUrl
+//   - reverse (bool): enable reverse sorting
+//   - filter (string): space separated words that result name must contain
+//   - minSize, maxSize (int): file size range in bytes (negative maxSize means unlimited)
+//   - minSeeds, maxSeeds (int): seeders number range (negative maxSeeds means unlimited)
+//   - limit (int): set limit number of results returned (if greater than 0, otherwise - unlimited)
+//   - offset (int): set offset (if less than 0 - offset from end)
 void SearchController::resultsAction()
 {
     requireParams({u"id"_s});
@@ -171,13 +201,31 @@ void SearchController::resultsAction()
     int limit = params()[u"limit"_s].toInt();
     int offset = params()[u"offset"_s].toInt();
 
+    const std::optional<SearchResultStore::SortColumn> sortColumn = parseSortColumn(params()[u"sort"_s]);
+    if (!sortColumn)
+        throw APIError(APIErrorType::BadParams, tr("'sort' parameter is invalid"));
+    const bool reverse = Utils::String::parseBool(params()[u"reverse"_s]).value_or(false);
+
+    SearchResultFilter filter;
+    filter.nameWords = params()[u"filter"_s].split(u' ', Qt::SkipEmptyParts);
+    filter.minSize = params()[u"minSize"_s].toLongLong();
+    filter.maxSize = params().value(u"maxSize"_s, u"-1"_s).toLongLong();
+    filter.minSeeds = params()[u"minSeeds"_s].toLongLong();
+    filter.maxSeeds = params().value(u"maxSeeds"_s, u"-1"_s).toLongLong();
+
     const auto iter = m_searchHandlers.find(id);
     if (iter == m_searchHandlers.end())
         throw APIError(APIErrorType::NotFound);
 
     const std::shared_ptr<SearchHandler> &searchHandler = iter.value();
-    const QList<SearchResult> searchResults = searchHandler->results();
-    const int size = searchResults.size();
+    const SearchResultStore &searchResults = searchHandler->results();
+
+    // Results are accessed by indexes so only the requested ones are copied
+    const bool isSelectionRequired = (*sortColumn != SearchResultStore::SortColumn::None) || reverse || !filter.isEmpty();
+    const QVector<int> selectedIndexes = isSelectionRequired
+            ? searchResults.select(filter, *sortColumn, (reverse ? Qt::DescendingOrder : Qt::AscendingOrder))
+            : QVector<int>();
+    const int size = isSelectionRequired ? selectedIndexes.size() : searchResults.size();
 
     if (offset > size)
         throw APIError(APIErrorType::Conflict, tr("Offset is out of range"));
@@ -187,13 +235,15 @@ void SearchController::resultsAction()
         offset = size + offset;
     if (offset < 0)  // check again
         throw APIError(APIErrorType::Conflict, tr("Offset is out of range"));
-    if (limit <= 0)
-        limit = -1;
+    if ((limit <= 0) || (limit > (size - offset)))
+        limit = size - offset;
 
-    if ((limit > 0) || (offset > 0))
-        setResult(getResults(searchResults.mid(offset, limit), searchHandler->isActive(), size));
-    else
-        setResult(getResults(searchResults, searchHandler->isActive(), size));
+    QList<SearchResult> requestedResults;
+    requestedResults.reserve(limit);
+    for (int i = offset; i < (offset + limit); ++i)
+        requestedResults.append(searchResults.at(isSelectionRequired ? selectedIndexes[i] : i));
+
+    setResult(getResults(requestedResults, searchHandler->isActive(), size));
 }
 
 void SearchController::deleteAction()
@@ -301,6 +351,7 @@ int SearchController::generateSearchId() const
  *   - "nbLeechers"
  *   - "siteUrl"
  *   - "descrLink"
+ * The "total" is the number of all the results that satisfy the filter.
  */
 QJsonObject SearchController::getResults(const QList<SearchResult> &searchResults, const bool isSearchActive, const int totalResults) const
 {
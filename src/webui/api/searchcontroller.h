@@ -64,6 +64,7 @@ private slots:
 
 private:
     const int MAX_CONCURRENT_SEARCHES = 5;
+    const int MAX_TOTAL_CONCURRENT_SEARCHES = 10;
 
     void checkForUpdatesFinished(const QHash<QString, PluginVersion> &updateInfo);
     void checkForUpdatesFailed(const QString &reason);
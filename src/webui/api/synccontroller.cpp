@@ -35,7 +35,6 @@
 #include <QMetaObject>
 #include <QThreadPool>
 
-#include "base/algorithm.h"
 #include "base/bittorrent/cachestatus.h"
 #include "base/bittorrent/infohash.h"
 #include "base/bittorrent/peeraddress.h"
@@ -482,7 +481,8 @@ void SyncController::maindataAction()
         connect(btSession, &BitTorrent::Session::torrentTagAdded, this, &SyncController::onTorrentTagAdded);
         connect(btSession, &BitTorrent::Session::torrentTagRemoved, this, &SyncController::onTorrentTagRemoved);
         connect(btSession, &BitTorrent::Session::torrentsUpdated, this, &SyncController::onTorrentsUpdated);
-        connect(btSession, &BitTorrent::Session::trackersChanged, this, &SyncController::onTorrentTrackersChanged);
+        connect(btSession, &BitTorrent::Session::trackersAdded, this, &SyncController::onTorrentTrackersAdded);
+        connect(btSession, &BitTorrent::Session::trackersRemoved, this, &SyncController::onTorrentTrackersRemoved);
     }
 
     const int acceptedID = params()[u"rid"_s].toInt();
@@ -509,7 +509,6 @@ void SyncController::maindataAction()
 
 void SyncController::makeMaindataSnapshot()
 {
-    m_knownTrackers.clear();
     m_maindataAcceptedID = 0;
     m_maindataSnapshot = {};
 
@@ -523,7 +522,7 @@ void SyncController::makeMaindataSnapshot()
         serializedTorrent.remove(KEY_TORRENT_ID);
 
         for (const BitTorrent::TrackerEntry &tracker : asConst(torrent->trackers()))
-            m_knownTrackers[tracker.url].insert(torrentID);
+            m_maindataSnapshot.trackers[tracker.url].append(torrentID.toString());
 
         m_maindataSnapshot.torrents[torrentID.toString()] = serializedTorrent;
     }
@@ -542,15 +541,6 @@ void SyncController::makeMaindataSnapshot()
     for (const QString &tag : asConst(session->tags()))
         m_maindataSnapshot.tags.append(tag);
 
-    for (auto trackersIter = m_knownTrackers.cbegin(); trackersIter != m_knownTrackers.cend(); ++trackersIter)
-    {
-        QStringList torrentIDs;
-        for (const BitTorrent::TorrentID &torrentID : asConst(trackersIter.value()))
-            torrentIDs.append(torrentID.toString());
-
-        m_maindataSnapshot.trackers[trackersIter.key()] = torrentIDs;
-    }
-
     m_maindataSnapshot.serverState = getTransferInfo();
     m_maindataSnapshot.serverState[KEY_TRANSFER_FREESPACEONDISK] = getFreeDiskSpace();
     m_maindataSnapshot.serverState[KEY_SYNC_MAINDATA_QUEUEING] = session->isQueueingSystemEnabled();
@@ -561,6 +551,27 @@ void SyncController::makeMaindataSnapshot()
 
 QJsonObject SyncController::generateMaindataSyncData(const int id, const bool fullUpdate)
 {
+    const auto *session = BitTorrent::Session::instance();
+
+    QHash<QString, QStringList> updatedTrackers;
+    QStringList removedTrackers;
+    for (const QString &tracker : asConst(m_updatedTrackers))
+    {
+        const QVector<BitTorrent::Torrent *> torrents = session->trackerURLTorrents(tracker);
+        if (torrents.isEmpty())
+        {
+            removedTrackers.append(tracker);
+            continue;
+        }
+
+        QStringList serializedTorrentIDs;
+        serializedTorrentIDs.reserve(torrents.size());
+        for (const BitTorrent::Torrent *torrent : torrents)
+            serializedTorrentIDs.append(torrent->id().toString());
+        updatedTrackers.insert(tracker, serializedTorrentIDs);
+    }
+    m_updatedTrackers.clear();
+
     // if need to update existing sync data
     for (const QString &category : asConst(m_updatedCategories))
         m_maindataSyncBuf.removedCategories.removeOne(category);
@@ -577,13 +588,11 @@ QJsonObject SyncController::generateMaindataSyncData(const int id, const bool fu
     for (const BitTorrent::TorrentID &torrentID : asConst(m_removedTorrents))
         m_maindataSyncBuf.torrents.remove(torrentID.toString());
 
-    for (const QString &tracker : asConst(m_updatedTrackers))
-        m_maindataSyncBuf.removedTrackers.removeOne(tracker);
-    for (const QString &tracker : asConst(m_removedTrackers))
+    for (auto trackersIter = updatedTrackers.cbegin(); trackersIter != updatedTrackers.cend(); ++trackersIter)
+        m_maindataSyncBuf.removedTrackers.removeOne(trackersIter.key());
+    for (const QString &tracker : asConst(removedTrackers))
         m_maindataSyncBuf.trackers.remove(tracker);
 
-    const auto *session = BitTorrent::Session::instance();
-
     for (const QString &categoryName : asConst(m_updatedCategories))
     {
         const BitTorrent::CategoryOptions categoryOptions = session->categoryOptions(categoryName);
@@ -640,25 +649,17 @@ QJsonObject SyncController::generateMaindataSyncData(const int id, const bool fu
     }
     m_removedTorrents.clear();
 
-    for (const QString &tracker : asConst(m_updatedTrackers))
+    for (auto trackersIter = updatedTrackers.cbegin(); trackersIter != updatedTrackers.cend(); ++trackersIter)
     {
-        const QSet<BitTorrent::TorrentID> torrentIDs = m_knownTrackers[tracker];
-        QStringList serializedTorrentIDs;
-        serializedTorrentIDs.reserve(torrentIDs.size());
-        for (const BitTorrent::TorrentID &torrentID : torrentIDs)
-            serializedTorrentIDs.append(torrentID.toString());
-
-        m_maindataSyncBuf.trackers[tracker] = serializedTorrentIDs;
-        m_maindataSnapshot.trackers[tracker] = serializedTorrentIDs;
+        m_maindataSyncBuf.trackers[trackersIter.key()] = trackersIter.value();
+        m_maindataSnapshot.trackers[trackersIter.key()] = trackersIter.value();
     }
-    m_updatedTrackers.clear();
 
-    for (const QString &tracker : asConst(m_removedTrackers))
+    for (const QString &tracker : asConst(removedTrackers))
     {
         m_maindataSyncBuf.removedTrackers.append(tracker);
         m_maindataSnapshot.trackers.remove(tracker);
     }
-    m_removedTrackers.clear();
 
     QVariantMap serverState = getTransferInfo();
     serverState[KEY_TRANSFER_FREESPACEONDISK] = getFreeDiskSpace();
@@ -862,11 +863,7 @@ void SyncController::onTorrentAdded(BitTorrent::Torrent *torrent)
     m_updatedTorrents.insert(torrentID);
 
     for (const BitTorrent::TrackerEntry &trackerEntry : asConst(torrent->trackers()))
-    {
-        m_knownTrackers[trackerEntry.url].insert(torrentID);
         m_updatedTrackers.insert(trackerEntry.url);
-        m_removedTrackers.remove(trackerEntry.url);
-    }
 }
 
 void SyncController::onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent)
@@ -877,25 +874,7 @@ void SyncController::onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent)
     m_removedTorrents.insert(torrentID);
 
     for (const BitTorrent::TrackerEntry &trackerEntry : asConst(torrent->trackers()))
-    {
-        auto iter = m_knownTrackers.find(trackerEntry.url);
-        Q_ASSERT(iter != m_knownTrackers.end());
-        if (iter == m_knownTrackers.end()) [[unlikely]]
-            continue;
-
-        QSet<BitTorrent::TorrentID> &torrentIDs = iter.value();
-        torrentIDs.remove(torrentID);
-        if (torrentIDs.isEmpty())
-        {
-            m_knownTrackers.erase(iter);
-            m_updatedTrackers.remove(trackerEntry.url);
-            m_removedTrackers.insert(trackerEntry.url);
-        }
-        else
-        {
-            m_updatedTrackers.insert(trackerEntry.url);
-        }
-    }
+        m_updatedTrackers.insert(trackerEntry.url);
 }
 
 void SyncController::onTorrentCategoryChanged(BitTorrent::Torrent *torrent
@@ -945,52 +924,15 @@ void SyncController::onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &tor
         m_updatedTorrents.insert(torrent->id());
 }
 
-void SyncController::onTorrentTrackersChanged(BitTorrent::Torrent *torrent)
+void SyncController::onTorrentTrackersAdded([[maybe_unused]] BitTorrent::Torrent *torrent
+        , const QVector<BitTorrent::TrackerEntry> &trackers)
 {
-    using namespace BitTorrent;
-
-    const QVector<TrackerEntry> currentTrackerEntries = torrent->trackers();
-    QSet<QString> currentTrackers;
-    currentTrackers.reserve(currentTrackerEntries.size());
-    for (const TrackerEntry &currentTrackerEntry : currentTrackerEntries)
-        currentTrackers.insert(currentTrackerEntry.url);
-
-    const TorrentID torrentID = torrent->id();
-    Algorithm::removeIf(m_knownTrackers
-        , [this, torrentID, currentTrackers](const QString &knownTracker, QSet<TorrentID> &torrentIDs)
-    {
-        if (auto idIter = torrentIDs.find(torrentID)
-                ; (idIter != torrentIDs.end()) && !currentTrackers.contains(knownTracker))
-        {
-            torrentIDs.erase(idIter);
-            if (torrentIDs.isEmpty())
-            {
-                m_updatedTrackers.remove(knownTracker);
-                m_removedTrackers.insert(knownTracker);
-                return true;
-            }
-
-            m_updatedTrackers.insert(knownTracker);
-            return false;
-        }
-
-        if (currentTrackers.contains(knownTracker) && !torrentIDs.contains(torrentID))
-        {
-            torrentIDs.insert(torrentID);
-            m_updatedTrackers.insert(knownTracker);
-            return false;
-        }
-
-        return false;
-    });
+    for (const BitTorrent::TrackerEntry &trackerEntry : trackers)
+        m_updatedTrackers.insert(trackerEntry.url);
+}
 
-    for (const QString &currentTracker : asConst(currentTrackers))
-    {
-        if (!m_knownTrackers.contains(currentTracker))
-        {
-            m_knownTrackers.insert(currentTracker, {torrentID});
-            m_updatedTrackers.insert(currentTracker);
-            m_removedTrackers.remove(currentTracker);
-        }
-    }
+void SyncController::onTorrentTrackersRemoved([[maybe_unused]] BitTorrent::Torrent *torrent, const QStringList &trackers)
+{
+    for (const QString &tracker : trackers)
+        m_updatedTrackers.insert(tracker);
 }
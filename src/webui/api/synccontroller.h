@@ -40,6 +40,7 @@ class QThread;
 namespace BitTorrent
 {
     class Torrent;
+    struct TrackerEntry;
 }
 
 class FreeDiskSpaceChecker;
@@ -82,7 +83,8 @@ private:
     void onTorrentTagAdded(BitTorrent::Torrent *torrent, const QString &tag);
     void onTorrentTagRemoved(BitTorrent::Torrent *torrent, const QString &tag);
     void onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents);
-    void onTorrentTrackersChanged(BitTorrent::Torrent *torrent);
+    void onTorrentTrackersAdded(BitTorrent::Torrent *torrent, const QVector<BitTorrent::TrackerEntry> &trackers);
+    void onTorrentTrackersRemoved(BitTorrent::Torrent *torrent, const QStringList &trackers);
 
     qint64 m_freeDiskSpace = 0;
     QElapsedTimer m_freeDiskSpaceElapsedTimer;
@@ -91,14 +93,13 @@ private:
     QVariantMap m_lastPeersResponse;
     QVariantMap m_lastAcceptedPeersResponse;
 
-    QHash<QString, QSet<BitTorrent::TorrentID>> m_knownTrackers;
-
     QSet<QString> m_updatedCategories;
     QSet<QString> m_removedCategories;
     QSet<QString> m_addedTags;
     QSet<QString> m_removedTags;
+    // The torrents of the trackers are taken from the session index when sync data is generated,
+    // the trackers which are no longer used by any torrent are reported as removed
     QSet<QString> m_updatedTrackers;
-    QSet<QString> m_removedTrackers;
     QSet<BitTorrent::TorrentID> m_updatedTorrents;
     QSet<BitTorrent::TorrentID> m_removedTorrents;
 
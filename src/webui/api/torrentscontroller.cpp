@@ -28,7 +28,9 @@
 
 #include "torrentscontroller.h"
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 
 #include <QBitArray>
 #include <QJsonArray>
@@ -39,6 +41,7 @@
 #include <QUrl>
 
 #include "base/bittorrent/categoryoptions.h"
+#include "base/bittorrent/diskiostatus.h"
 #include "base/bittorrent/downloadpriority.h"
 #include "base/bittorrent/infohash.h"
 #include "base/bittorrent/peeraddress.h"
@@ -46,6 +49,7 @@
 #include "base/bittorrent/session.h"
 #include "base/bittorrent/torrent.h"
 #include "base/bittorrent/torrentdescriptor.h"
+#include "base/bittorrent/torrentmemoryusage.h"
 #include "base/bittorrent/trackerentry.h"
 #include "base/global.h"
 #include "base/logger.h"
@@ -141,6 +145,14 @@ namespace
         }
     }
 
+    QJsonArray serializeLatencyHistogram(const BitTorrent::LatencyHistogram &histogram)
+    {
+        QJsonArray result;
+        for (const qint64 count : histogram)
+            result.append(count);
+        return result;
+    }
+
     std::optional<QString> getOptionalString(const StringMap &params, const QString &name)
     {
         const auto it = params.constFind(name);
@@ -257,6 +269,7 @@ namespace
 //   - filter (string): all, downloading, seeding, completed, paused, resumed, active, inactive, stalled, stalled_uploading, stalled_downloading
 //   - category (string): torrent category for filtering by it (empty string means "uncategorized"; no "category" param presented means "any category")
 //   - tag (string): torrent tag for filtering by it (empty string means "untagged"; no "tag" param presented means "any tag")
+//   - tracker (string): tracker host for filtering by it (empty string means "trackerless"; no "tracker" param presented means "any tracker")
 //   - hashes (string): filter by hashes, can contain multiple hashes separated by |
 //   - sort (string): name of column for sorting by its value
 //   - reverse (bool): enable reverse sorting
@@ -267,6 +280,7 @@ void TorrentsController::infoAction()
     const QString filter {params()[u"filter"_s]};
     const std::optional<QString> category = getOptionalString(params(), u"category"_s);
     const std::optional<QString> tag = getOptionalString(params(), u"tag"_s);
+    const std::optional<QString> trackerHost = getOptionalString(params(), u"tracker"_s);
     const QString sortedColumn {params()[u"sort"_s]};
     const bool reverse {parseBool(params()[u"reverse"_s]).value_or(false)};
     int limit {params()[u"limit"_s].toInt()};
@@ -281,13 +295,11 @@ void TorrentsController::infoAction()
             idSet->insert(BitTorrent::TorrentID::fromString(hash));
     }
 
-    const TorrentFilter torrentFilter {filter, idSet, category, tag};
+    TorrentFilter torrentFilter {filter, idSet, category, tag};
+    torrentFilter.setTrackerHost(trackerHost);
     QVariantList torrentList;
-    for (const BitTorrent::Torrent *torrent : asConst(BitTorrent::Session::instance()->torrents()))
-    {
-        if (torrentFilter.match(torrent))
-            torrentList.append(serialize(*torrent));
-    }
+    for (const BitTorrent::Torrent *torrent : asConst(torrentFilter.findMatchingTorrents()))
+        torrentList.append(serialize(*torrent));
 
     if (torrentList.isEmpty())
     {
@@ -1428,3 +1440,106 @@ void TorrentsController::exportAction()
 
     setResult(result.value());
 }
+
+void TorrentsController::memoryUsageAction()
+{
+    const QVector<BitTorrent::Torrent *> torrents = BitTorrent::Session::instance()->torrents();
+
+    BitTorrent::TorrentMemoryUsage usage;
+    for (const BitTorrent::Torrent *torrent : torrents)
+        usage += torrent->memoryUsage();
+
+    // interned strings are shared between torrents so they are reported separately
+    const qint64 internedStrings = BitTorrent::Session::instance()->internedStringsMemoryUsage();
+    const qint64 total = usage.total() + internedStrings;
+    const qint64 perTorrent = (torrents.isEmpty() ? 0 : (total / torrents.size()));
+    setResult(QJsonObject {
+        {u"torrents_count"_s, static_cast<qint64>(torrents.size())},
+        {u"total"_s, total},
+        {u"per_torrent"_s, perTorrent},
+        {u"object"_s, usage.object},
+        {u"metadata"_s, usage.metadata},
+        {u"file_paths"_s, usage.filePaths},
+        {u"file_states"_s, usage.fileStates},
+        {u"pieces"_s, usage.pieces},
+        {u"trackers"_s, usage.trackers},
+        {u"url_seeds"_s, usage.urlSeeds},
+        {u"category_and_tags"_s, usage.categoryAndTags},
+        {u"status"_s, usage.status},
+        {u"resume_data"_s, usage.resumeData},
+        {u"interned_strings"_s, internedStrings}
+    });
+}
+
+// Returns the disk I/O statistics of the torrents
+// GET params:
+//   - hashes (string): hashes of the torrents separated by | or "all" (default, torrents without disk jobs are omitted then)
+//   - sort (string): bytes_read, bytes_written or bytes_total to return the torrents with the highest value
+//   - limit (int): set limit number of torrents returned (if greater than 0, otherwise - unlimited)
+void TorrentsController::diskIOStatsAction()
+{
+    const QString hashesParam = params()[u"hashes"_s];
+    const QStringList hashes = hashesParam.isEmpty() ? QStringList {u"all"_s} : hashesParam.split(u'|');
+    const bool skipIdle = ((hashes.size() == 1) && (hashes[0] == u"all"));
+    const QString sortedColumn = params()[u"sort"_s];
+    const int limit = params()[u"limit"_s].toInt();
+
+    std::function<qint64 (const BitTorrent::DiskIOStatus &)> sortKey;
+    if (sortedColumn == u"bytes_read")
+        sortKey = [](const BitTorrent::DiskIOStatus &status) { return status.bytesRead; };
+    else if (sortedColumn == u"bytes_written")
+        sortKey = [](const BitTorrent::DiskIOStatus &status) { return status.bytesWritten; };
+    else if (sortedColumn == u"bytes_total")
+        sortKey = [](const BitTorrent::DiskIOStatus &status) { return (status.bytesRead + status.bytesWritten); };
+    else if (!sortedColumn.isEmpty())
+        throw APIError(APIErrorType::BadParams, tr("'sort' parameter is invalid"));
+
+    QList<std::pair<BitTorrent::TorrentID, BitTorrent::DiskIOStatus>> statuses;
+    applyToTorrents(hashes, [skipIdle, &statuses](const BitTorrent::Torrent *torrent)
+    {
+        BitTorrent::DiskIOStatus status = torrent->diskIOStatus();
+        const auto jobsCount = [](const BitTorrent::LatencyHistogram &histogram)
+        {
+            return std::accumulate(histogram.cbegin(), histogram.cend(), qint64(0));
+        };
+        if (skipIdle && (jobsCount(status.readLatency) == 0)
+                && (jobsCount(status.writeLatency) == 0) && (jobsCount(status.hashLatency) == 0))
+        {
+            return;
+        }
+
+        statuses.emplace_back(torrent->id(), std::move(status));
+    });
+
+    // only the torrents with the highest values need to be ordered
+    const qsizetype count = ((limit > 0) && (limit < statuses.size())) ? limit : statuses.size();
+    if (sortKey)
+    {
+        std::partial_sort(statuses.begin(), (statuses.begin() + count), statuses.end()
+                , [&sortKey](const auto &left, const auto &right) { return (sortKey(left.second) > sortKey(right.second)); });
+    }
+
+    QJsonObject torrentsStats;
+    for (qsizetype i = 0; i < count; ++i)
+    {
+        const auto &[id, status] = statuses[i];
+        torrentsStats[id.toString()] = QJsonObject
+        {
+            {u"bytes_read"_s, status.bytesRead},
+            {u"bytes_written"_s, status.bytesWritten},
+            {u"read_latency"_s, serializeLatencyHistogram(status.readLatency)},
+            {u"write_latency"_s, serializeLatencyHistogram(status.writeLatency)},
+            {u"hash_latency"_s, serializeLatencyHistogram(status.hashLatency)}
+        };
+    }
+
+    // the last bucket isn't bounded
+    QJsonArray latencyBuckets;
+    for (int i = 0; i < (BitTorrent::LATENCY_BUCKET_COUNT - 1); ++i)
+        latencyBuckets.append(BitTorrent::LATENCY_BUCKET_BASE << i);
+
+    setResult(QJsonObject {
+        {u"latency_buckets"_s, latencyBuckets},
+        {u"torrents"_s, torrentsStats}
+    });
+}
@@ -88,4 +88,6 @@ private slots:
     void renameFileAction();
     void renameFolderAction();
     void exportAction();
+    void memoryUsageAction();
+    void diskIOStatsAction();
 };
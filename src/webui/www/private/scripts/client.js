@@ -813,6 +813,74 @@ window.addEvent('load', function() {
         }
     };
 
+    let diskIOStatsRequestInProgress = false;
+    const updateDiskIOStats = function() {
+        // the statistics are requested on every sync, so the previous request may still be pending
+        if (diskIOStatsRequestInProgress)
+            return;
+
+        diskIOStatsRequestInProgress = true;
+        new Request.JSON({
+            url: new URI('api/v2/torrents/diskIOStats'),
+            noCache: true,
+            method: 'get',
+            data: {
+                sort: 'bytes_total',
+                limit: 10
+            },
+            onComplete: function() {
+                diskIOStatsRequestInProgress = false;
+            },
+            onSuccess: function(response) {
+                const tableBody = $('DiskIOTorrents');
+                if (!response || !tableBody)
+                    return;
+
+                const latencyPercentile = function(histogram, percent) {
+                    const total = histogram.reduce((sum, count) => sum + count, 0);
+                    if (total === 0)
+                        return null;
+
+                    const threshold = Math.ceil(total * percent / 100);
+                    let accumulated = 0;
+                    for (let i = 0; i < response.latency_buckets.length; ++i) {
+                        accumulated += histogram[i];
+                        if (accumulated >= threshold)
+                            return response.latency_buckets[i];
+                    }
+                    return (response.latency_buckets[response.latency_buckets.length - 1] * 2);
+                };
+                const latencyString = function(microseconds) {
+                    if (microseconds < 1000)
+                        return 'QBT_TR(%1 µs)QBT_TR[CONTEXT=StatsDialog]'.replace("%1", microseconds);
+                    return 'QBT_TR(%1 ms)QBT_TR[CONTEXT=StatsDialog]'.replace("%1", Math.floor(microseconds / 1000));
+                };
+                const latencyPercentilesString = function(histogram) {
+                    const median = latencyPercentile(histogram, 50);
+                    if (median === null)
+                        return "-";
+                    return latencyString(median) + " / " + latencyString(latencyPercentile(histogram, 99));
+                };
+
+                const stats = Object.entries(response.torrents)
+                    .filter(([, torrentStats]) => ((torrentStats.bytes_read + torrentStats.bytes_written) > 0))
+                    .sort(([, stats1], [, stats2]) => ((stats2.bytes_read + stats2.bytes_written) - (stats1.bytes_read + stats1.bytes_written)));
+
+                tableBody.empty();
+                for (const [hash, torrentStats] of stats) {
+                    const row = torrentsTable.rows.get(hash);
+                    const tr = new Element('tr');
+                    new Element('td', { text: (row ? row.full_data.name : hash) }).inject(tr);
+                    new Element('td', { 'class': 'statisticsValue', text: window.qBittorrent.Misc.friendlyUnit(torrentStats.bytes_read, false) }).inject(tr);
+                    new Element('td', { 'class': 'statisticsValue', text: window.qBittorrent.Misc.friendlyUnit(torrentStats.bytes_written, false) }).inject(tr);
+                    new Element('td', { 'class': 'statisticsValue', text: latencyPercentilesString(torrentStats.read_latency) }).inject(tr);
+                    new Element('td', { 'class': 'statisticsValue', text: latencyPercentilesString(torrentStats.write_latency) }).inject(tr);
+                    tr.inject(tableBody);
+                }
+            }
+        }).send();
+    };
+
     const processServerState = function() {
         let transfer_info = window.qBittorrent.Misc.friendlyUnit(serverState.dl_info_speed, true);
         if (serverState.dl_rate_limit > 0)
@@ -847,6 +915,7 @@ window.addEvent('load', function() {
             $('QueuedIOJobs').set('html', serverState.queued_io_jobs);
             $('AverageTimeInQueue').set('html', serverState.average_time_queue + " ms");
             $('TotalQueuedSize').set('html', window.qBittorrent.Misc.friendlyUnit(serverState.total_queued_size, false));
+            updateDiskIOStats();
         }
 
         switch (serverState.connection_status) {
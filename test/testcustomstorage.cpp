@@ -0,0 +1,159 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <libtorrent/add_torrent_params.hpp>
+#include <libtorrent/alert_types.hpp>
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/create_torrent.hpp>
+#include <libtorrent/session.hpp>
+#include <libtorrent/torrent_handle.hpp>
+#include <libtorrent/torrent_info.hpp>
+#include <libtorrent/torrent_status.hpp>
+
+#include <QByteArray>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "base/bittorrent/customstorage.h"
+#include "base/global.h"
+#include "base/path.h"
+#include "base/utils/fs.h"
+#include "base/utils/io.h"
+
+Q_DECLARE_METATYPE(lt::move_flags_t)
+
+namespace
+{
+    const std::chrono::seconds ALERT_TIMEOUT {10};
+    const QString FILE_NAME = u"data.bin"_s;
+}
+
+class TestCustomStorage final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestCustomStorage)
+
+public:
+    TestCustomStorage() = default;
+
+private slots:
+    void testMoveStorage_data() const
+    {
+        QTest::addColumn<lt::move_flags_t>("flags");
+
+        QTest::newRow("Overwrite") << lt::move_flags_t::always_replace_files;
+        QTest::newRow("FailIfExist") << lt::move_flags_t::fail_if_exist;
+        QTest::newRow("KeepExistingFiles") << lt::move_flags_t::dont_replace;
+    }
+
+    void testMoveStorage() const
+    {
+        QFETCH(lt::move_flags_t, flags);
+
+        const QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const Path savePath = Path(tempDir.path()) / Path(u"old"_s);
+        const Path newSavePath = Path(tempDir.path()) / Path(u"new"_s);
+        QVERIFY(Utils::Fs::mkpath(savePath));
+
+        QByteArray data;
+        for (int i = 0; i < (256 * 1024); ++i)
+            data.append(static_cast<char>(i % 251));
+        QVERIFY(Utils::IO::saveToFile((savePath / Path(FILE_NAME)), data));
+
+        lt::file_storage fileStorage;
+        lt::add_files(fileStorage, (savePath / Path(FILE_NAME)).toString().toStdString());
+        lt::create_torrent creator {fileStorage, (16 * 1024)};
+        lt::set_piece_hashes(creator, savePath.toString().toStdString());
+        std::vector<char> torrentData;
+        lt::bencode(std::back_inserter(torrentData), creator.generate());
+
+        lt::settings_pack settings;
+        settings.set_int(lt::settings_pack::alert_mask, (lt::alert_category::status | lt::alert_category::storage));
+        settings.set_str(lt::settings_pack::listen_interfaces, "127.0.0.1:0");
+        settings.set_bool(lt::settings_pack::enable_dht, false);
+        settings.set_bool(lt::settings_pack::enable_lsd, false);
+        settings.set_bool(lt::settings_pack::enable_upnp, false);
+        settings.set_bool(lt::settings_pack::enable_natpmp, false);
+        lt::session_params sessionParams {settings};
+#ifdef QBT_USES_LIBTORRENT2
+        sessionParams.disk_io_constructor = customDiskIOConstructor;
+#endif
+        lt::session session {sessionParams};
+
+        lt::add_torrent_params addParams;
+        addParams.ti = std::make_shared<lt::torrent_info>(torrentData, lt::from_span);
+        addParams.save_path = savePath.toString().toStdString();
+#ifndef QBT_USES_LIBTORRENT2
+        addParams.storage = customStorageConstructor;
+#endif
+        const lt::torrent_handle handle = session.add_torrent(addParams);
+        QVERIFY(waitForAlert<lt::torrent_checked_alert>(session));
+        QCOMPARE(handle.status().state, lt::torrent_status::seeding);
+
+        // the files moved without copying must not be taken for the existing ones
+        handle.move_storage(newSavePath.toString().toStdString(), flags);
+        QVERIFY(waitForAlert<lt::storage_moved_alert>(session));
+        QVERIFY(!waitForAlert<lt::torrent_checked_alert>(session, std::chrono::seconds(1)));
+        QCOMPARE(handle.status().state, lt::torrent_status::seeding);
+        QCOMPARE(Path(handle.status(lt::torrent_handle::query_save_path).save_path), newSavePath);
+        QVERIFY((newSavePath / Path(FILE_NAME)).exists());
+        QVERIFY(!(savePath / Path(FILE_NAME)).exists());
+    }
+
+private:
+    template <typename T>
+    static bool waitForAlert(lt::session &session, const std::chrono::milliseconds timeout = ALERT_TIMEOUT)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (!session.wait_for_alert(deadline - std::chrono::steady_clock::now()))
+                continue;
+
+            std::vector<lt::alert *> alerts;
+            session.pop_alerts(&alerts);
+            for (const lt::alert *alert : alerts)
+            {
+                if (lt::alert_cast<T>(alert))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+QTEST_APPLESS_MAIN(TestCustomStorage)
+#include "testcustomstorage.moc"
@@ -0,0 +1,146 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QTest>
+
+#include "base/global.h"
+#include "base/rss/rss_autodownloadrule.h"
+#include "base/rss/rss_autodownloadrulematcher.h"
+
+namespace
+{
+    const QString FEED1 = u"http://example.com/feed1"_s;
+    const QString FEED2 = u"http://example.com/feed2"_s;
+
+    RSS::AutoDownloadRule makeRule(const QString &name, const QString &mustContain, const QString &mustNotContain = {}
+            , const bool useRegex = false, const QStringList &feedURLs = {FEED1})
+    {
+        RSS::AutoDownloadRule rule {name};
+        rule.setEnabled(true);
+        rule.setUseRegex(useRegex);
+        rule.setMustContain(mustContain);
+        rule.setMustNotContain(mustNotContain);
+        rule.setFeedURLs(feedURLs);
+        return rule;
+    }
+}
+
+class TestRSSAutoDownloadRuleMatcher final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestRSSAutoDownloadRuleMatcher)
+
+public:
+    TestRSSAutoDownloadRuleMatcher() = default;
+
+private slots:
+    void testKeywords() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{makeRule(u"rule"_s, u"Show 1080p"_s)}};
+
+        QCOMPARE(matcher.findCandidates(FEED1, u"[Group] show - 01 [1080P]"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"[Group] Show - 01 [720p]"_s), QStringList {});
+        QCOMPARE(matcher.findCandidates(FEED1, u"1080p"_s), QStringList {});
+    }
+
+    void testWildcards() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{makeRule(u"rule"_s, u"Sh?w*01 | Other"_s)}};
+
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show - 01"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Shaw 01"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"The other one"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show - 02"_s), QStringList {});
+    }
+
+    void testMustNotContain() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{makeRule(u"rule"_s, u"Show"_s, u"720p | x265 hevc"_s)}};
+
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show 1080p"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show 720p"_s), QStringList {});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show x265"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show x265 HEVC"_s), QStringList {});
+    }
+
+    void testRegex() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{makeRule(u"rule"_s, u"^show\\s+\\d+$"_s, u"\\b0\\b"_s, true)}};
+
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show 12"_s), QStringList {u"rule"_s});
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show 0"_s), QStringList {});
+        QCOMPARE(matcher.findCandidates(FEED1, u"The Show 12"_s), QStringList {});
+    }
+
+    void testFeeds() const
+    {
+        RSS::AutoDownloadRule disabledRule = makeRule(u"disabled"_s, u"Show"_s);
+        disabledRule.setEnabled(false);
+
+        const RSS::AutoDownloadRuleMatcher matcher {{makeRule(u"rule1"_s, u"Show"_s)
+                , makeRule(u"rule2"_s, {}, {}, false, {FEED1, FEED2}), disabledRule}};
+
+        QCOMPARE(matcher.findCandidates(FEED1, u"Show"_s), (QStringList {u"rule1"_s, u"rule2"_s}));
+        QCOMPARE(matcher.findCandidates(FEED2, u"Show"_s), QStringList {u"rule2"_s});
+        QCOMPARE(matcher.findCandidates(u"http://example.com/feed3"_s, u"Show"_s), QStringList {});
+    }
+
+    void benchmarkFindCandidates() const
+    {
+        const int feedCount = 200;
+        const int ruleCount = 1500;
+
+        QList<RSS::AutoDownloadRule> rules;
+        rules.reserve(ruleCount);
+        for (int i = 0; i < ruleCount; ++i)
+        {
+            const QStringList feedURLs {u"http://example.com/feed%1"_s.arg(i % feedCount)
+                    , u"http://example.com/feed%1"_s.arg((i * 7) % feedCount)};
+            rules.append(makeRule(u"rule%1"_s.arg(i), u"Show%1 1080p | Show%1 S01E*"_s.arg(i)
+                    , u"720p | Batch"_s, false, feedURLs));
+        }
+
+        QStringList titles;
+        titles.reserve(ruleCount);
+        for (int i = 0; i < ruleCount; ++i)
+            titles.append(u"[Group] Show%1 - S01E%2 [1080p][HEVC]"_s.arg(i).arg(i % 24));
+
+        const RSS::AutoDownloadRuleMatcher matcher {rules};
+        QBENCHMARK
+        {
+            for (int i = 0; i < titles.size(); ++i)
+                matcher.findCandidates(u"http://example.com/feed%1"_s.arg(i % feedCount), titles[i]);
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TestRSSAutoDownloadRuleMatcher)
+#include "testrssautodownloadrulematcher.moc"
@@ -0,0 +1,145 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#include <QObject>
+#include <QTest>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/search/searchresultstore.h"
+
+namespace
+{
+    SearchResult makeResult(const QString &name, const QString &url, const qlonglong size = 0, const qlonglong seeds = 0)
+    {
+        SearchResult result;
+        result.fileName = name;
+        result.fileUrl = url;
+        result.fileSize = size;
+        result.nbSeeders = seeds;
+        return result;
+    }
+
+    QStringList names(const SearchResultStore &store, const QVector<int> &indexes)
+    {
+        QStringList result;
+        for (const int index : indexes)
+            result.append(store.at(index).fileName);
+        return result;
+    }
+}
+
+class TestSearchResultStore final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestSearchResultStore)
+
+public:
+    TestSearchResultStore() = default;
+
+private slots:
+    void testDuplicates() const
+    {
+        SearchResultStore store;
+
+        const QVector<SearchResult> added = store.append({
+            makeResult(u"a"_s, u"magnet:?xt=urn:btih:ABCDEF&dn=a"_s),
+            makeResult(u"b"_s, u"magnet:?dn=b&xt=urn:btih:abcdef&tr=http://tracker"_s),
+            makeResult(u"c"_s, u"http://example.com/c.torrent"_s),
+            makeResult(u"d"_s, u"http://example.com/c.torrent"_s),
+            makeResult(u"e"_s, {}),
+            makeResult(u"f"_s, {})
+        });
+
+        QCOMPARE(added.size(), 4);
+        QCOMPARE(store.size(), 4);
+        QCOMPARE(names(store, store.select({}, SearchResultStore::SortColumn::None)), (QStringList {u"a"_s, u"c"_s, u"e"_s, u"f"_s}));
+
+        QVERIFY(store.append({makeResult(u"g"_s, u"http://example.com/c.torrent"_s)}).isEmpty());
+        QCOMPARE(store.size(), 4);
+    }
+
+    void testSort() const
+    {
+        SearchResultStore store;
+        store.append({
+            makeResult(u"Item 10"_s, u"1"_s, 300),
+            makeResult(u"item 2"_s, u"2"_s, 100),
+            makeResult(u"Item 1"_s, u"3"_s, 200)
+        });
+
+        QCOMPARE(names(store, store.select({}, SearchResultStore::SortColumn::FileName))
+                 , (QStringList {u"Item 1"_s, u"item 2"_s, u"Item 10"_s}));
+        QCOMPARE(names(store, store.select({}, SearchResultStore::SortColumn::FileSize, Qt::DescendingOrder))
+                 , (QStringList {u"Item 10"_s, u"Item 1"_s, u"item 2"_s}));
+
+        // results added later are merged into already sorted ones
+        store.append({makeResult(u"Item 3"_s, u"4"_s, 150), makeResult(u"Item 0"_s, u"5"_s, 200)});
+
+        QCOMPARE(names(store, store.select({}, SearchResultStore::SortColumn::FileName))
+                 , (QStringList {u"Item 0"_s, u"Item 1"_s, u"item 2"_s, u"Item 3"_s, u"Item 10"_s}));
+        // equal values keep the order of addition
+        QCOMPARE(names(store, store.select({}, SearchResultStore::SortColumn::FileSize))
+                 , (QStringList {u"item 2"_s, u"Item 3"_s, u"Item 1"_s, u"Item 0"_s, u"Item 10"_s}));
+    }
+
+    void testFilter() const
+    {
+        SearchResultStore store;
+        store.append({
+            makeResult(u"Debian netinst"_s, u"1"_s, 400, 50),
+            makeResult(u"Debian DVD"_s, u"2"_s, 4000, 10),
+            makeResult(u"Ubuntu desktop"_s, u"3"_s, 3000, 100),
+            makeResult(u"debian live"_s, u"4"_s, 2000, 5)
+        });
+
+        SearchResultFilter filter;
+        QVERIFY(filter.isEmpty());
+
+        filter.nameWords = QStringList {u"DEBIAN"_s};
+        QCOMPARE(names(store, store.select(filter, SearchResultStore::SortColumn::None))
+                 , (QStringList {u"Debian netinst"_s, u"Debian DVD"_s, u"debian live"_s}));
+
+        filter.minSize = 1000;
+        QCOMPARE(names(store, store.select(filter, SearchResultStore::SortColumn::FileSize))
+                 , (QStringList {u"debian live"_s, u"Debian DVD"_s}));
+
+        filter.minSeeds = 6;
+        QCOMPARE(names(store, store.select(filter, SearchResultStore::SortColumn::FileSize)), QStringList {u"Debian DVD"_s});
+
+        filter = {};
+        filter.maxSize = 3000;
+        filter.maxSeeds = 50;
+        QCOMPARE(names(store, store.select(filter, SearchResultStore::SortColumn::NbSeeders, Qt::DescendingOrder))
+                 , (QStringList {u"Debian netinst"_s, u"debian live"_s}));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestSearchResultStore)
+#include "testsearchresultstore.moc"
@@ -0,0 +1,77 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "base/global.h"
+#include "base/stringpool.h"
+
+class TestStringPool final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestStringPool)
+
+public:
+    TestStringPool() = default;
+
+private slots:
+    void testIntern() const
+    {
+        StringPool pool;
+
+        const QString first = pool.intern(u"http://tracker.example.com/announce"_s);
+        const QString second = pool.intern(u"http://tracker.example.com/"_s + u"announce"_s);
+        QCOMPARE(second, first);
+        QCOMPARE(second.constData(), first.constData());
+        QCOMPARE(pool.size(), 1);
+
+        const QString other = pool.intern(u"udp://tracker.example.com:6969"_s);
+        QVERIFY(other.constData() != first.constData());
+        QCOMPARE(pool.size(), 2);
+
+        QVERIFY(pool.intern({}).isEmpty());
+        QCOMPARE(pool.size(), 2);
+    }
+
+    void testPurge() const
+    {
+        StringPool pool;
+
+        const QString kept = pool.intern(u"kept"_s + QString::number(-1));
+        for (int i = 0; i < 5000; ++i)
+            pool.intern(u"string"_s + QString::number(i));
+
+        // Unused strings are removed when the pool grows
+        QVERIFY(pool.size() < 5001);
+        QCOMPARE(pool.intern(u"kept-1"_s).constData(), kept.constData());
+    }
+};
+
+QTEST_APPLESS_MAIN(TestStringPool)
+#include "teststringpool.moc"
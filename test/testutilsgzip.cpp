@@ -26,12 +26,31 @@
  * exception statement from your version.
  */
 
+#include <algorithm>
+
+#include <QBuffer>
 #include <QObject>
 #include <QTest>
 
 #include "base/global.h"
 #include "base/utils/gzip.h"
 
+namespace
+{
+    // Returns less data than requested, as sequential devices may do
+    class ChunkedBuffer final : public QBuffer
+    {
+    public:
+        using QBuffer::QBuffer;
+
+    protected:
+        qint64 readData(char *data, const qint64 maxSize) override
+        {
+            return QBuffer::readData(data, std::min<qint64>(maxSize, 1000));
+        }
+    };
+}
+
 class TestUtilsGzip final : public QObject
 {
     Q_OBJECT
@@ -65,6 +84,40 @@ private slots:
         QVERIFY(ok);
         QCOMPARE(decompressedData, data);
     }
+
+    void testCompressDevice() const
+    {
+        QByteArray data;
+        for (int i = 0; i < (200 * 1024); ++i)
+            data.append(static_cast<char>(i % 251));
+
+        ChunkedBuffer source {&data};
+        QVERIFY(source.open(QIODevice::ReadOnly));
+        QByteArray compressedData;
+        QBuffer target {&compressedData};
+        QVERIFY(target.open(QIODevice::WriteOnly));
+
+        QVERIFY(Utils::Gzip::compress(source, target));
+        QVERIFY(compressedData.size() < data.size());
+
+        bool ok = false;
+        const QByteArray decompressedData = Utils::Gzip::decompress(compressedData, &ok);
+        QVERIFY(ok);
+        QCOMPARE(decompressedData, data);
+    }
+
+    void testCompressEmptyDevice() const
+    {
+        QByteArray data;
+        QBuffer source {&data};
+        QVERIFY(source.open(QIODevice::ReadOnly));
+        QByteArray compressedData;
+        QBuffer target {&compressedData};
+        QVERIFY(target.open(QIODevice::WriteOnly));
+
+        QVERIFY(Utils::Gzip::compress(source, target));
+        QVERIFY(!compressedData.isEmpty());
+    }
 };
 
 QTEST_APPLESS_MAIN(TestUtilsGzip)